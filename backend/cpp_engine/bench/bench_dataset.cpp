@@ -0,0 +1,98 @@
+#include "bench_dataset.h"
+#include "utils.h"
+
+namespace {
+
+const CaseStatus STATUSES[] = {CaseStatus::OPEN, CaseStatus::IN_PROGRESS, CaseStatus::SOLVED,
+                               CaseStatus::COLD, CaseStatus::UNSOLVED};
+const CasePriority PRIORITIES[] = {CasePriority::LOW, CasePriority::MEDIUM, CasePriority::HIGH,
+                                   CasePriority::URGENT};
+const CharacterRole ROLES[] = {CharacterRole::WITNESS, CharacterRole::INFORMANT, CharacterRole::VICTIM,
+                               CharacterRole::OFFICER, CharacterRole::DETECTIVE, CharacterRole::EXPERT};
+
+size_t pick(size_t count) {
+    return static_cast<size_t>(DetectiveUtils::randomInt(0, static_cast<int>(count) - 1));
+}
+
+} // namespace
+
+Dataset makeDataset(const DatasetSpec& spec) {
+    DetectiveUtils::seedRandom(spec.seed);
+    Dataset data;
+
+    data.cases.reserve(spec.cases);
+    for (size_t i = 0; i < spec.cases; i++) {
+        data.cases.push_back({DetectiveUtils::randomCaseTitle() + " #" + std::to_string(i),
+                              "Reported at " + DetectiveUtils::randomAddress(),
+                              STATUSES[pick(5)], PRIORITIES[pick(4)]});
+    }
+
+    data.suspects.reserve(spec.suspects);
+    for (size_t i = 0; i < spec.suspects; i++) {
+        data.suspects.push_back({DetectiveUtils::randomName() + " " + std::to_string(i),
+                                 "Lives at " + DetectiveUtils::randomAddress(),
+                                 "Seen near the scene", DetectiveUtils::randomInt(18, 80),
+                                 DetectiveUtils::randomOccupation()});
+    }
+
+    data.characters.reserve(spec.characters);
+    for (size_t i = 0; i < spec.characters; i++) {
+        data.characters.push_back({DetectiveUtils::randomName() + " (witness " + std::to_string(i) + ")",
+                                   ROLES[pick(6)], "Gave a statement"});
+    }
+
+    if (!data.suspects.empty()) {
+        for (size_t c = 0; c < data.cases.size(); c++) {
+            for (int k = 0; k < spec.suspectsPerCase; k++) data.suspectLinks.emplace_back(pick(data.suspects.size()), c);
+        }
+        for (size_t s = 0; s < data.suspects.size(); s++) {
+            for (int k = 0; k < spec.relationshipsPerSuspect; k++) {
+                size_t other = pick(data.suspects.size());
+                if (other != s) data.relationships.emplace_back(s, other);
+            }
+        }
+    }
+    if (!data.characters.empty()) {
+        for (size_t c = 0; c < data.cases.size(); c++) {
+            for (int k = 0; k < spec.charactersPerCase; k++) {
+                data.characterLinks.emplace_back(pick(data.characters.size()), c);
+            }
+        }
+    }
+    return data;
+}
+
+void addEntities(Engine& engine, const Dataset& data) {
+    for (const auto& c : data.cases) engine.addCase(c.title, c.description, c.status, c.priority);
+    for (const auto& s : data.suspects) engine.addSuspect(s.name, s.background, s.story, s.age, s.occupation);
+    for (const auto& ch : data.characters) engine.addCharacter(ch.name, ch.role, ch.story);
+}
+
+void addLinks(Engine& engine, const Dataset& data) {
+    for (const auto& [s, c] : data.suspectLinks) {
+        engine.linkSuspectToCase(data.suspects[s].name, data.cases[c].title);
+    }
+    for (const auto& [ch, c] : data.characterLinks) {
+        engine.linkCharacterToCase(data.characters[ch].name, data.cases[c].title);
+    }
+    for (const auto& [a, b] : data.relationships) {
+        engine.addRelationship(data.suspects[a].name, data.suspects[b].name, "associate");
+    }
+}
+
+void loadDataset(Engine& engine, const Dataset& data) {
+    addEntities(engine, data);
+    addLinks(engine, data);
+}
+
+Graph buildGraph(const Dataset& data) {
+    Graph g;
+    auto link = [&](const std::string& a, const std::string& b, const std::string& type) {
+        g.addEdge(a, b, type);
+        g.addEdge(b, a, type);
+    };
+    for (const auto& [s, c] : data.suspectLinks) link(data.suspects[s].name, data.cases[c].title, "suspect");
+    for (const auto& [ch, c] : data.characterLinks) link(data.characters[ch].name, data.cases[c].title, "character");
+    for (const auto& [a, b] : data.relationships) link(data.suspects[a].name, data.suspects[b].name, "associate");
+    return g;
+}
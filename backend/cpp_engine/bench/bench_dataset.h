@@ -0,0 +1,67 @@
+// Synthetic investigation data for the benchmarks.
+//
+// Names and titles come from DetectiveUtils::randomName/randomCaseTitle
+// after seedRandom(seed), with a running number appended to keep them
+// unique, so a seed always produces the same dataset on a given standard
+// library (distributions are not portable between libraries).
+#ifndef BENCH_DATASET_H
+#define BENCH_DATASET_H
+
+#include "engine.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+struct DatasetSpec {
+    size_t cases = 5000;
+    size_t suspects = 10000;
+    size_t characters = 5000;
+    int suspectsPerCase = 3;
+    int charactersPerCase = 2;
+    int relationshipsPerSuspect = 2;    // extra suspect <-> suspect edges
+    unsigned seed = 42;
+};
+
+struct Dataset {
+    struct CaseRow {
+        std::string title;
+        std::string description;
+        CaseStatus status;
+        CasePriority priority;
+    };
+    struct SuspectRow {
+        std::string name;
+        std::string background;
+        std::string story;
+        int age;
+        std::string occupation;
+    };
+    struct CharacterRow {
+        std::string name;
+        CharacterRole role;
+        std::string story;
+    };
+
+    std::vector<CaseRow> cases;
+    std::vector<SuspectRow> suspects;
+    std::vector<CharacterRow> characters;
+    // Index pairs into the vectors above
+    std::vector<std::pair<size_t, size_t>> suspectLinks;      // suspect, case
+    std::vector<std::pair<size_t, size_t>> characterLinks;    // character, case
+    std::vector<std::pair<size_t, size_t>> relationships;     // suspect, suspect
+
+    size_t entityCount() const { return cases.size() + suspects.size() + characters.size(); }
+};
+
+Dataset makeDataset(const DatasetSpec& spec);
+
+// Adds everything through the public Engine API
+void addEntities(Engine& engine, const Dataset& data);
+void addLinks(Engine& engine, const Dataset& data);
+void loadDataset(Engine& engine, const Dataset& data);
+
+// The relationship graph the engine would build from the links, without
+// an engine around it
+Graph buildGraph(const Dataset& data);
+
+#endif // BENCH_DATASET_H
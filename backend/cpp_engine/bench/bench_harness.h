@@ -0,0 +1,191 @@
+// Minimal Google-Benchmark-style harness for the engine suite.
+//
+// A benchmark is a function taking a BenchState and looping with
+// `for (auto _ : state)`; only that loop is timed, so setup before it is
+// free. The runner grows the iteration count until a run lasts at least
+// minSeconds, then reports per-iteration real and CPU time. JSON output
+// uses Google Benchmark's field names so its compare tooling reads it.
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Keeps a value alive so the optimiser cannot drop the work behind it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+class BenchState {
+private:
+    uint64_t iterations;
+    uint64_t itemsProcessed;
+    std::chrono::steady_clock::time_point startReal;
+    std::clock_t startCpu;
+    double realSeconds;
+    double cpuSeconds;
+
+    friend class BenchRunner;
+
+public:
+    explicit BenchState(uint64_t iterations)
+        : iterations(iterations), itemsProcessed(0), startCpu(0), realSeconds(0), cpuSeconds(0) {}
+
+    uint64_t getIterations() const { return iterations; }
+    // Items handled over the whole run, for an items/s figure
+    void setItemsProcessed(uint64_t items) { itemsProcessed = items; }
+
+    // Leave per-iteration setup out of the measurement
+    void pauseTiming() {
+        realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startReal).count();
+        cpuSeconds += static_cast<double>(std::clock() - startCpu) / CLOCKS_PER_SEC;
+    }
+    void resumeTiming() {
+        startCpu = std::clock();
+        startReal = std::chrono::steady_clock::now();
+    }
+
+    // Marked unused so `for (auto _ : state)` does not warn
+#if defined(__GNUC__) || defined(__clang__)
+    struct __attribute__((unused)) Value {};
+#else
+    struct Value {};
+#endif
+
+    struct Iterator {
+        BenchState* state;
+        uint64_t remaining;
+
+        bool operator!=(const Iterator&) const {
+            if (remaining > 0) return true;
+            state->stop();
+            return false;
+        }
+        Iterator& operator++() { --remaining; return *this; }
+        Value operator*() const { return Value(); }
+    };
+
+    Iterator begin() {
+        resumeTiming();
+        return Iterator{this, iterations};
+    }
+    Iterator end() { return Iterator{this, 0}; }
+
+private:
+    void stop() { pauseTiming(); }
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;
+    double realNs;      // per iteration
+    double cpuNs;
+    double itemsPerSecond;
+};
+
+class BenchRunner {
+private:
+    struct Entry {
+        std::string name;
+        std::function<void(BenchState&)> fn;
+    };
+
+    std::vector<Entry> entries;
+    double minSeconds;
+    uint64_t maxIterations;
+
+public:
+    BenchRunner() : minSeconds(0.5), maxIterations(1000000000) {}
+
+    void add(const std::string& name, std::function<void(BenchState&)> fn) {
+        entries.push_back({name, std::move(fn)});
+    }
+    void setMinSeconds(double seconds) { minSeconds = seconds; }
+
+    std::vector<BenchResult> run(const std::string& filter, std::ostream& log) {
+        std::regex pattern(filter.empty() ? ".*" : filter);
+        std::vector<BenchResult> results;
+        log << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(14) << "Time (ns)"
+            << std::setw(14) << "CPU (ns)" << std::setw(12) << "Iterations" << std::setw(16) << "Items/s" << "\n";
+        log << std::string(96, '-') << "\n";
+
+        for (const Entry& entry : entries) {
+            if (!std::regex_search(entry.name, pattern)) continue;
+
+            // Grow towards minSeconds the way Google Benchmark does: aim for
+            // 1.4x the remaining need, at most 10x per step
+            uint64_t iterations = 1;
+            BenchState state(iterations);
+            for (;;) {
+                state = BenchState(iterations);
+                entry.fn(state);
+                if (state.realSeconds >= minSeconds || iterations >= maxIterations) break;
+                double scale = state.realSeconds > 0 ? minSeconds * 1.4 / state.realSeconds : 10.0;
+                scale = std::min(std::max(scale, 2.0), 10.0);
+                iterations = std::min<uint64_t>(maxIterations, static_cast<uint64_t>(iterations * scale) + 1);
+            }
+
+            BenchResult result;
+            result.name = entry.name;
+            result.iterations = iterations;
+            result.realNs = state.realSeconds * 1e9 / static_cast<double>(iterations);
+            result.cpuNs = state.cpuSeconds * 1e9 / static_cast<double>(iterations);
+            result.itemsPerSecond = state.itemsProcessed && state.realSeconds > 0
+                ? static_cast<double>(state.itemsProcessed) / state.realSeconds : 0.0;
+            results.push_back(result);
+
+            log << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(0)
+                << std::setw(14) << result.realNs << std::setw(14) << result.cpuNs
+                << std::setw(12) << result.iterations << std::setw(16);
+            if (result.itemsPerSecond > 0) log << result.itemsPerSecond; else log << "";
+            log << "\n";
+        }
+        return results;
+    }
+};
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// context holds pre-rendered "key": value pairs
+inline void writeBenchJson(std::ostream& out, const std::vector<std::pair<std::string, std::string>>& context,
+                           const std::vector<BenchResult>& results) {
+    out << "{\n  \"context\": {\n";
+    for (size_t i = 0; i < context.size(); i++) {
+        out << "    \"" << context[i].first << "\": " << context[i].second << (i + 1 < context.size() ? "," : "") << "\n";
+    }
+    out << "  },\n  \"benchmarks\": [\n";
+    out << std::setprecision(3) << std::fixed;
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"run_name\": \"" << jsonEscape(r.name)
+            << "\", \"run_type\": \"iteration\", \"iterations\": " << r.iterations
+            << ", \"real_time\": " << r.realNs << ", \"cpu_time\": " << r.cpuNs << ", \"time_unit\": \"ns\"";
+        if (r.itemsPerSecond > 0) out << ", \"items_per_second\": " << r.itemsPerSecond;
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+#endif // BENCH_HARNESS_H
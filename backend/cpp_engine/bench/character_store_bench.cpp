@@ -0,0 +1,97 @@
+// Character storage: the old LinkedList<Character> against SlotMap<Character>.
+// Both get the same characters, then role scans, a keyword search over the
+// stories, erasing every other character by handle/key, and a rescan of what
+// is left (the list is fragmented by then, the slot map is still packed).
+// Usage: bench_character_store [characters]
+#include "linked_list.h"
+#include "slot_map.h"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const CharacterRole ROLES[] = {CharacterRole::WITNESS, CharacterRole::INFORMANT, CharacterRole::VICTIM,
+                               CharacterRole::OFFICER, CharacterRole::DETECTIVE, CharacterRole::EXPERT};
+
+Character makeCharacter(int i) {
+    return Character(i, "character" + std::to_string(i), ROLES[i % 6],
+                     i % 100 == 0 ? "seen near the docks" : "nothing of note");
+}
+
+void time(const std::string& store, const std::string& name, const std::function<size_t()>& run) {
+    auto start = std::chrono::steady_clock::now();
+    size_t result = run();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(10) << store << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+              << "   (" << result << ")\n";
+}
+
+void runList(int count) {
+    LinkedList<Character> list;
+    std::vector<LinkedList<Character>::NodeHandle> handles;
+    handles.reserve(count);
+
+    time("list", "insert", [&] {
+        for (int i = 0; i < count; i++) handles.push_back(list.insertAtEnd(makeCharacter(i)));
+        return static_cast<size_t>(list.getSize());
+    });
+    auto scan = [&] {
+        size_t found = 0;
+        list.traverse([&](Character& ch) { found += ch.getRole() == CharacterRole::WITNESS; });
+        return found;
+    };
+    time("list", "scan by role", scan);
+    time("list", "search stories", [&] {
+        size_t found = 0;
+        list.traverse([&](Character& ch) { found += ch.getStory().find("docks") != std::string::npos; });
+        return found;
+    });
+    time("list", "erase every other", [&] {
+        for (int i = 1; i < count; i += 2) list.erase(handles[i]);
+        return static_cast<size_t>(list.getSize());
+    });
+    time("list", "scan after erase", scan);
+}
+
+void runSlotMap(int count) {
+    SlotMap<Character> map;
+    std::vector<SlotKey> keys;
+    keys.reserve(count);
+
+    time("slotmap", "insert", [&] {
+        for (int i = 0; i < count; i++) keys.push_back(map.insert(makeCharacter(i)));
+        return map.size();
+    });
+    auto scan = [&] {
+        size_t found = 0;
+        for (const Character& ch : map) found += ch.getRole() == CharacterRole::WITNESS;
+        return found;
+    };
+    time("slotmap", "scan by role", scan);
+    time("slotmap", "search stories", [&] {
+        size_t found = 0;
+        for (const Character& ch : map) found += ch.getStory().find("docks") != std::string::npos;
+        return found;
+    });
+    time("slotmap", "erase every other", [&] {
+        for (int i = 1; i < count; i += 2) map.erase(keys[i]);
+        return map.size();
+    });
+    time("slotmap", "scan after erase", scan);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::cout << count << " characters\n";
+    runList(count);
+    runSlotMap(count);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""Compare two bench_engine_suite JSON files.
+
+Usage: compare.py BASELINE.json CONTENDER.json [--threshold PERCENT]
+
+Prints the change in real time per benchmark and exits with status 1 if any
+benchmark got slower by more than the threshold (default 10%).
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data.get("context", {}), {b["name"]: b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percent slowdown that counts as a regression")
+    args = parser.parse_args()
+
+    base_context, baseline = load(args.baseline)
+    new_context, contender = load(args.contender)
+    for key in ("seed", "cases", "suspects", "characters"):
+        if base_context.get(key) != new_context.get(key):
+            print(f"warning: {key} differs ({base_context.get(key)} vs {new_context.get(key)})")
+
+    regressions = []
+    print(f"{'Benchmark':<40}{'Baseline (ns)':>16}{'Contender (ns)':>16}{'Change':>10}")
+    print("-" * 82)
+    for name, old in baseline.items():
+        new = contender.get(name)
+        if new is None:
+            print(f"{name:<40}{old['real_time']:>16.0f}{'missing':>16}")
+            continue
+        change = (new["real_time"] - old["real_time"]) / old["real_time"] * 100 if old["real_time"] else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = "  SLOWER"
+            regressions.append(name)
+        elif change < -args.threshold:
+            marker = "  faster"
+        print(f"{name:<40}{old['real_time']:>16.0f}{new['real_time']:>16.0f}{change:>+9.1f}%{marker}")
+    for name in contender.keys() - baseline.keys():
+        print(f"{name:<40}{'new':>16}{contender[name]['real_time']:>16.0f}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower than {args.threshold:.0f}%: {', '.join(regressions)}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,381 @@
+// Release-over-release benchmark suite: trees, graph kernels, engine calls
+// and serialization on one seeded synthetic dataset. Write JSON with
+// --json and diff two runs with bench/compare.py (or Google Benchmark's
+// compare.py, which reads the same format).
+//
+// Usage: bench_engine_suite [--filter=REGEX] [--json=PATH] [--size=N]
+//                           [--seed=N] [--min-time=SECONDS]
+// --size is the case count; suspects and characters scale with it.
+#include "bench_dataset.h"
+#include "bench_harness.h"
+#include "avl_tree.h"
+#include "graph_analytics.h"
+#include "logger.h"
+#include "rb_tree.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct SuiteConfig {
+    std::string filter;
+    std::string jsonPath;
+    DatasetSpec spec;
+    double minSeconds = 0.5;
+};
+
+std::vector<int> shuffledKeys(size_t count, unsigned seed) {
+    std::vector<int> keys(count);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+    return keys;
+}
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() /
+            ("whodunnit_bench_" + std::to_string(std::time(nullptr)) + "_" + name)).string();
+}
+
+template <typename Tree>
+void addTreeBenchmarks(BenchRunner& runner, const std::string& prefix, const SuiteConfig& config) {
+    const size_t count = config.spec.suspects;
+    const unsigned seed = config.spec.seed;
+
+    runner.add(prefix + "/insert", [=](BenchState& state) {
+        std::vector<int> keys = shuffledKeys(count, seed);
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto tree = std::make_unique<Tree>();
+            state.resumeTiming();
+            for (int key : keys) tree->insert(key);
+            state.pauseTiming();
+            tree.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.getIterations() * count);
+    });
+
+    runner.add(prefix + "/search", [=](BenchState& state) {
+        Tree tree;
+        for (int key : shuffledKeys(count, seed)) tree.insert(key);
+        std::vector<int> probes = shuffledKeys(count, seed + 1);
+        for (auto _ : state) {
+            for (int key : probes) doNotOptimize(tree.search(key));
+        }
+        state.setItemsProcessed(state.getIterations() * count);
+    });
+
+    runner.add(prefix + "/remove", [=](BenchState& state) {
+        std::vector<int> keys = shuffledKeys(count, seed);
+        std::vector<int> order = shuffledKeys(count, seed + 1);
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto tree = std::make_unique<Tree>();
+            for (int key : keys) tree->insert(key);
+            state.resumeTiming();
+            for (int key : order) tree->remove(key);
+            state.pauseTiming();
+            tree.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.getIterations() * count);
+    });
+}
+
+void addGraphBenchmarks(BenchRunner& runner, const std::shared_ptr<const Dataset>& data,
+                        const SuiteConfig& config) {
+    auto graph = std::make_shared<Graph>(buildGraph(*data));
+    const unsigned seed = config.spec.seed;
+
+    runner.add("graph/bfs", [=](BenchState& state) {
+        const std::string& start = data->cases.front().title;
+        size_t visited = 0;
+        for (auto _ : state) {
+            graph->bfs(start, [&](const std::string&) { visited++; });
+        }
+        doNotOptimize(visited);
+        state.setItemsProcessed(visited);
+    });
+
+    runner.add("graph/path", [=](BenchState& state) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> pickCase(0, data->cases.size() - 1);
+        std::uniform_int_distribution<size_t> pickSuspect(0, data->suspects.size() - 1);
+        std::vector<std::pair<std::string, std::string>> pairs;
+        for (int i = 0; i < 64; i++) {
+            pairs.emplace_back(data->cases[pickCase(rng)].title, data->suspects[pickSuspect(rng)].name);
+        }
+        size_t next = 0;
+        for (auto _ : state) {
+            const auto& [from, to] = pairs[next++ % pairs.size()];
+            doNotOptimize(graph->shortestPath(from, to));
+        }
+    });
+
+    // Sampled so the exact O(VE) kernel does not dominate the suite
+    auto pool = std::make_shared<WorkStealingPool>();
+    for (ExecutionMode mode : {ExecutionMode::SERIAL, ExecutionMode::PARALLEL}) {
+        std::string name = mode == ExecutionMode::SERIAL ? "graph/centrality_serial" : "graph/centrality_parallel";
+        runner.add(name, [=](BenchState& state) {
+            GraphAnalytics analytics(*pool);
+            auto view = graph->getDenseView();
+            CentralityOptions options;
+            options.mode = mode;
+            options.sampleSources = 64;
+            for (auto _ : state) doNotOptimize(analytics.betweenness(*view, options));
+        });
+    }
+}
+
+void addEngineBenchmarks(BenchRunner& runner, const std::shared_ptr<const Dataset>& data,
+                         const SuiteConfig& config) {
+    runner.add("engine/add", [=](BenchState& state) {
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto engine = std::make_unique<Engine>();
+            state.resumeTiming();
+            addEntities(*engine, *data);
+            state.pauseTiming();
+            engine.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.getIterations() * data->entityCount());
+    });
+
+    runner.add("engine/link", [=](BenchState& state) {
+        size_t links = data->suspectLinks.size() + data->characterLinks.size() + data->relationships.size();
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto engine = std::make_unique<Engine>();
+            addEntities(*engine, *data);
+            state.resumeTiming();
+            addLinks(*engine, *data);
+            state.pauseTiming();
+            engine.reset();
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.getIterations() * links);
+    });
+
+    // The read benchmarks share one loaded engine
+    auto engine = std::make_shared<Engine>();
+    loadDataset(*engine, *data);
+    const unsigned seed = config.spec.seed;
+
+    runner.add("engine/find_case", [=](BenchState& state) {
+        std::vector<int> order = shuffledKeys(data->cases.size(), seed);
+        size_t next = 0;
+        for (auto _ : state) {
+            doNotOptimize(engine->findCase(data->cases[order[next++ % order.size()]].title));
+        }
+        state.setItemsProcessed(state.getIterations());
+    });
+
+    runner.add("engine/search_cases", [=](BenchState& state) {
+        for (auto _ : state) doNotOptimize(engine->searchCases("Murder"));
+    });
+
+    runner.add("engine/query", [=](BenchState& state) {
+        for (auto _ : state) {
+            doNotOptimize(engine->queryCases()
+                              .whereUnsolved()
+                              .whereMinPriority(CasePriority::HIGH)
+                              .joinSuspects(50.0)
+                              .orderBy(CaseOrder::MAX_SUSPICION, true)
+                              .limit(20)
+                              .run());
+        }
+    });
+
+    runner.add("engine/statistics", [=](BenchState& state) {
+        for (auto _ : state) doNotOptimize(engine->getStatistics());
+    });
+
+    runner.add("engine/find_path", [=](BenchState& state) {
+        const std::string& from = data->cases.front().title;
+        const std::string& to = data->suspects.back().name;
+        for (auto _ : state) doNotOptimize(engine->findPath(from, to));
+    });
+}
+
+void addSerializationBenchmarks(BenchRunner& runner, const std::shared_ptr<const Dataset>& data) {
+    auto engine = std::make_shared<Engine>();
+    loadDataset(*engine, *data);
+    const size_t entities = data->entityCount();
+
+    runner.add("serialize/snapshot_save", [=](BenchState& state) {
+        std::string path = tempPath("save.snap");
+        for (auto _ : state) engine->saveSnapshot(path);
+        std::filesystem::remove(path);
+        state.setItemsProcessed(state.getIterations() * entities);
+    });
+
+    runner.add("serialize/snapshot_load", [=](BenchState& state) {
+        std::string path = tempPath("load.snap");
+        engine->saveSnapshot(path);
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto target = std::make_unique<Engine>();
+            state.resumeTiming();
+            target->loadSnapshot(path);
+            state.pauseTiming();
+            target.reset();
+            state.resumeTiming();
+        }
+        std::filesystem::remove(path);
+        state.setItemsProcessed(state.getIterations() * entities);
+    });
+
+    // Cases and suspects are decoded on first use; this also pays for that
+    runner.add("serialize/snapshot_load_all", [=](BenchState& state) {
+        std::string path = tempPath("load_all.snap");
+        engine->saveSnapshot(path);
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto target = std::make_unique<Engine>();
+            state.resumeTiming();
+            target->loadSnapshot(path);
+            doNotOptimize(target->getAllCases().size() + target->getAllSuspects().size());
+            state.pauseTiming();
+            target.reset();
+            state.resumeTiming();
+        }
+        std::filesystem::remove(path);
+        state.setItemsProcessed(state.getIterations() * entities);
+    });
+
+    runner.add("serialize/export_text", [=](BenchState& state) {
+        std::string path = tempPath("export.txt");
+        for (auto _ : state) engine->exportSerialized(path);
+        std::filesystem::remove(path);
+        state.setItemsProcessed(state.getIterations() * entities);
+    });
+
+    runner.add("serialize/import_text", [=](BenchState& state) {
+        std::string path = tempPath("import.txt");
+        engine->exportSerialized(path);
+        for (auto _ : state) {
+            state.pauseTiming();
+            auto target = std::make_unique<Engine>();
+            state.resumeTiming();
+            target->importSerialized(path);
+            state.pauseTiming();
+            target.reset();
+            state.resumeTiming();
+        }
+        std::filesystem::remove(path);
+        state.setItemsProcessed(state.getIterations() * entities);
+    });
+
+    runner.add("serialize/case_roundtrip", [=](BenchState& state) {
+        Case* sample = engine->findCase(data->cases.front().title);
+        Case parsed;
+        for (auto _ : state) {
+            std::string text = sample->serialize();
+            doNotOptimize(Case::parse(text, parsed));
+        }
+        state.setItemsProcessed(state.getIterations());
+    });
+}
+
+std::string quoted(const std::string& text) { return "\"" + jsonEscape(text) + "\""; }
+
+std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+bool parseArgs(int argc, char* argv[], SuiteConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&](const std::string& flag) { return arg.substr(flag.size()); };
+        if (arg.rfind("--filter=", 0) == 0) {
+            config.filter = value("--filter=");
+        } else if (arg.rfind("--json=", 0) == 0) {
+            config.jsonPath = value("--json=");
+        } else if (arg.rfind("--size=", 0) == 0) {
+            size_t cases = std::strtoul(value("--size=").c_str(), nullptr, 10);
+            if (cases == 0) return false;
+            config.spec.cases = cases;
+            config.spec.suspects = cases * 2;
+            config.spec.characters = cases;
+        } else if (arg.rfind("--seed=", 0) == 0) {
+            config.spec.seed = static_cast<unsigned>(std::strtoul(value("--seed=").c_str(), nullptr, 10));
+        } else if (arg.rfind("--min-time=", 0) == 0) {
+            config.minSeconds = std::atof(value("--min-time=").c_str());
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SuiteConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--filter=REGEX] [--json=PATH] [--size=N] [--seed=N] [--min-time=SECONDS]\n";
+        return 1;
+    }
+
+    // Status lines would otherwise be timed along with the work
+    Logger::setLevel(LogLevel::ERROR);
+
+    auto data = std::make_shared<const Dataset>(makeDataset(config.spec));
+    std::cout << "Dataset: " << data->cases.size() << " cases, " << data->suspects.size() << " suspects, "
+              << data->characters.size() << " characters, seed " << config.spec.seed << "\n\n";
+
+    BenchRunner runner;
+    runner.setMinSeconds(config.minSeconds);
+    addTreeBenchmarks<AVLTree<int>>(runner, "avl", config);
+    addTreeBenchmarks<RBTree<int>>(runner, "rb", config);
+    addGraphBenchmarks(runner, data, config);
+    addEngineBenchmarks(runner, data, config);
+    addSerializationBenchmarks(runner, data);
+
+    std::vector<BenchResult> results = runner.run(config.filter, std::cout);
+    Logger::instance().flush();
+
+    if (!config.jsonPath.empty()) {
+        std::ofstream out(config.jsonPath);
+        if (!out) {
+            std::cerr << "Cannot write " << config.jsonPath << "\n";
+            return 1;
+        }
+        writeBenchJson(out, {
+            {"date", quoted(DetectiveUtils::getCurrentDateTime())},
+            {"compiler", quoted(compilerName())},
+            {"num_cpus", std::to_string(std::thread::hardware_concurrency())},
+            {"seed", std::to_string(config.spec.seed)},
+            {"cases", std::to_string(data->cases.size())},
+            {"suspects", std::to_string(data->suspects.size())},
+            {"characters", std::to_string(data->characters.size())},
+            {"min_time", std::to_string(config.minSeconds)},
+#ifdef NDEBUG
+            {"library_build_type", quoted("release")},
+#else
+            {"library_build_type", quoted("debug")},
+#endif
+        }, results);
+        std::cout << "\nWrote " << config.jsonPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Parallel analytics kernels against the serial Graph algorithms they replace.
+// Runs on a random undirected graph (average degree 8) plus a long chain,
+// which is the worst case for label propagation. The old per-node
+// betweenness is O(V^2) shortest paths per node, so it only gets a small
+// graph. Usage: bench_graph_analytics [nodes] [threads]
+#include "graph_analytics.h"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+Graph makeRandom(int nodes, int degree, unsigned seed) {
+    Graph g;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    for (int i = 0; i < nodes; i++) g.addNode("n" + std::to_string(i));
+    for (long long i = 0; i < static_cast<long long>(nodes) * degree / 2; i++) {
+        std::string a = "n" + std::to_string(pick(rng));
+        std::string b = "n" + std::to_string(pick(rng));
+        if (a == b) continue;
+        g.addEdge(a, b);
+        g.addEdge(b, a);
+    }
+    return g;
+}
+
+Graph makeChain(int nodes) {
+    Graph g;
+    for (int i = 0; i + 1 < nodes; i++) {
+        std::string a = "n" + std::to_string(i);
+        std::string b = "n" + std::to_string(i + 1);
+        g.addEdge(a, b);
+        g.addEdge(b, a);
+    }
+    return g;
+}
+
+void time(const std::string& shape, const std::string& name, const std::function<size_t()>& run) {
+    auto start = std::chrono::steady_clock::now();
+    size_t result = run();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(8) << shape << std::setw(34) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+              << "   (" << result << ")\n";
+}
+
+size_t reached(const std::vector<int>& levels) {
+    size_t count = 0;
+    for (int level : levels) count += level >= 0;
+    return count;
+}
+
+size_t distinct(const std::vector<int>& labels) {
+    size_t count = 0;
+    for (size_t i = 0; i < labels.size(); i++) count += labels[i] == static_cast<int>(i);
+    return count;
+}
+
+void runTraversals(const std::string& shape, const Graph& g, const GraphAnalytics& analytics, bool labelPropagation) {
+    auto view = g.getDenseView();
+    int source = view->ids.at("n1");
+
+    time(shape, "bfs (Graph, serial)", [&] {
+        size_t visited = 0;
+        g.bfs("n1", [&](const std::string&) { visited++; });
+        return visited;
+    });
+    BfsOptions options;
+    options.mode = ExecutionMode::SERIAL;
+    options.directionOptimizing = false;
+    time(shape, "bfs top-down, serial", [&] { return reached(analytics.bfsLevels(*view, source, options)); });
+    options.mode = ExecutionMode::PARALLEL;
+    time(shape, "bfs top-down, parallel", [&] { return reached(analytics.bfsLevels(*view, source, options)); });
+    options.directionOptimizing = true;
+    options.mode = ExecutionMode::SERIAL;
+    time(shape, "bfs direction-optimising, serial", [&] { return reached(analytics.bfsLevels(*view, source, options)); });
+    options.mode = ExecutionMode::PARALLEL;
+    time(shape, "bfs direction-optimising, parallel", [&] { return reached(analytics.bfsLevels(*view, source, options)); });
+
+    time(shape, "components (Graph, union-find)", [&] { return g.findConnectedComponents().size(); });
+    if (labelPropagation) {
+        time(shape, "components label-prop, serial", [&] {
+            return distinct(analytics.componentLabels(*view, ComponentAlgorithm::LABEL_PROPAGATION, ExecutionMode::SERIAL));
+        });
+        time(shape, "components label-prop, parallel", [&] {
+            return distinct(analytics.componentLabels(*view, ComponentAlgorithm::LABEL_PROPAGATION, ExecutionMode::PARALLEL));
+        });
+    }
+    time(shape, "components afforest, serial", [&] {
+        return distinct(analytics.componentLabels(*view, ComponentAlgorithm::AFFOREST, ExecutionMode::SERIAL));
+    });
+    time(shape, "components afforest, parallel", [&] {
+        return distinct(analytics.componentLabels(*view, ComponentAlgorithm::AFFOREST, ExecutionMode::PARALLEL));
+    });
+}
+
+void runCentrality(const GraphAnalytics& analytics, int bigNodes) {
+    Graph small = makeRandom(60, 6, 7);
+    auto smallView = small.getDenseView();
+    time("small", "betweenness (Graph, every node)", [&] {
+        size_t positive = 0;
+        for (const auto& name : smallView->names) positive += small.calculateBetweennessCentrality(name) > 0;
+        return positive;
+    });
+    CentralityOptions options;
+    options.mode = ExecutionMode::SERIAL;
+    time("small", "brandes exact, serial", [&] { return analytics.betweenness(*smallView, options).size(); });
+    options.mode = ExecutionMode::PARALLEL;
+    time("small", "brandes exact, parallel", [&] { return analytics.betweenness(*smallView, options).size(); });
+
+    Graph big = makeRandom(bigNodes, 8, 11);
+    auto bigView = big.getDenseView();
+    options.sampleSources = 64;
+    options.mode = ExecutionMode::SERIAL;
+    time("random", "brandes 64 sources, serial", [&] { return analytics.betweenness(*bigView, options).size(); });
+    options.mode = ExecutionMode::PARALLEL;
+    time("random", "brandes 64 sources, parallel", [&] { return analytics.betweenness(*bigView, options).size(); });
+}
+
+}
+
+int main(int argc, char** argv) {
+    int nodes = argc > 1 ? std::atoi(argv[1]) : 200000;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 0;
+
+    WorkStealingPool pool(threads);
+    GraphAnalytics analytics(pool);
+    std::cout << "Graph analytics benchmark, " << nodes << " nodes, "
+              << pool.getThreadCount() << " threads\n\n";
+
+    runTraversals("random", makeRandom(nodes, 8, 3), analytics, true);
+    runTraversals("chain", makeChain(nodes), analytics, false);
+    runCentrality(analytics, nodes);
+    return 0;
+}
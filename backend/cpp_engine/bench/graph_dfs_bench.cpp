@@ -0,0 +1,66 @@
+// DFS-family timings on the two shapes that hurt the old recursive code:
+// a long chain (deep recursion) and a single hub with many leaves (wide
+// adjacency lists). Usage: bench_graph_dfs [nodes]
+#include "graph.h"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+Graph makeChain(int nodes) {
+    Graph g;
+    for (int i = 0; i + 1 < nodes; i++) {
+        std::string a = "n" + std::to_string(i);
+        std::string b = "n" + std::to_string(i + 1);
+        g.addEdge(a, b);
+        g.addEdge(b, a);
+    }
+    return g;
+}
+
+Graph makeHub(int nodes) {
+    Graph g;
+    for (int i = 1; i < nodes; i++) {
+        std::string leaf = "n" + std::to_string(i);
+        g.addEdge("hub", leaf);
+        g.addEdge(leaf, "hub");
+    }
+    return g;
+}
+
+void time(const std::string& shape, const std::string& name, const std::function<size_t()>& run) {
+    auto start = std::chrono::steady_clock::now();
+    size_t result = run();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(8) << shape << std::setw(22) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+              << "   (" << result << ")\n";
+}
+
+void runShape(const std::string& shape, const Graph& g) {
+    time(shape, "dense view", [&] { return g.buildDenseView().targets.size(); });
+    time(shape, "dfs", [&] {
+        size_t visited = 0;
+        g.dfs("n1", [&](const std::string&) { visited++; });
+        return visited;
+    });
+    time(shape, "connected components", [&] { return g.findConnectedComponents().size(); });
+    time(shape, "articulation points", [&] { return g.findArticulationPoints().size(); });
+    time(shape, "bridges", [&] { return g.findBridges().size(); });
+    time(shape, "has cycle", [&] { return static_cast<size_t>(g.hasCycle()); });
+}
+
+}
+
+int main(int argc, char** argv) {
+    int nodes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::cout << "Graph DFS benchmark, " << nodes << " nodes\n\n";
+
+    runShape("chain", makeChain(nodes));
+    runShape("hub", makeHub(nodes));
+    return 0;
+}
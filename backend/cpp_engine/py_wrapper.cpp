@@ -4,6 +4,7 @@
 #include <pybind11/functional.h>
 #include <pybind11/chrono.h>
 #include "src/core/engine.h"
+#include "src/core/logger.h"
 #include "src/core/story_manager.h"
 #include "src/models/case.h"
 #include "src/models/character.h"
@@ -58,6 +59,49 @@ PYBIND11_MODULE(whodunnit_engine, m) {
         .value("CONFIRMED", AlibiStrength::CONFIRMED)
         .export_values();
 
+    py::enum_<WalSyncPolicy>(m, "WalSyncPolicy")
+        .value("ALWAYS", WalSyncPolicy::ALWAYS)
+        .value("INTERVAL", WalSyncPolicy::INTERVAL)
+        .value("NEVER", WalSyncPolicy::NEVER)
+        .export_values();
+
+    py::enum_<ImportFormat>(m, "ImportFormat")
+        .value("AUTO", ImportFormat::AUTO)
+        .value("CSV", ImportFormat::CSV)
+        .value("NDJSON", ImportFormat::NDJSON)
+        .export_values();
+
+    py::enum_<EntityTypeMask>(m, "EntityType", py::arithmetic())
+        .value("CASE", ENTITY_CASE)
+        .value("SUSPECT", ENTITY_SUSPECT)
+        .value("CHARACTER", ENTITY_CHARACTER)
+        .value("ANY", ENTITY_ANY)
+        .export_values();
+
+    py::enum_<ListOrder>(m, "ListOrder")
+        .value("NAME", ListOrder::NAME)
+        .value("ID", ListOrder::ID)
+        .export_values();
+
+    py::enum_<CaseOrder>(m, "CaseOrder")
+        .value("TITLE", CaseOrder::TITLE)
+        .value("ID", CaseOrder::ID)
+        .value("PRIORITY", CaseOrder::PRIORITY)
+        .value("MAX_SUSPICION", CaseOrder::MAX_SUSPICION)
+        .export_values();
+
+    py::enum_<ChangeEntity>(m, "ChangeEntity")
+        .value("CASE", ChangeEntity::CASE)
+        .value("SUSPECT", ChangeEntity::SUSPECT)
+        .value("CHARACTER", ChangeEntity::CHARACTER)
+        .export_values();
+
+    py::enum_<ChangeOp>(m, "ChangeOp")
+        .value("CREATED", ChangeOp::CREATED)
+        .value("UPDATED", ChangeOp::UPDATED)
+        .value("REMOVED", ChangeOp::REMOVED)
+        .export_values();
+
     py::enum_<Reliability>(m, "Reliability")
         .value("UNRELIABLE", Reliability::UNRELIABLE)
         .value("SOMEWHAT_RELIABLE", Reliability::SOMEWHAT_RELIABLE)
@@ -65,6 +109,14 @@ PYBIND11_MODULE(whodunnit_engine, m) {
         .value("HIGHLY_RELIABLE", Reliability::HIGHLY_RELIABLE)
         .export_values();
 
+    py::enum_<LogLevel>(m, "LogLevel")
+        .value("VERBOSE", LogLevel::VERBOSE)
+        .value("INFO", LogLevel::INFO)
+        .value("WARNING", LogLevel::WARNING)
+        .value("ERROR", LogLevel::ERROR)
+        .value("NONE", LogLevel::NONE)
+        .export_values();
+
     // ==================== UTILITY CLASSES ====================
     py::class_<CaseUtils>(m, "CaseUtils")
         .def_static("status_to_string", &CaseUtils::statusToString)
@@ -261,7 +313,83 @@ PYBIND11_MODULE(whodunnit_engine, m) {
                    ", total_suspects=" + std::to_string(stats.totalSuspects) + ")";
         });
 
+    py::class_<OperationMetrics>(m, "OperationMetrics")
+        .def_readonly("name", &OperationMetrics::name)
+        .def_readonly("calls", &OperationMetrics::calls)
+        .def_readonly("timed_calls", &OperationMetrics::timedCalls)
+        .def_readonly("total_ms", &OperationMetrics::totalMs)
+        .def_readonly("mean_us", &OperationMetrics::meanUs)
+        .def_readonly("p50_us", &OperationMetrics::p50Us)
+        .def_readonly("p90_us", &OperationMetrics::p90Us)
+        .def_readonly("p99_us", &OperationMetrics::p99Us)
+        .def_readonly("p999_us", &OperationMetrics::p999Us)
+        .def_readonly("max_us", &OperationMetrics::maxUs)
+        .def("__repr__", [](const OperationMetrics& op) {
+            return "OperationMetrics(name=" + op.name + ", calls=" + std::to_string(op.calls) + ")";
+        });
+
+    py::class_<Engine::Metrics>(m, "EngineMetrics")
+        .def_readonly("operations", &Engine::Metrics::operations)
+        .def_readonly("cases", &Engine::Metrics::cases)
+        .def_readonly("suspects", &Engine::Metrics::suspects)
+        .def_readonly("characters", &Engine::Metrics::characters)
+        .def_readonly("graph_nodes", &Engine::Metrics::graphNodes)
+        .def_readonly("graph_edges", &Engine::Metrics::graphEdges)
+        .def_readonly("threads", &Engine::Metrics::threads);
+
     // ==================== MAIN ENGINE CLASS ====================
+    py::class_<ImportError>(m, "ImportError")
+        .def_readonly("line", &ImportError::line)
+        .def_readonly("message", &ImportError::message);
+
+    py::class_<ImportReport>(m, "ImportReport")
+        .def_readonly("ok", &ImportReport::ok)
+        .def_readonly("fatal_error", &ImportReport::fatalError)
+        .def_readonly("rows_processed", &ImportReport::rowsProcessed)
+        .def_readonly("rows_failed", &ImportReport::rowsFailed)
+        .def_readonly("cases_imported", &ImportReport::casesImported)
+        .def_readonly("suspects_imported", &ImportReport::suspectsImported)
+        .def_readonly("characters_imported", &ImportReport::charactersImported)
+        .def_readonly("links_imported", &ImportReport::linksImported)
+        .def_readonly("seconds", &ImportReport::seconds)
+        .def_readonly("errors", &ImportReport::errors);
+
+    py::class_<HopResult>(m, "HopResult")
+        .def_readonly("name", &HopResult::name)
+        .def_readonly("type", &HopResult::type)
+        .def_readonly("depth", &HopResult::depth);
+
+    py::class_<ChangeEvent>(m, "ChangeEvent")
+        .def_readonly("version", &ChangeEvent::version)
+        .def_readonly("entity", &ChangeEvent::entity)
+        .def_readonly("id", &ChangeEvent::id)
+        .def_readonly("op", &ChangeEvent::op);
+
+    py::class_<ChangeSet>(m, "ChangeSet")
+        .def_readonly("epoch", &ChangeSet::epoch)
+        .def_readonly("version", &ChangeSet::version)
+        .def_readonly("full_sync", &ChangeSet::fullSync)
+        .def_readonly("events", &ChangeSet::events);
+
+    // Builder methods return the same query so calls chain
+    py::class_<CaseQuery>(m, "CaseQuery")
+        .def("where", &CaseQuery::where, py::return_value_policy::reference_internal)
+        .def("where_status", &CaseQuery::whereStatus, py::return_value_policy::reference_internal)
+        .def("where_unsolved", &CaseQuery::whereUnsolved, py::return_value_policy::reference_internal)
+        .def("where_min_priority", &CaseQuery::whereMinPriority, py::return_value_policy::reference_internal)
+        .def("where_title_from", &CaseQuery::whereTitleFrom, py::return_value_policy::reference_internal)
+        .def("where_id_range", &CaseQuery::whereIdRange, py::return_value_policy::reference_internal)
+        .def("join_suspects", &CaseQuery::joinSuspects, py::arg("min_suspicion") = 0.0,
+             py::arg("max_suspicion") = 100.0, py::return_value_policy::reference_internal)
+        .def("join_suspect_status", &CaseQuery::joinSuspectStatus, py::return_value_policy::reference_internal)
+        .def("join_suspect_named", &CaseQuery::joinSuspectNamed, py::return_value_policy::reference_internal)
+        .def("join_suspects_where", &CaseQuery::joinSuspectsWhere, py::return_value_policy::reference_internal)
+        .def("order_by", &CaseQuery::orderBy, py::arg("order"), py::arg("descending") = false,
+             py::return_value_policy::reference_internal)
+        .def("offset", &CaseQuery::offset, py::return_value_policy::reference_internal)
+        .def("limit", &CaseQuery::limit, py::return_value_policy::reference_internal)
+        .def("run", &CaseQuery::run, py::return_value_policy::reference);
+
     py::class_<Engine>(m, "DetectiveEngine")
         .def(py::init<>())
         
@@ -272,12 +400,18 @@ PYBIND11_MODULE(whodunnit_engine, m) {
              py::arg("priority") = CasePriority::MEDIUM)
         .def("remove_case", &Engine::removeCase)
         .def("update_case", &Engine::updateCase)
+        .def("update_case_details", &Engine::updateCaseDetails,
+             py::arg("title"), py::arg("location"), py::arg("notes"), py::arg("solution"))
+        .def("add_case_evidence", &Engine::addCaseEvidence)
+        .def("remove_case_evidence", &Engine::removeCaseEvidence)
         .def("find_case", &Engine::findCase, py::return_value_policy::reference)
         .def("find_case_by_id", &Engine::findCaseById, py::return_value_policy::reference)
         .def("get_all_cases", &Engine::getAllCases, py::return_value_policy::reference)
         .def("find_cases_by_status", &Engine::findCasesByStatus, py::return_value_policy::reference)
         .def("find_cases_by_priority", &Engine::findCasesByPriority, py::return_value_policy::reference)
         .def("search_cases", &Engine::searchCases, py::return_value_policy::reference)
+        .def("list_cases", &Engine::listCases, py::arg("after") = "", py::arg("limit") = 50,
+             py::arg("order") = ListOrder::NAME, py::return_value_policy::reference)
         
         // Suspect Management
         .def("add_suspect", &Engine::addSuspect,
@@ -286,24 +420,32 @@ PYBIND11_MODULE(whodunnit_engine, m) {
              py::arg("occupation") = "Unknown")
         .def("remove_suspect", &Engine::removeSuspect)
         .def("update_suspect", &Engine::updateSuspect)
+        .def("update_suspect_assessment", &Engine::updateSuspectAssessment,
+             py::arg("name"), py::arg("motive"), py::arg("alibi"), py::arg("alibi_strength"),
+             py::arg("status"), py::arg("suspicion_level") = -1.0)
         .def("find_suspect", &Engine::findSuspect, py::return_value_policy::reference)
         .def("find_suspect_by_id", &Engine::findSuspectById, py::return_value_policy::reference)
         .def("get_all_suspects", &Engine::getAllSuspects, py::return_value_policy::reference)
         .def("find_suspects_by_status", &Engine::findSuspectsByStatus, py::return_value_policy::reference)
         .def("find_suspects_by_suspicion_range", &Engine::findSuspectsBySuspicionRange, py::return_value_policy::reference)
         .def("search_suspects", &Engine::searchSuspects, py::return_value_policy::reference)
+        .def("list_suspects", &Engine::listSuspects, py::arg("after") = "", py::arg("limit") = 50,
+             py::arg("order") = ListOrder::NAME, py::return_value_policy::reference)
         
-        // Character Management
+        // Character Management. Characters move in the slot map on every
+        // insert or remove, so Python gets copies rather than references
         .def("add_character", &Engine::addCharacter,
              py::arg("name"), py::arg("role"),
              py::arg("story") = "")
         .def("remove_character", &Engine::removeCharacter)
         .def("update_character", &Engine::updateCharacter)
-        .def("find_character", &Engine::findCharacter, py::return_value_policy::reference)
-        .def("find_character_by_id", &Engine::findCharacterById, py::return_value_policy::reference)
-        .def("get_all_characters", &Engine::getAllCharacters, py::return_value_policy::reference)
-        .def("find_characters_by_role", &Engine::findCharactersByRole, py::return_value_policy::reference)
-        .def("search_characters", &Engine::searchCharacters, py::return_value_policy::reference)
+        .def("find_character", &Engine::findCharacter, py::return_value_policy::copy)
+        .def("find_character_by_id", &Engine::findCharacterById, py::return_value_policy::copy)
+        .def("get_all_characters", &Engine::getAllCharacters, py::return_value_policy::copy)
+        .def("find_characters_by_role", &Engine::findCharactersByRole, py::return_value_policy::copy)
+        .def("search_characters", &Engine::searchCharacters, py::return_value_policy::copy)
+        .def("list_characters", &Engine::listCharacters, py::arg("after") = "", py::arg("limit") = 50,
+             py::arg("order") = ListOrder::NAME, py::return_value_policy::copy)
         
         // Relationship Management
         .def("link_suspect_to_case", &Engine::linkSuspectToCase)
@@ -314,31 +456,92 @@ PYBIND11_MODULE(whodunnit_engine, m) {
              py::arg("entity1"), py::arg("entity2"),
              py::arg("relationship_type") = "related")
         .def("remove_relationship", &Engine::removeRelationship)
-        .def("get_relationships", &Engine::getRelationships, py::return_value_policy::reference)
-        .def("find_path", &Engine::findPath, py::return_value_policy::reference)
+        .def("get_relationships",
+             [](Engine& self, const std::string& entity, const std::vector<std::string>& types) {
+                 return self.getRelationships(entity, types);
+             },
+             py::arg("entity"), py::arg("types") = std::vector<std::string>())
+        .def("get_relationship_type", &Engine::getRelationshipType)
+        .def("get_relationship_types", &Engine::getRelationshipTypes)
+        .def("find_path",
+             [](Engine& self, const std::string& from, const std::string& to, const std::vector<std::string>& types) {
+                 return self.findPath(from, to, types);
+             },
+             py::arg("from_entity"), py::arg("to_entity"), py::arg("types") = std::vector<std::string>())
+        .def("same_component", &Engine::sameComponent)
+        .def("get_component_size", &Engine::getComponentSize)
+        .def("get_component_count", &Engine::getComponentCount)
+        // Keeps the GIL: the Engine is not thread-safe, and this call fills
+        // the graph's view cache and may start the analytics pool
+        .def("get_key_entities", &Engine::getKeyEntities,
+             py::arg("count") = 10, py::arg("parallel") = true)
         
         // Analysis & Queries
         .def("get_suspects_for_case", &Engine::getSuspectsForCase, py::return_value_policy::reference)
-        .def("get_characters_for_case", &Engine::getCharactersForCase, py::return_value_policy::reference)
+        .def("get_characters_for_case", &Engine::getCharactersForCase, py::return_value_policy::copy)
         .def("get_cases_for_suspect", &Engine::getCasesForSuspect, py::return_value_policy::reference)
         .def("get_cases_for_character", &Engine::getCasesForCharacter, py::return_value_policy::reference)
         .def("get_prime_suspects", &Engine::getPrimeSuspects, py::return_value_policy::reference)
         .def("get_unsolved_cases", &Engine::getUnsolvedCases, py::return_value_policy::reference)
         .def("get_high_priority_cases", &Engine::getHighPriorityCases, py::return_value_policy::reference)
+        .def("query_cases", &Engine::queryCases, py::keep_alive<0, 1>())
         .def("recalculate_all_suspicion_levels", &Engine::recalculateAllSuspicionLevels)
         .def("get_top_suspects", &Engine::getTopSuspects, py::arg("count") = 5, py::return_value_policy::reference)
         .def("find_connected_suspects", &Engine::findConnectedSuspects,
-             py::arg("suspect_name"), py::arg("max_depth") = 2, py::return_value_policy::reference)
+             py::arg("suspect_name"), py::arg("max_depth") = 2,
+             py::arg("edge_types") = std::vector<std::string>(), py::return_value_policy::reference)
+        .def("find_neighborhood", &Engine::findNeighborhood,
+             py::arg("seeds"), py::arg("max_depth") = 2,
+             py::arg("result_types") = static_cast<uint8_t>(ENTITY_ANY),
+             py::arg("traverse_types") = static_cast<uint8_t>(ENTITY_ANY),
+             py::arg("edge_types") = std::vector<std::string>())
         
         // Statistics
         .def("get_statistics", &Engine::getStatistics)
         .def("print_statistics", &Engine::printStatistics)
+        .def("get_metrics", &Engine::getMetrics)
+        .def("reset_metrics", &Engine::resetMetrics)
         
         // Data Integrity
         .def("validate_data", &Engine::validateData)
         .def("get_data_issues", &Engine::getDataIssues, py::return_value_policy::reference)
         .def("rebuild_all_connections", &Engine::rebuildAllConnections)
-        
+
+        // Change Feed
+        .def("get_version", &Engine::getVersion)
+        .def("changes_since", &Engine::changesSince, py::arg("version"))
+
+        // Persistence
+        .def("save_snapshot", &Engine::saveSnapshot)
+        .def("load_snapshot", &Engine::loadSnapshot, py::arg("path"), py::arg("map_strings") = false,
+             py::arg("verify_checksum") = false)
+        .def("export_serialized", &Engine::exportSerialized)
+        .def("import_serialized", &Engine::importSerialized)
+        .def("bulk_import", [](Engine& engine, const std::string& path, ImportFormat format,
+                               unsigned workers, py::object progress) {
+                 ImportOptions options;
+                 options.format = format;
+                 options.workers = workers;
+                 if (!progress.is_none()) {
+                     // Called on this thread between batches
+                     options.onProgress = [progress](const ImportProgress& p) {
+                         progress(p.bytesProcessed, p.totalBytes, p.rowsProcessed, p.rowsFailed);
+                     };
+                 }
+                 // The GIL stays held: the import writes the indices, trees and
+                 // graph, which other Python threads would otherwise read mid-update
+                 return engine.bulkImport(path, options);
+             },
+             py::arg("path"), py::arg("format") = ImportFormat::AUTO,
+             py::arg("workers") = 0, py::arg("progress") = py::none())
+        .def("open_durable", &Engine::openDurable,
+             py::arg("directory"), py::arg("policy") = WalSyncPolicy::ALWAYS)
+        .def("close_durable", &Engine::closeDurable)
+        .def("is_durable", &Engine::isDurable)
+        .def("sync_log", &Engine::syncLog, py::call_guard<py::gil_scoped_release>())
+        .def("compact_log", &Engine::compactLog)
+        .def("wait_for_compaction", &Engine::waitForCompaction, py::call_guard<py::gil_scoped_release>())
+
         // Utility Methods
         .def("display_all_data", &Engine::displayAllData)
         .def("display_case_network", &Engine::displayCaseNetwork)
@@ -362,6 +565,15 @@ PYBIND11_MODULE(whodunnit_engine, m) {
     m.def("initialize_engine", []() { return new Engine(); }, py::return_value_policy::take_ownership);
     m.def("create_story_manager", [](Engine* engine) { return new StoryManager(engine); }, py::return_value_policy::take_ownership);
 
+    // Engine logging: runtime threshold, and a blocking drain of queued lines
+    m.def("set_log_level", &Logger::setLevel);
+    m.def("get_log_level", &Logger::getLevel);
+    m.def("flush_logs", []() { Logger::instance().flush(); }, py::call_guard<py::gil_scoped_release>());
+
+    // Entity text: share equal values across the process (off by default)
+    m.def("set_string_deduplication", [](bool enabled) { StringPool::global().setDeduplication(enabled); });
+    m.def("get_string_deduplication", []() { return StringPool::global().isDeduplicating(); });
+
     // Version info
     m.attr("__version__") = "1.0.0";
     m.attr("__author__") = "WhoDunnitBro Team";
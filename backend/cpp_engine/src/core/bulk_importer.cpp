@@ -0,0 +1,857 @@
+#include "bulk_importer.h"
+#include "engine.h"
+#include "logger.h"
+#include "mapped_file.h"
+#include "../models/serialization.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+// ==================== COLUMNS ====================
+enum Column {
+    COL_TYPE, COL_ID, COL_TITLE, COL_DESCRIPTION, COL_LOCATION, COL_STATUS, COL_PRIORITY,
+    COL_NAME, COL_BACKGROUND, COL_STORY, COL_AGE, COL_OCCUPATION, COL_MOTIVE, COL_ALIBI,
+    COL_ROLE, COL_FROM, COL_TO, COL_RELATION, COL_EVIDENCE, COL_TAGS,
+    COLUMN_COUNT
+};
+
+const char* const COLUMN_NAMES[COLUMN_COUNT] = {
+    "type", "id", "title", "description", "location", "status", "priority",
+    "name", "background", "story", "age", "occupation", "motive", "alibi",
+    "role", "from", "to", "relation", "evidence", "tags"
+};
+
+const char* const CASE_STATUS_NAMES[] = {"OPEN", "IN_PROGRESS", "SOLVED", "COLD", "UNSOLVED"};
+const char* const CASE_PRIORITY_NAMES[] = {"LOW", "MEDIUM", "HIGH", "URGENT"};
+const char* const SUSPECT_STATUS_NAMES[] = {
+    "UNINVESTIGATED", "UNDER_INVESTIGATION", "CLEARED", "PRIME_SUSPECT", "CONVICTED", "ACQUITTED"
+};
+const char* const ROLE_NAMES[] = {"WITNESS", "INFORMANT", "VICTIM", "OFFICER", "DETECTIVE", "EXPERT", "OTHER"};
+
+std::string_view trimView(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+    return s;
+}
+
+// Upper-cases and drops spaces, '_' and '-' so "In Progress" == "IN_PROGRESS"
+std::string normalizeToken(std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == ' ' || c == '_' || c == '-') continue;
+        out += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+int columnFor(std::string_view name) {
+    name = trimView(name);
+    for (int i = 0; i < COLUMN_COUNT; i++) {
+        const char* candidate = COLUMN_NAMES[i];
+        if (name.size() != std::strlen(candidate)) continue;
+        bool match = true;
+        for (size_t j = 0; j < name.size() && match; j++) {
+            match = std::tolower(static_cast<unsigned char>(name[j])) == candidate[j];
+        }
+        if (match) return i;
+    }
+    return -1;
+}
+
+template <typename E>
+bool parseEnum(const std::string& raw, const char* const* names, int count, std::string (*display)(E), E& out) {
+    std::string_view value = trimView(raw);
+    int numeric;
+    if (Serialization::parseInt(value, numeric)) {
+        if (numeric < 0 || numeric >= count) return false;
+        out = static_cast<E>(numeric);
+        return true;
+    }
+
+    std::string wanted = normalizeToken(value);
+    for (int i = 0; i < count; i++) {
+        if (wanted == normalizeToken(names[i]) || wanted == normalizeToken(display(static_cast<E>(i)))) {
+            out = static_cast<E>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void splitList(const std::string& raw, std::vector<std::string>& out) {
+    out.clear();
+    size_t start = 0;
+    while (start <= raw.size()) {
+        size_t end = raw.find(';', start);
+        if (end == std::string::npos) end = raw.size();
+        std::string_view item = trimView(std::string_view(raw).substr(start, end - start));
+        if (!item.empty()) out.emplace_back(item);
+        start = end + 1;
+    }
+}
+
+// ==================== PARSED BATCHES ====================
+struct RowFields {
+    std::string values[COLUMN_COUNT];
+    bool present[COLUMN_COUNT];
+
+    void reset() {
+        for (int i = 0; i < COLUMN_COUNT; i++) {
+            values[i].clear();
+            present[i] = false;
+        }
+    }
+    bool has(Column c) const { return present[c] && !values[c].empty(); }
+};
+
+// Lines in rows and errors are relative to the chunk until the writer rebases them
+struct CaseRow {
+    size_t line;
+    int id;
+    std::string title, description, location;
+    CaseStatus status;
+    CasePriority priority;
+    std::vector<std::string> evidence, tags;
+};
+
+struct SuspectRow {
+    size_t line;
+    int id;
+    int age;
+    bool hasStatus;
+    SuspectStatus status;
+    std::string name, background, story, occupation, motive, alibi;
+};
+
+struct CharacterRow {
+    size_t line;
+    int id;
+    CharacterRole role;
+    std::string name, story;
+};
+
+struct LinkRow {
+    size_t line;
+    std::string from, to, relation;
+};
+
+struct Batch {
+    size_t rows = 0;
+    size_t failed = 0;
+    size_t lines = 0;
+    size_t bytes = 0;
+    std::string fatalError;
+    std::vector<CaseRow> cases;
+    std::vector<SuspectRow> suspects;
+    std::vector<CharacterRow> characters;
+    std::vector<LinkRow> links;
+    std::vector<ImportError> errors;
+};
+
+struct Chunk {
+    size_t begin;
+    size_t end;
+};
+
+void addError(Batch& batch, size_t maxErrors, size_t line, std::string message) {
+    batch.failed++;
+    if (batch.errors.size() < maxErrors) batch.errors.push_back({line, std::move(message)});
+}
+
+bool parseId(const RowFields& f, int& id) {
+    id = 0;
+    return !f.has(COL_ID) || (Serialization::parseInt(trimView(f.values[COL_ID]), id) && id > 0);
+}
+
+void buildRow(const RowFields& f, size_t line, Batch& batch, size_t maxErrors) {
+    batch.rows++;
+    std::string type = normalizeToken(f.values[COL_TYPE]);
+    int id;
+    if (!parseId(f, id)) {
+        addError(batch, maxErrors, line, "Invalid id: " + f.values[COL_ID]);
+        return;
+    }
+
+    if (type == "CASE") {
+        CaseRow row{line, id, f.values[COL_TITLE], f.values[COL_DESCRIPTION], f.values[COL_LOCATION],
+                    CaseStatus::OPEN, CasePriority::MEDIUM, {}, {}};
+        if (row.title.empty() || row.description.empty()) {
+            addError(batch, maxErrors, line, "Case needs a title and description");
+            return;
+        }
+        if (f.has(COL_STATUS) && !parseEnum(f.values[COL_STATUS], CASE_STATUS_NAMES, 5, &CaseUtils::statusToString, row.status)) {
+            addError(batch, maxErrors, line, "Unknown case status: " + f.values[COL_STATUS]);
+            return;
+        }
+        if (f.has(COL_PRIORITY) && !parseEnum(f.values[COL_PRIORITY], CASE_PRIORITY_NAMES, 4, &CaseUtils::priorityToString, row.priority)) {
+            addError(batch, maxErrors, line, "Unknown case priority: " + f.values[COL_PRIORITY]);
+            return;
+        }
+        splitList(f.values[COL_EVIDENCE], row.evidence);
+        splitList(f.values[COL_TAGS], row.tags);
+        batch.cases.push_back(std::move(row));
+    } else if (type == "SUSPECT") {
+        SuspectRow row{line, id, 0, false, SuspectStatus::UNINVESTIGATED, f.values[COL_NAME], f.values[COL_BACKGROUND],
+                       f.values[COL_STORY], f.values[COL_OCCUPATION], f.values[COL_MOTIVE], f.values[COL_ALIBI]};
+        if (row.name.empty()) {
+            addError(batch, maxErrors, line, "Suspect needs a name");
+            return;
+        }
+        if (f.has(COL_AGE) && (!Serialization::parseInt(trimView(f.values[COL_AGE]), row.age) || !Suspect::validateAge(row.age))) {
+            addError(batch, maxErrors, line, "Invalid age: " + f.values[COL_AGE]);
+            return;
+        }
+        if (f.has(COL_STATUS)) {
+            if (!parseEnum(f.values[COL_STATUS], SUSPECT_STATUS_NAMES, 6, &SuspectUtils::statusToString, row.status)) {
+                addError(batch, maxErrors, line, "Unknown suspect status: " + f.values[COL_STATUS]);
+                return;
+            }
+            row.hasStatus = true;
+        }
+        if (row.occupation.empty()) row.occupation = "Unknown";
+        batch.suspects.push_back(std::move(row));
+    } else if (type == "CHARACTER" || type == "WITNESS") {
+        CharacterRow row{line, id, type == "WITNESS" ? CharacterRole::WITNESS : CharacterRole::OTHER,
+                         f.values[COL_NAME], f.values[COL_STORY]};
+        if (row.name.empty()) {
+            addError(batch, maxErrors, line, "Character needs a name");
+            return;
+        }
+        if (f.has(COL_ROLE) && !parseEnum(f.values[COL_ROLE], ROLE_NAMES, 7, &CharacterUtils::roleToString, row.role)) {
+            addError(batch, maxErrors, line, "Unknown role: " + f.values[COL_ROLE]);
+            return;
+        }
+        batch.characters.push_back(std::move(row));
+    } else if (type == "LINK") {
+        LinkRow row{line, f.values[COL_FROM], f.values[COL_TO], f.values[COL_RELATION]};
+        if (row.from.empty() || row.to.empty()) {
+            addError(batch, maxErrors, line, "Link needs from and to");
+            return;
+        }
+        if (row.relation.empty()) row.relation = "related";
+        batch.links.push_back(std::move(row));
+    } else {
+        addError(batch, maxErrors, line, "Unknown record type: " + f.values[COL_TYPE]);
+    }
+}
+
+// ==================== CSV ====================
+// Reads one RFC 4180 record starting at p. Quoted fields may contain commas,
+// doubled quotes and line breaks. newlines counts the line breaks consumed.
+bool readCsvRecord(const char*& p, const char* end, std::vector<std::string>& fields, size_t& fieldCount,
+                   size_t& newlines, std::string& error) {
+    fieldCount = 0;
+    while (true) {
+        if (fieldCount == fields.size()) fields.emplace_back();
+        std::string& out = fields[fieldCount++];
+        out.clear();
+
+        if (p < end && *p == '"') {
+            p++;
+            while (true) {
+                const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+                if (!quote) {
+                    error = "Unterminated quoted field";
+                    return false;
+                }
+                newlines += std::count(p, quote, '\n');
+                out.append(p, quote);
+                p = quote + 1;
+                if (p < end && *p == '"') {
+                    out += '"';
+                    p++;
+                } else {
+                    break;
+                }
+            }
+            if (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                error = "Unexpected character after quoted field";
+                return false;
+            }
+        } else {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '\n') p++;
+            const char* fieldEnd = p;
+            if (fieldEnd > start && fieldEnd[-1] == '\r' && (p == end || *p == '\n')) fieldEnd--;
+            out.append(start, fieldEnd);
+        }
+
+        if (p < end && *p == ',') {
+            p++;
+            continue;
+        }
+        if (p < end && *p == '\r') p++;
+        if (p < end && *p == '\n') {
+            p++;
+            newlines++;
+        }
+        return true;
+    }
+}
+
+void skipLine(const char*& p, const char* end, size_t& newlines) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (nl) {
+        p = nl + 1;
+        newlines++;
+    } else {
+        p = end;
+    }
+}
+
+void parseCsvChunk(const char* begin, const char* end, const std::vector<int>& headerColumns,
+                   size_t maxErrors, Batch& batch) {
+    std::vector<std::string> fields;
+    RowFields row;
+    std::string error;
+    const char* p = begin;
+    size_t line = 0;
+
+    while (p < end) {
+        if (*p == '\n' || (*p == '\r' && p + 1 < end && p[1] == '\n')) {
+            skipLine(p, end, line);
+            continue;
+        }
+
+        size_t recordLine = line;
+        size_t fieldCount = 0;
+        if (!readCsvRecord(p, end, fields, fieldCount, line, error)) {
+            batch.rows++;
+            addError(batch, maxErrors, recordLine, error);
+            skipLine(p, end, line);
+            continue;
+        }
+
+        row.reset();
+        for (size_t i = 0; i < fieldCount && i < headerColumns.size(); i++) {
+            int column = headerColumns[i];
+            if (column < 0) continue;
+            row.values[column].swap(fields[i]);
+            row.present[column] = true;
+        }
+        buildRow(row, recordLine, batch, maxErrors);
+    }
+    batch.lines = line;
+}
+
+// ==================== NDJSON ====================
+class JsonLine {
+private:
+    const char* p;
+    const char* end;
+
+    void skipWhitespace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool readHex4(uint32_t& value) {
+        if (end - p < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = *p++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool readString(std::string& out, std::string& error) {
+        out.clear();
+        p++;  // opening quote
+        while (p < end) {
+            const char* start = p;
+            while (p < end && *p != '"' && *p != '\\') p++;
+            out.append(start, p);
+            if (p >= end) break;
+            if (*p == '"') {
+                p++;
+                return true;
+            }
+
+            p++;  // backslash
+            if (p >= end) break;
+            char c = *p++;
+            switch (c) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!readHex4(cp)) {
+                        error = "Bad \\u escape";
+                        return false;
+                    }
+                    if (cp >= 0xD800 && cp <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        p += 2;
+                        uint32_t low;
+                        if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                            error = "Bad surrogate pair";
+                            return false;
+                        }
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default:
+                    error = std::string("Bad escape \\") + c;
+                    return false;
+            }
+        }
+        error = "Unterminated string";
+        return false;
+    }
+
+    // Numbers and literals are kept as their source text; null means absent
+    bool readScalar(std::string& out, bool& isNull, std::string& error) {
+        isNull = false;
+        if (p < end && *p == '"') return readString(out, error);
+        const char* start = p;
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r') p++;
+        out.assign(start, p);
+        if (out.empty()) {
+            error = "Missing value";
+            return false;
+        }
+        if (out == "null") {
+            isNull = true;
+            out.clear();
+        } else if (out != "true" && out != "false") {
+            double number;
+            if (!Serialization::parseDouble(out, number)) {
+                error = "Invalid value: " + out;
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    JsonLine(const char* begin, const char* finish) : p(begin), end(finish) {}
+
+    bool parseObject(RowFields& row, std::string& key, std::string& scratch, std::string& error) {
+        skipWhitespace();
+        if (p >= end || *p != '{') {
+            error = "Expected a JSON object";
+            return false;
+        }
+        p++;
+        skipWhitespace();
+        if (p < end && *p == '}') {
+            p++;
+        } else {
+            while (true) {
+                skipWhitespace();
+                if (p >= end || *p != '"') {
+                    error = "Expected a field name";
+                    return false;
+                }
+                if (!readString(key, error)) return false;
+                skipWhitespace();
+                if (p >= end || *p != ':') {
+                    error = "Expected ':' after \"" + key + "\"";
+                    return false;
+                }
+                p++;
+                skipWhitespace();
+
+                int column = columnFor(key);
+                std::string& target = column >= 0 ? row.values[column] : scratch;
+                bool isNull = false;
+                if (p < end && *p == '[') {
+                    // Arrays become ';'-joined lists
+                    p++;
+                    target.clear();
+                    skipWhitespace();
+                    bool first = true;
+                    while (p < end && *p != ']') {
+                        if (!first) {
+                            if (*p != ',') {
+                                error = "Expected ',' in array";
+                                return false;
+                            }
+                            p++;
+                            skipWhitespace();
+                        }
+                        bool itemNull;
+                        if (p < end && (*p == '{' || *p == '[')) {
+                            error = "Nested values are not supported";
+                            return false;
+                        }
+                        if (!readScalar(scratch, itemNull, error)) return false;
+                        if (!itemNull) {
+                            if (!target.empty()) target += ';';
+                            target += scratch;
+                        }
+                        first = false;
+                        skipWhitespace();
+                    }
+                    if (p >= end) {
+                        error = "Unterminated array";
+                        return false;
+                    }
+                    p++;
+                } else if (p < end && *p == '{') {
+                    error = "Nested objects are not supported";
+                    return false;
+                } else if (!readScalar(target, isNull, error)) {
+                    return false;
+                }
+                if (column >= 0) row.present[column] = !isNull;
+
+                skipWhitespace();
+                if (p < end && *p == ',') {
+                    p++;
+                    continue;
+                }
+                if (p < end && *p == '}') {
+                    p++;
+                    break;
+                }
+                error = "Expected ',' or '}'";
+                return false;
+            }
+        }
+        skipWhitespace();
+        if (p != end) {
+            error = "Trailing data after object";
+            return false;
+        }
+        return true;
+    }
+};
+
+void parseNdjsonChunk(const char* begin, const char* end, size_t maxErrors, Batch& batch) {
+    RowFields row;
+    std::string key, scratch, error;
+    const char* p = begin;
+    size_t line = 0;
+
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* lineEnd = nl ? nl : end;
+        std::string_view text = trimView(std::string_view(p, lineEnd - p));
+        if (!text.empty()) {
+            row.reset();
+            if (JsonLine(text.data(), text.data() + text.size()).parseObject(row, key, scratch, error)) {
+                buildRow(row, line, batch, maxErrors);
+            } else {
+                batch.rows++;
+                addError(batch, maxErrors, line, error);
+            }
+        }
+        line++;
+        p = nl ? nl + 1 : end;
+    }
+    batch.lines = line;
+}
+
+// ==================== CHUNKING ====================
+// CSV needs a quote-aware scan because quoted fields may span lines
+std::vector<Chunk> splitChunks(const char* data, size_t begin, size_t size, size_t chunkBytes, bool csv) {
+    std::vector<Chunk> chunks;
+    chunkBytes = std::max<size_t>(chunkBytes, 4096);
+    size_t chunkStart = begin;
+
+    if (csv) {
+        bool inQuotes = false;
+        for (size_t i = begin; i < size; i++) {
+            char c = data[i];
+            if (c == '"') {
+                inQuotes = !inQuotes;
+            } else if (c == '\n' && !inQuotes && i + 1 - chunkStart >= chunkBytes) {
+                chunks.push_back({chunkStart, i + 1});
+                chunkStart = i + 1;
+            }
+        }
+    } else {
+        while (size - chunkStart > chunkBytes) {
+            const void* nl = std::memchr(data + chunkStart + chunkBytes, '\n', size - chunkStart - chunkBytes);
+            if (!nl) break;
+            size_t next = static_cast<const char*>(nl) - data + 1;
+            chunks.push_back({chunkStart, next});
+            chunkStart = next;
+        }
+    }
+
+    if (chunkStart < size) chunks.push_back({chunkStart, size});
+    return chunks;
+}
+
+bool hasSuffix(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    if (s.size() < n) return false;
+    for (size_t i = 0; i < n; i++) {
+        if (std::tolower(static_cast<unsigned char>(s[s.size() - n + i])) != suffix[i]) return false;
+    }
+    return true;
+}
+
+}
+
+// ==================== IMPORTER ====================
+BulkImporter::BulkImporter(Engine& engine) : engine(engine) {}
+
+ImportReport BulkImporter::run(const std::string& path, const ImportOptions& options) {
+    ImportReport report;
+    auto started = std::chrono::steady_clock::now();
+
+    if (engine.wal) {
+        report.fatalError = "Cannot bulk import while durable storage is open";
+        return report;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        report.fatalError = "Cannot open import file: " + path;
+        return report;
+    }
+
+    bool csv = options.format == ImportFormat::CSV ||
+               (options.format == ImportFormat::AUTO && hasSuffix(path, ".csv"));
+    const char* data = file.data();
+    size_t size = file.size();
+    size_t start = 0;
+    size_t lineBase = 1;
+
+    // CSV header: map each column to a known field
+    std::vector<int> headerColumns;
+    if (csv) {
+        std::vector<std::string> header;
+        size_t fieldCount = 0, newlines = 0;
+        std::string error;
+        const char* p = data;
+        if (size >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;  // UTF-8 BOM
+        if (!readCsvRecord(p, data + size, header, fieldCount, newlines, error)) {
+            report.fatalError = "Bad CSV header: " + error;
+            return report;
+        }
+        for (size_t i = 0; i < fieldCount; i++) headerColumns.push_back(columnFor(header[i]));
+        if (std::find(headerColumns.begin(), headerColumns.end(), COL_TYPE) == headerColumns.end()) {
+            report.fatalError = "CSV header has no 'type' column";
+            return report;
+        }
+        start = p - data;
+        lineBase += newlines;
+    }
+
+    std::vector<Chunk> chunks = splitChunks(data, start, size, options.chunkBytes, csv);
+    unsigned workerCount = options.workers ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = static_cast<unsigned>(std::min<size_t>(workerCount, std::max<size_t>(chunks.size(), 1)));
+    const size_t maxInFlight = workerCount * 2;
+
+    // Workers claim chunks in order but never run more than maxInFlight ahead
+    // of the writer, which bounds memory on huge files
+    std::vector<std::unique_ptr<Batch>> results(chunks.size());
+    std::atomic<size_t> nextChunk{0};
+    std::mutex mutex;
+    std::condition_variable batchReady;
+    std::condition_variable writerAdvanced;
+    size_t writeIndex = 0;
+    bool aborted = false;
+
+    auto worker = [&]() {
+        while (true) {
+            size_t index = nextChunk.fetch_add(1);
+            if (index >= chunks.size()) return;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                writerAdvanced.wait(lock, [&] { return aborted || index < writeIndex + maxInFlight; });
+                if (aborted) return;
+            }
+
+            auto batch = std::make_unique<Batch>();
+            const Chunk& chunk = chunks[index];
+            batch->bytes = chunk.end - chunk.begin;
+            try {
+                if (csv) {
+                    parseCsvChunk(data + chunk.begin, data + chunk.end, headerColumns, options.maxErrors, *batch);
+                } else {
+                    parseNdjsonChunk(data + chunk.begin, data + chunk.end, options.maxErrors, *batch);
+                }
+            } catch (const std::exception& e) {
+                batch->fatalError = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            results[index] = std::move(batch);
+            batchReady.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < workerCount; i++) workers.emplace_back(worker);
+
+    auto keepError = [&](size_t line, std::string message) {
+        report.rowsFailed++;
+        if (report.errors.size() < options.maxErrors) report.errors.push_back({line, std::move(message)});
+    };
+
+    std::vector<LinkRow> links;
+    size_t bytesProcessed = start;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        std::unique_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            batchReady.wait(lock, [&] { return results[i] != nullptr; });
+            batch = std::move(results[i]);
+        }
+
+        if (!batch->fatalError.empty()) {
+            report.fatalError = batch->fatalError;
+            break;
+        }
+
+        // Single writer: everything below touches the engine
+        engine.caseTitleIndex.reserve(engine.caseTitleIndex.size() + batch->cases.size());
+        engine.suspectNameIndex.reserve(engine.suspectNameIndex.size() + batch->suspects.size());
+
+        for (auto& row : batch->cases) {
+            Case c(row.id > 0 ? row.id : engine.nextCaseId, row.title, row.description);
+            if (!row.location.empty()) c.setLocation(row.location);
+            c.setStatus(row.status);
+            c.setPriority(row.priority);
+            for (const auto& item : row.evidence) c.addEvidence(item);
+            for (const auto& tag : row.tags) c.addTag(tag);
+            if (engine.insertCase(c)) report.casesImported++;
+            else keepError(lineBase + row.line, "Duplicate case: " + row.title);
+        }
+        for (auto& row : batch->suspects) {
+            Suspect s(row.id > 0 ? row.id : engine.nextSuspectId, row.name, row.story,
+                      row.background, row.age, row.occupation);
+            if (!row.motive.empty()) s.setMotive(row.motive);
+            if (!row.alibi.empty()) s.setAlibi(row.alibi);
+            if (row.hasStatus) s.setStatus(row.status);
+            if (engine.insertSuspect(s)) report.suspectsImported++;
+            else keepError(lineBase + row.line, "Duplicate suspect: " + row.name);
+        }
+        for (auto& row : batch->characters) {
+            Character ch(row.id > 0 ? row.id : engine.nextCharacterId, row.name, row.role, row.story);
+            if (engine.insertCharacter(ch)) report.charactersImported++;
+            else keepError(lineBase + row.line, "Duplicate character: " + row.name);
+        }
+        for (auto& row : batch->links) {
+            row.line += lineBase;
+            links.push_back(std::move(row));
+        }
+        for (auto& error : batch->errors) {
+            if (report.errors.size() < options.maxErrors) {
+                report.errors.push_back({lineBase + error.line, std::move(error.message)});
+            }
+        }
+
+        report.rowsProcessed += batch->rows;
+        report.rowsFailed += batch->failed;
+        lineBase += batch->lines;
+        bytesProcessed += batch->bytes;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writeIndex = i + 1;
+        }
+        writerAdvanced.notify_all();
+
+        if (options.onProgress) {
+            options.onProgress({bytesProcessed, size, report.rowsProcessed, report.rowsFailed});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        aborted = true;
+    }
+    writerAdvanced.notify_all();
+    for (auto& t : workers) t.join();
+
+    // Links last, once every entity they may name exists
+    const std::string suspectLink = Engine::SUSPECT_LINK;
+    const std::string characterLink = Engine::CHARACTER_LINK;
+    for (const auto& link : links) {
+        Case* casePtr = engine.findCase(link.to);
+        const std::string* caseName = &link.to;
+        const std::string* otherName = &link.from;
+        if (!casePtr) {
+            casePtr = engine.findCase(link.from);
+            caseName = &link.from;
+            otherName = &link.to;
+        }
+
+        Suspect* suspect = casePtr ? engine.findSuspect(*otherName) : nullptr;
+        Character* character = casePtr && !suspect ? engine.findCharacter(*otherName) : nullptr;
+        const std::string* type = &link.relation;
+        if (suspect) {
+            suspect->addCase(casePtr->getId());
+            casePtr->addSuspect(suspect->getId());
+            type = &suspectLink;
+        } else if (character) {
+            character->addCase(casePtr->getId());
+            casePtr->addCharacter(character->getId());
+            type = &characterLink;
+        } else {
+            bool fromExists = engine.findCase(link.from) || engine.findSuspect(link.from) || engine.findCharacter(link.from);
+            bool toExists = engine.findCase(link.to) || engine.findSuspect(link.to) || engine.findCharacter(link.to);
+            if (!fromExists || !toExists) {
+                keepError(link.line, "Link references unknown entity: " + (fromExists ? link.to : link.from));
+                continue;
+            }
+            caseName = &link.from;
+            otherName = &link.to;
+        }
+
+        if (!engine.relationshipGraph.addEdge(*caseName, *otherName, *type)) {
+            keepError(link.line, "Too many relationship types: " + *type);
+            continue;
+        }
+        engine.relationshipGraph.addEdge(*otherName, *caseName, *type);
+        report.linksImported++;
+    }
+
+    report.ok = report.fatalError.empty();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::string failed = report.rowsFailed > 0 ? " (" + std::to_string(report.rowsFailed) + " rows failed)" : "";
+    if (report.ok) {
+        LOG_INFO("✅ Bulk import " << path << ": " << report.casesImported << " cases, "
+                 << report.suspectsImported << " suspects, " << report.charactersImported << " characters, "
+                 << report.linksImported << " links" << failed << " in " << report.seconds << "s");
+    } else {
+        LOG_ERROR("❌ Bulk import " << path << " failed: " << report.fatalError << failed);
+    }
+    return report;
+}
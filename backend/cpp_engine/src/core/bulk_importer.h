@@ -0,0 +1,76 @@
+#ifndef BULK_IMPORTER_H
+#define BULK_IMPORTER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Engine;
+
+// Native bulk loader for CSV and NDJSON exports.
+//
+// Every record carries a "type" of case, suspect, character or link. CSV files
+// start with a header row naming the columns; NDJSON has one flat JSON object
+// per line. Recognised fields:
+//   case:      id, title, description, location, status, priority, evidence, tags
+//   suspect:   id, name, background, story, age, occupation, motive, alibi, status
+//   character: id, name, role, story
+//   link:      from, to, relation
+// Enum fields accept the numeric value, the enum name or the display string.
+// List fields are ';'-separated in CSV and may be JSON arrays in NDJSON.
+//
+// The file is mapped and cut into chunks on record boundaries. Worker threads
+// parse chunks into typed batches; the calling thread is the only writer and
+// applies batches in file order, so "first record wins" on duplicates no
+// matter how many workers run. Links are applied once all entities exist.
+
+enum class ImportFormat {
+    AUTO,       // by extension: .csv, otherwise NDJSON
+    CSV,
+    NDJSON
+};
+
+struct ImportError {
+    size_t line;
+    std::string message;
+};
+
+struct ImportProgress {
+    size_t bytesProcessed;
+    size_t totalBytes;
+    size_t rowsProcessed;
+    size_t rowsFailed;
+};
+
+struct ImportOptions {
+    ImportFormat format = ImportFormat::AUTO;
+    unsigned workers = 0;                   // 0 = hardware concurrency
+    size_t chunkBytes = 4 << 20;
+    size_t maxErrors = 1000;                // errors kept in the report; all are counted
+    std::function<void(const ImportProgress&)> onProgress;
+};
+
+struct ImportReport {
+    bool ok = false;
+    std::string fatalError;
+    size_t rowsProcessed = 0;
+    size_t rowsFailed = 0;
+    size_t casesImported = 0;
+    size_t suspectsImported = 0;
+    size_t charactersImported = 0;
+    size_t linksImported = 0;
+    double seconds = 0.0;
+    std::vector<ImportError> errors;
+};
+
+class BulkImporter {
+private:
+    Engine& engine;
+
+public:
+    explicit BulkImporter(Engine& engine);
+    ImportReport run(const std::string& path, const ImportOptions& options);
+};
+
+#endif // BULK_IMPORTER_H
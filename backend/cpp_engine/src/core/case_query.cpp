@@ -0,0 +1,115 @@
+#include "case_query.h"
+#include "engine.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+CaseQuery::CaseQuery(Engine* engine)
+    : engine(engine), unsolvedOnly(false), hasMinPriority(false), minPriority(CasePriority::LOW),
+      minId(INT_MIN), maxId(INT_MAX), joinsSuspects(false), minSuspicion(0.0), maxSuspicion(100.0),
+      order(CaseOrder::TITLE), descending(false), skip(0), take(SIZE_MAX) {}
+
+CaseQuery& CaseQuery::where(std::function<bool(const Case&)> predicate) {
+    casePredicates.push_back(std::move(predicate));
+    return *this;
+}
+
+CaseQuery& CaseQuery::whereStatus(CaseStatus status) {
+    statuses.push_back(status);
+    return *this;
+}
+
+CaseQuery& CaseQuery::whereUnsolved() {
+    unsolvedOnly = true;
+    return *this;
+}
+
+CaseQuery& CaseQuery::whereMinPriority(CasePriority priority) {
+    hasMinPriority = true;
+    minPriority = priority;
+    return *this;
+}
+
+CaseQuery& CaseQuery::whereTitleFrom(const std::string& title) {
+    titleFrom = title;
+    return *this;
+}
+
+CaseQuery& CaseQuery::whereIdRange(int minId, int maxId) {
+    this->minId = minId;
+    this->maxId = maxId;
+    return *this;
+}
+
+CaseQuery& CaseQuery::joinSuspects(double minSuspicion, double maxSuspicion) {
+    joinsSuspects = true;
+    this->minSuspicion = minSuspicion;
+    this->maxSuspicion = maxSuspicion;
+    return *this;
+}
+
+CaseQuery& CaseQuery::joinSuspectStatus(SuspectStatus status) {
+    joinsSuspects = true;
+    suspectStatuses.push_back(status);
+    return *this;
+}
+
+CaseQuery& CaseQuery::joinSuspectNamed(const std::string& name) {
+    joinsSuspects = true;
+    suspectName = name;
+    return *this;
+}
+
+CaseQuery& CaseQuery::joinSuspectsWhere(std::function<bool(const Suspect&)> predicate) {
+    joinsSuspects = true;
+    suspectPredicates.push_back(std::move(predicate));
+    return *this;
+}
+
+CaseQuery& CaseQuery::orderBy(CaseOrder order, bool descending) {
+    this->order = order;
+    this->descending = descending;
+    return *this;
+}
+
+CaseQuery& CaseQuery::offset(size_t count) {
+    skip = count;
+    return *this;
+}
+
+CaseQuery& CaseQuery::limit(size_t count) {
+    take = count;
+    return *this;
+}
+
+std::vector<Case*> CaseQuery::run() const {
+    return engine->runQuery(*this);
+}
+
+bool CaseQuery::matchesCase(const Case& c) const {
+    if (c.getId() < minId || c.getId() > maxId) return false;
+    if (unsolvedOnly && c.getStatus() == CaseStatus::SOLVED) return false;
+    if (!statuses.empty() && std::find(statuses.begin(), statuses.end(), c.getStatus()) == statuses.end()) {
+        return false;
+    }
+    if (hasMinPriority && c.getPriority() < minPriority) return false;
+    if (!titleFrom.empty() && c < std::string_view(titleFrom)) return false;
+    for (const auto& predicate : casePredicates) {
+        if (!predicate(c)) return false;
+    }
+    return true;
+}
+
+bool CaseQuery::matchesSuspect(const Suspect& s) const {
+    double level = s.getSuspicionLevel();
+    if (level < minSuspicion || level > maxSuspicion) return false;
+    if (!suspectStatuses.empty() &&
+        std::find(suspectStatuses.begin(), suspectStatuses.end(), s.getStatus()) == suspectStatuses.end()) {
+        return false;
+    }
+    if (!suspectName.empty() && s.getName() != suspectName) return false;
+    for (const auto& predicate : suspectPredicates) {
+        if (!predicate(s)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,84 @@
+#ifndef CASE_QUERY_H
+#define CASE_QUERY_H
+
+#include "../models/case.h"
+#include "../models/suspect.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Engine;
+
+// Sort keys for case queries
+enum class CaseOrder {
+    TITLE,
+    ID,
+    PRIORITY,
+    MAX_SUSPICION   // highest suspicion among the case's joined suspects
+};
+
+// Filter over cases, optionally joined to their linked suspects.
+//
+// The builder only records the query; run() picks where to start from the
+// engine's indices (a named suspect's case links, the ID map, or the title
+// order), streams candidates through the filters and keeps just the
+// requested page. When the order matches the index it started from, it
+// stops as soon as the page is full.
+class CaseQuery {
+private:
+    friend class Engine;
+
+    Engine* engine;
+
+    // Case filters
+    std::vector<CaseStatus> statuses;       // any of these; empty means all
+    bool unsolvedOnly;
+    bool hasMinPriority;
+    CasePriority minPriority;
+    std::string titleFrom;                  // titles >= this
+    int minId;
+    int maxId;
+    std::vector<std::function<bool(const Case&)>> casePredicates;
+
+    // Join: at least one linked suspect must pass all of these
+    bool joinsSuspects;
+    double minSuspicion;
+    double maxSuspicion;
+    std::vector<SuspectStatus> suspectStatuses;
+    std::string suspectName;
+    std::vector<std::function<bool(const Suspect&)>> suspectPredicates;
+
+    CaseOrder order;
+    bool descending;
+    size_t skip;
+    size_t take;
+
+public:
+    explicit CaseQuery(Engine* engine);
+
+    CaseQuery& where(std::function<bool(const Case&)> predicate);
+    CaseQuery& whereStatus(CaseStatus status);      // repeat to allow several
+    CaseQuery& whereUnsolved();
+    CaseQuery& whereMinPriority(CasePriority priority);
+    CaseQuery& whereTitleFrom(const std::string& title);
+    CaseQuery& whereIdRange(int minId, int maxId);
+
+    CaseQuery& joinSuspects(double minSuspicion = 0.0, double maxSuspicion = 100.0);
+    CaseQuery& joinSuspectStatus(SuspectStatus status);
+    CaseQuery& joinSuspectNamed(const std::string& name);
+    CaseQuery& joinSuspectsWhere(std::function<bool(const Suspect&)> predicate);
+
+    CaseQuery& orderBy(CaseOrder order, bool descending = false);
+    CaseQuery& offset(size_t count);
+    CaseQuery& limit(size_t count);
+
+    std::vector<Case*> run() const;
+
+    // Used by the engine while running the query
+    bool matchesCase(const Case& c) const;
+    bool matchesSuspect(const Suspect& s) const;
+};
+
+#endif // CASE_QUERY_H
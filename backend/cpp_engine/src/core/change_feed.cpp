@@ -0,0 +1,54 @@
+#include "change_feed.h"
+#include <algorithm>
+#include <random>
+
+ChangeFeed::ChangeFeed(size_t capacity)
+    : ring(std::max<size_t>(capacity, 1)), head(0), count(0), version(0), floor(0) {
+    // Kept to 31 bits so it survives a round trip through a JavaScript number
+    epoch = std::random_device{}() & 0x7fffffffu;
+}
+
+uint64_t ChangeFeed::record(ChangeEntity entity, int id, ChangeOp op) {
+    ring[head] = {++version, entity, id, op};
+    head = (head + 1) % ring.size();
+    if (count < ring.size()) count++;
+    return version;
+}
+
+uint64_t ChangeFeed::reset() {
+    head = 0;
+    count = 0;
+    floor = ++version;
+    return version;
+}
+
+ChangeSet ChangeFeed::since(uint64_t clientVersion) const {
+    ChangeSet result{epoch, version, false, {}};
+    if (clientVersion == version) return result;
+
+    // Ahead of us means the version came from somewhere else; behind the
+    // oldest retained event means some changes are gone
+    uint64_t oldest = std::max(floor, version - count);
+    if (clientVersion > version || clientVersion < oldest) {
+        result.fullSync = true;
+        return result;
+    }
+
+    size_t wanted = static_cast<size_t>(version - clientVersion);
+    result.events.reserve(wanted);
+    size_t start = (head + ring.size() - wanted) % ring.size();
+    for (size_t i = 0; i < wanted; i++) result.events.push_back(ring[(start + i) % ring.size()]);
+    return result;
+}
+
+uint64_t ChangeFeed::getVersion() const {
+    return version;
+}
+
+uint32_t ChangeFeed::getEpoch() const {
+    return epoch;
+}
+
+size_t ChangeFeed::getCapacity() const {
+    return ring.size();
+}
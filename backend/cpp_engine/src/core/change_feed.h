@@ -0,0 +1,64 @@
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Recent engine mutations, so clients can fetch deltas instead of everything.
+//
+// Every recorded change bumps the version by one and lands in a fixed-size
+// ring, so the events still held always cover (version - size, version].
+// A client that asks for anything older has fallen off the ring and has to
+// resync in full. The epoch is picked per engine instance; a client holding
+// a version from a different epoch (the server restarted) resyncs as well.
+
+enum class ChangeEntity : uint8_t {
+    CASE,
+    SUSPECT,
+    CHARACTER
+};
+
+enum class ChangeOp : uint8_t {
+    CREATED,
+    UPDATED,
+    REMOVED
+};
+
+struct ChangeEvent {
+    uint64_t version;
+    ChangeEntity entity;
+    int id;
+    ChangeOp op;
+};
+
+struct ChangeSet {
+    uint32_t epoch;
+    uint64_t version;       // current version; pass it to the next changesSince
+    bool fullSync;          // events were dropped, refetch everything
+    std::vector<ChangeEvent> events;    // oldest first
+};
+
+class ChangeFeed {
+private:
+    std::vector<ChangeEvent> ring;
+    size_t head;            // next slot to write
+    size_t count;
+    uint64_t version;
+    uint64_t floor;         // nothing at or below this can be replayed
+    uint32_t epoch;
+
+public:
+    explicit ChangeFeed(size_t capacity = 4096);
+
+    uint64_t record(ChangeEntity entity, int id, ChangeOp op);
+    // For bulk changes: bumps the version and forces every client to resync
+    uint64_t reset();
+
+    ChangeSet since(uint64_t clientVersion) const;
+    uint64_t getVersion() const;
+    uint32_t getEpoch() const;
+    size_t getCapacity() const;
+};
+
+#endif // CHANGE_FEED_H
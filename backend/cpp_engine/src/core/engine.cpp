@@ -1,29 +1,45 @@
 #include "engine.h"
+#include "snapshot.h"
+#include "mapped_file.h"
+#include "logger.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
-#include <queue>
+#include <tuple>
+#include <filesystem>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+
+namespace {
+    const char* const SNAPSHOT_FILE = "snapshot.bin";
+}
 
-Engine::Engine() : nextCaseId(1), nextSuspectId(1), nextCharacterId(1) {
-    std::cout << "🔍 Detective Engine Initialized\n";
+Engine::Engine() : pendingCount(0), nextCaseId(1), nextSuspectId(1), nextCharacterId(1),
+                   appliedLsn(0), replaying(false), compacting(false), entityGeneration(0) {
+    LOG_INFO("🔍 Detective Engine Initialized");
 }
 
 Engine::~Engine() {
-    std::cout << "🔍 Detective Engine Shutdown\n";
+    closeDurable();
+    LOG_INFO("🔍 Detective Engine Shutdown");
 }
 
 // ==================== CASE MANAGEMENT ====================
 bool Engine::addCase(const std::string& title, const std::string& description, 
                      CaseStatus status, CasePriority priority) {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::ADD_CASE);
+    if (!logHealthy()) return false;
     if (title.empty() || description.empty()) {
-        std::cout << "❌ Cannot add case: Title and description cannot be empty\n";
+        LOG_WARNING("❌ Cannot add case: Title and description cannot be empty");
         return false;
     }
 
     if (caseTitleIndex.find(title) != caseTitleIndex.end()) {
-        std::cout << "❌ Case already exists: " << title << "\n";
+        LOG_WARNING("❌ Case already exists: " << title);
         return false;
     }
 
@@ -31,24 +47,31 @@ bool Engine::addCase(const std::string& title, const std::string& description,
     newCase.setStatus(status);
     newCase.setPriority(priority);
     
-    cases.insert(newCase);
-    Case* inserted = cases.search(newCase);
+    cases.insert(std::move(newCase));
+    Case* inserted = cases.findKey(std::string_view(title));
     
     if (inserted) {
         addToIndices(inserted);
         autoConnectEntities(inserted);
-        std::cout << "✅ Case added: " << title << " (ID: " << inserted->getId() << ")\n";
+        if (!logMutation(WalOp::ADD_CASE, WalPayloadWriter().putString(title).putString(description)
+                                             .putInt(static_cast<int>(status)).putInt(static_cast<int>(priority)))) {
+            return false;
+        }
+        changes.record(ChangeEntity::CASE, inserted->getId(), ChangeOp::CREATED);
+        LOG_INFO("✅ Case added: " << title << " (ID: " << inserted->getId() << ")");
         return true;
     }
     
-    std::cout << "❌ Failed to add case: " << title << "\n";
+    LOG_WARNING("❌ Failed to add case: " << title);
     return false;
 }
 
 bool Engine::removeCase(const std::string& title) {
+    loadPendingSnapshot();
+    if (!logHealthy()) return false;
     auto it = caseTitleIndex.find(title);
     if (it == caseTitleIndex.end()) {
-        std::cout << "❌ Case not found: " << title << "\n";
+        LOG_WARNING("❌ Case not found: " << title);
         return false;
     }
 
@@ -56,7 +79,7 @@ bool Engine::removeCase(const std::string& title) {
     int caseId = casePtr->getId();
     
     // Remove from data structure
-    cases.remove(*casePtr);
+    cases.removeKey(std::string_view(title));
     
     // Remove from indices
     caseTitleIndex.erase(title);
@@ -64,46 +87,56 @@ bool Engine::removeCase(const std::string& title) {
     
     // Remove from graph
     relationshipGraph.removeNode(title);
+    if (!logMutation(WalOp::REMOVE_CASE, WalPayloadWriter().putString(title))) return false;
+    changes.record(ChangeEntity::CASE, caseId, ChangeOp::REMOVED);
     
-    std::cout << "✅ Case removed: " << title << "\n";
+    LOG_INFO("✅ Case removed: " << title);
     return true;
 }
 
 Case* Engine::findCase(const std::string& title) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::FIND_CASE);
     auto it = caseTitleIndex.find(title);
-    return it != caseTitleIndex.end() ? it->second : nullptr;
+    if (it != caseTitleIndex.end()) return it->second;
+    return pendingSnapshot ? loadPendingCase(title) : nullptr;
 }
 
 Case* Engine::findCaseById(int id) {
+    loadPendingSnapshot();
     auto it = caseIdIndex.find(id);
     return it != caseIdIndex.end() ? it->second : nullptr;
 }
 
 std::vector<Case*> Engine::getAllCases() {
+    loadPendingSnapshot();
     std::vector<Case*> result;
-    cases.inOrderTraversal([&](Case* c) { result.push_back(c); });
+    cases.forEach([&](Case* c) { result.push_back(c); });
     return result;
 }
 
 std::vector<Case*> Engine::findCasesByStatus(CaseStatus status) {
+    loadPendingSnapshot();
     std::vector<Case*> result;
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         if (c->getStatus() == status) result.push_back(c);
     });
     return result;
 }
 
 std::vector<Case*> Engine::findCasesByPriority(CasePriority priority) {
+    loadPendingSnapshot();
     std::vector<Case*> result;
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         if (c->getPriority() == priority) result.push_back(c);
     });
     return result;
 }
 
 std::vector<Case*> Engine::searchCases(const std::string& keyword) {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::SEARCH_CASES);
     std::vector<Case*> result;
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         if (c->getTitle().find(keyword) != std::string::npos ||
             c->getDescription().find(keyword) != std::string::npos) {
             result.push_back(c);
@@ -112,87 +145,112 @@ std::vector<Case*> Engine::searchCases(const std::string& keyword) {
     return result;
 }
 
+std::vector<Case*> Engine::listCases(const std::string& after, size_t limit, ListOrder order) {
+    loadPendingSnapshot();
+    if (order == ListOrder::ID) return pageById(caseIdIndex, after, limit);
+
+    std::vector<Case*> result;
+    for (auto it = cases.upperBound(std::string_view(after)); it != cases.end() && result.size() < limit; ++it) {
+        result.push_back(&*it);
+    }
+    return result;
+}
+
 // ==================== SUSPECT MANAGEMENT ====================
 bool Engine::addSuspect(const std::string& name, const std::string& background, 
                         const std::string& story, int age, const std::string& occupation) {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::ADD_SUSPECT);
+    if (!logHealthy()) return false;
     if (name.empty()) {
-        std::cout << "❌ Cannot add suspect: Name cannot be empty\n";
+        LOG_WARNING("❌ Cannot add suspect: Name cannot be empty");
         return false;
     }
 
     if (suspectNameIndex.find(name) != suspectNameIndex.end()) {
-        std::cout << "❌ Suspect already exists: " << name << "\n";
+        LOG_WARNING("❌ Suspect already exists: " << name);
         return false;
     }
 
     Suspect newSuspect(nextSuspectId++, name, story, background, age, occupation);
-    suspects.insert(newSuspect);
-    Suspect* inserted = suspects.search(newSuspect);
+    suspects.insert(std::move(newSuspect));
+    Suspect* inserted = suspects.findKey(std::string_view(name));
     
     if (inserted) {
         addToIndices(inserted);
         autoConnectEntities(inserted);
-        std::cout << "✅ Suspect added: " << name << " (ID: " << inserted->getId() << ")\n";
+        if (!logMutation(WalOp::ADD_SUSPECT, WalPayloadWriter().putString(name).putString(background)
+                                                .putString(story).putInt(age).putString(occupation))) {
+            return false;
+        }
+        changes.record(ChangeEntity::SUSPECT, inserted->getId(), ChangeOp::CREATED);
+        LOG_INFO("✅ Suspect added: " << name << " (ID: " << inserted->getId() << ")");
         return true;
     }
     
-    std::cout << "❌ Failed to add suspect: " << name << "\n";
+    LOG_WARNING("❌ Failed to add suspect: " << name);
     return false;
 }
 
 bool Engine::removeSuspect(const std::string& name) {
+    loadPendingSnapshot();
+    if (!logHealthy()) return false;
     auto it = suspectNameIndex.find(name);
     if (it == suspectNameIndex.end()) {
-        std::cout << "❌ Suspect not found: " << name << "\n";
+        LOG_WARNING("❌ Suspect not found: " << name);
         return false;
     }
 
     Suspect* suspectPtr = it->second;
     int suspectId = suspectPtr->getId();
     
-    suspects.remove(*suspectPtr);
+    suspects.removeKey(std::string_view(name));
     suspectNameIndex.erase(name);
     suspectIdIndex.erase(suspectId);
     relationshipGraph.removeNode(name);
+    if (!logMutation(WalOp::REMOVE_SUSPECT, WalPayloadWriter().putString(name))) return false;
+    changes.record(ChangeEntity::SUSPECT, suspectId, ChangeOp::REMOVED);
     
-    std::cout << "✅ Suspect removed: " << name << "\n";
+    LOG_INFO("✅ Suspect removed: " << name);
     return true;
 }
 
 Suspect* Engine::findSuspect(const std::string& name) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::FIND_SUSPECT);
     auto it = suspectNameIndex.find(name);
-    return it != suspectNameIndex.end() ? it->second : nullptr;
+    if (it != suspectNameIndex.end()) return it->second;
+    return pendingSnapshot ? loadPendingSuspect(name) : nullptr;
 }
 
 Suspect* Engine::findSuspectById(int id) {
+    loadPendingSnapshot();
     auto it = suspectIdIndex.find(id);
     if (it != suspectIdIndex.end()) return it->second;
     
     // Fallback search
-    std::vector<Suspect*> all = getAllSuspects();
-    for (Suspect* s : all) {
-        if (s->getId() == id) return s;
-    }
-    return nullptr;
+    return suspects.searchByCriteria([id](const Suspect& s) { return s.getId() == id; });
 }
 
 std::vector<Suspect*> Engine::getAllSuspects() {
+    loadPendingSnapshot();
     std::vector<Suspect*> result;
-    suspects.inOrderTraversal([&](Suspect* s) { result.push_back(s); });
+    suspects.forEach([&](Suspect* s) { result.push_back(s); });
     return result;
 }
 
 std::vector<Suspect*> Engine::findSuspectsByStatus(SuspectStatus status) {
+    loadPendingSnapshot();
     std::vector<Suspect*> result;
-    suspects.inOrderTraversal([&](Suspect* s) {
+    suspects.forEach([&](Suspect* s) {
         if (s->getStatus() == status) result.push_back(s);
     });
     return result;
 }
 
 std::vector<Suspect*> Engine::findSuspectsBySuspicionRange(double minLevel, double maxLevel) {
+    loadPendingSnapshot();
     std::vector<Suspect*> result;
-    suspects.inOrderTraversal([&](Suspect* s) {
+    suspects.forEach([&](Suspect* s) {
         double level = s->getSuspicionLevel();
         if (level >= minLevel && level <= maxLevel) result.push_back(s);
     });
@@ -200,8 +258,10 @@ std::vector<Suspect*> Engine::findSuspectsBySuspicionRange(double minLevel, doub
 }
 
 std::vector<Suspect*> Engine::searchSuspects(const std::string& keyword) {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::SEARCH_SUSPECTS);
     std::vector<Suspect*> result;
-    suspects.inOrderTraversal([&](Suspect* s) {
+    suspects.forEach([&](Suspect* s) {
         if (s->getName().find(keyword) != std::string::npos ||
             s->getOccupation().find(keyword) != std::string::npos ||
             s->getBackground().find(keyword) != std::string::npos) {
@@ -211,140 +271,171 @@ std::vector<Suspect*> Engine::searchSuspects(const std::string& keyword) {
     return result;
 }
 
+std::vector<Suspect*> Engine::listSuspects(const std::string& after, size_t limit, ListOrder order) {
+    loadPendingSnapshot();
+    if (order == ListOrder::ID) return pageById(suspectIdIndex, after, limit);
+
+    std::vector<Suspect*> result;
+    for (auto it = suspects.upperBound(std::string_view(after)); it != suspects.end() && result.size() < limit; ++it) {
+        result.push_back(&*it);
+    }
+    return result;
+}
+
 // ==================== CHARACTER MANAGEMENT ====================
 bool Engine::addCharacter(const std::string& name, CharacterRole role, const std::string& story) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::ADD_CHARACTER);
+    if (!logHealthy()) return false;
     if (name.empty()) {
-        std::cout << "❌ Cannot add character: Name cannot be empty\n";
+        LOG_WARNING("❌ Cannot add character: Name cannot be empty");
         return false;
     }
 
     if (characterNameIndex.find(name) != characterNameIndex.end()) {
-        std::cout << "❌ Character already exists: " << name << "\n";
+        LOG_WARNING("❌ Character already exists: " << name);
         return false;
     }
 
-    Character newCharacter(nextCharacterId++, name, role, story);
-    characters.insertAtEnd(newCharacter);
-    
-    // Get the inserted character using traversal
-    Character* inserted = nullptr;
-    characters.traverse([&](Character& ch) {
-        if (ch.getId() == newCharacter.getId()) {
-            inserted = &ch;
-        }
-    });
+    SlotKey key = characters.insert(Character(nextCharacterId++, name, role, story));
+    Character* inserted = characters.get(key);
     
     if (inserted) {
-        addToIndices(inserted);
+        addToIndices(key);
         autoConnectEntities(inserted);
-        std::cout << "✅ Character added: " << name << " (Role: " << CharacterUtils::roleToString(role) << ")\n";
+        if (!logMutation(WalOp::ADD_CHARACTER, WalPayloadWriter().putString(name)
+                                                  .putInt(static_cast<int>(role)).putString(story))) {
+            return false;
+        }
+        changes.record(ChangeEntity::CHARACTER, inserted->getId(), ChangeOp::CREATED);
+        LOG_INFO("✅ Character added: " << name << " (Role: " << CharacterUtils::roleToString(role) << ")");
         return true;
     }
     
-    std::cout << "❌ Failed to add character: " << name << "\n";
+    LOG_WARNING("❌ Failed to add character: " << name);
     return false;
 }
 
 bool Engine::removeCharacter(const std::string& name) {
+    if (!logHealthy()) return false;
     auto it = characterNameIndex.find(name);
     if (it == characterNameIndex.end()) {
-        std::cout << "❌ Character not found: " << name << "\n";
+        LOG_WARNING("❌ Character not found: " << name);
         return false;
     }
 
-    Character* characterPtr = it->second;
-    
-    // Find and remove from linked list
-    bool removed = false;
-    characters.traverse([&](Character& ch) {
-        if (ch.getName() == name) {
-            characters.deleteNode(ch);
-            removed = true;
-        }
-    });
+    const Character* existing = characters.get(it->second);
+    int characterId = existing ? existing->getId() : -1;
 
-    if (removed) {
-        characterNameIndex.erase(name);
-        characterIdIndex.erase(characterPtr->getId());
+    if (existing && characters.erase(it->second)) {
+        characterNameOrder.erase(std::string_view(it->first));
+        characterNameIndex.erase(it);
+        characterIdIndex.erase(characterId);
         relationshipGraph.removeNode(name);
-        std::cout << "✅ Character removed: " << name << "\n";
+        if (!logMutation(WalOp::REMOVE_CHARACTER, WalPayloadWriter().putString(name))) return false;
+        changes.record(ChangeEntity::CHARACTER, characterId, ChangeOp::REMOVED);
+        LOG_INFO("✅ Character removed: " << name);
         return true;
     }
     
-    std::cout << "❌ Failed to remove character: " << name << "\n";
+    LOG_WARNING("❌ Failed to remove character: " << name);
     return false;
 }
 
 Character* Engine::findCharacter(const std::string& name) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::FIND_CHARACTER);
     auto it = characterNameIndex.find(name);
-    return it != characterNameIndex.end() ? it->second : nullptr;
+    return it != characterNameIndex.end() ? characters.get(it->second) : nullptr;
 }
 
 Character* Engine::findCharacterById(int id) {
     auto it = characterIdIndex.find(id);
-    if (it != characterIdIndex.end()) return it->second;
+    if (it != characterIdIndex.end()) return characters.get(it->second);
     
     // Fallback search
-    Character* found = nullptr;
-    characters.traverse([&](Character& ch) {
-        if (ch.getId() == id) {
-            found = &ch;
-        }
-    });
-    return found;
+    for (Character& ch : characters) {
+        if (ch.getId() == id) return &ch;
+    }
+    return nullptr;
 }
 
 std::vector<Character*> Engine::getAllCharacters() {
     std::vector<Character*> result;
-    characters.traverse([&](Character& ch) { result.push_back(&ch); });
+    result.reserve(characters.size());
+    for (Character& ch : characters) result.push_back(&ch);
     return result;
 }
 
 std::vector<Character*> Engine::findCharactersByRole(CharacterRole role) {
     std::vector<Character*> result;
-    characters.traverse([&](Character& ch) {
+    for (Character& ch : characters) {
         if (ch.getRole() == role) result.push_back(&ch);
-    });
+    }
     return result;
 }
 
 std::vector<Character*> Engine::searchCharacters(const std::string& keyword) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::SEARCH_CHARACTERS);
     std::vector<Character*> result;
-    characters.traverse([&](Character& ch) {
+    for (Character& ch : characters) {
         if (ch.getName().find(keyword) != std::string::npos ||
             ch.getRoleString().find(keyword) != std::string::npos ||
             ch.getStory().find(keyword) != std::string::npos) {
             result.push_back(&ch);
         }
-    });
+    }
+    return result;
+}
+
+std::vector<Character*> Engine::listCharacters(const std::string& after, size_t limit, ListOrder order) {
+    std::vector<Character*> result;
+    if (order == ListOrder::ID) {
+        int afterId = 0;
+        if (!after.empty()) std::from_chars(after.data(), after.data() + after.size(), afterId);
+        for (auto it = characterIdIndex.upper_bound(afterId); it != characterIdIndex.end() && result.size() < limit; ++it) {
+            result.push_back(characters.get(it->second));
+        }
+        return result;
+    }
+
+    auto it = characterNameOrder.upper_bound(std::string_view(after));
+    for (; it != characterNameOrder.end() && result.size() < limit; ++it) {
+        result.push_back(characters.get(it->second));
+    }
     return result;
 }
 
 // ==================== RELATIONSHIP MANAGEMENT ====================
 bool Engine::linkSuspectToCase(const std::string& suspectName, const std::string& caseTitle) {
+    if (!logHealthy()) return false;
     Suspect* suspect = findSuspect(suspectName);
     Case* casePtr = findCase(caseTitle);
     
     if (!suspect || !casePtr) {
-        std::cout << "❌ Cannot link: Suspect or case not found\n";
+        LOG_WARNING("❌ Cannot link: Suspect or case not found");
         return false;
     }
 
     suspect->addCase(casePtr->getId());
     casePtr->addSuspect(suspect->getId());
-    relationshipGraph.addEdge(caseTitle, suspectName);
-    relationshipGraph.addEdge(suspectName, caseTitle);
+    relationshipGraph.addEdge(caseTitle, suspectName, SUSPECT_LINK);
+    relationshipGraph.addEdge(suspectName, caseTitle, SUSPECT_LINK);
+    if (!logMutation(WalOp::LINK_SUSPECT, WalPayloadWriter().putString(suspectName).putString(caseTitle))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+    changes.record(ChangeEntity::SUSPECT, suspect->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Linked suspect " << suspectName << " to case " << caseTitle << "\n";
+    LOG_INFO("✅ Linked suspect " << suspectName << " to case " << caseTitle);
     return true;
 }
 
 bool Engine::unlinkSuspectFromCase(const std::string& suspectName, const std::string& caseTitle) {
+    if (!logHealthy()) return false;
     Suspect* suspect = findSuspect(suspectName);
     Case* casePtr = findCase(caseTitle);
     
     if (!suspect || !casePtr) {
-        std::cout << "❌ Cannot unlink: Suspect or case not found\n";
+        LOG_WARNING("❌ Cannot unlink: Suspect or case not found");
         return false;
     }
 
@@ -352,35 +443,47 @@ bool Engine::unlinkSuspectFromCase(const std::string& suspectName, const std::st
     casePtr->removeSuspect(suspect->getId());
     relationshipGraph.removeEdge(caseTitle, suspectName);
     relationshipGraph.removeEdge(suspectName, caseTitle);
+    if (!logMutation(WalOp::UNLINK_SUSPECT, WalPayloadWriter().putString(suspectName).putString(caseTitle))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+    changes.record(ChangeEntity::SUSPECT, suspect->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Unlinked suspect " << suspectName << " from case " << caseTitle << "\n";
+    LOG_INFO("✅ Unlinked suspect " << suspectName << " from case " << caseTitle);
     return true;
 }
 
 bool Engine::linkCharacterToCase(const std::string& characterName, const std::string& caseTitle) {
+    if (!logHealthy()) return false;
     Character* character = findCharacter(characterName);
     Case* casePtr = findCase(caseTitle);
     
     if (!character || !casePtr) {
-        std::cout << "❌ Cannot link: Character or case not found\n";
+        LOG_WARNING("❌ Cannot link: Character or case not found");
         return false;
     }
 
     character->addCase(casePtr->getId());
     casePtr->addCharacter(character->getId());
-    relationshipGraph.addEdge(caseTitle, characterName);
-    relationshipGraph.addEdge(characterName, caseTitle);
+    relationshipGraph.addEdge(caseTitle, characterName, CHARACTER_LINK);
+    relationshipGraph.addEdge(characterName, caseTitle, CHARACTER_LINK);
+    if (!logMutation(WalOp::LINK_CHARACTER, WalPayloadWriter().putString(characterName).putString(caseTitle))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+    changes.record(ChangeEntity::CHARACTER, character->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Linked character " << characterName << " to case " << caseTitle << "\n";
+    LOG_INFO("✅ Linked character " << characterName << " to case " << caseTitle);
     return true;
 }
 
 bool Engine::unlinkCharacterFromCase(const std::string& characterName, const std::string& caseTitle) {
+    if (!logHealthy()) return false;
     Character* character = findCharacter(characterName);
     Case* casePtr = findCase(caseTitle);
     
     if (!character || !casePtr) {
-        std::cout << "❌ Cannot unlink: Character or case not found\n";
+        LOG_WARNING("❌ Cannot unlink: Character or case not found");
         return false;
     }
 
@@ -388,35 +491,62 @@ bool Engine::unlinkCharacterFromCase(const std::string& characterName, const std
     casePtr->removeCharacter(character->getId());
     relationshipGraph.removeEdge(caseTitle, characterName);
     relationshipGraph.removeEdge(characterName, caseTitle);
+    if (!logMutation(WalOp::UNLINK_CHARACTER, WalPayloadWriter().putString(characterName).putString(caseTitle))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+    changes.record(ChangeEntity::CHARACTER, character->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Unlinked character " << characterName << " from case " << caseTitle << "\n";
+    LOG_INFO("✅ Unlinked character " << characterName << " from case " << caseTitle);
     return true;
 }
 
 bool Engine::addRelationship(const std::string& entity1, const std::string& entity2, 
                              const std::string& relationshipType) {
+    if (!logHealthy()) return false;
     // Verify both entities exist
     bool entity1Exists = findCase(entity1) || findSuspect(entity1) || findCharacter(entity1);
     bool entity2Exists = findCase(entity2) || findSuspect(entity2) || findCharacter(entity2);
     
     if (!entity1Exists || !entity2Exists) {
-        std::cout << "❌ Cannot create relationship: One or both entities not found\n";
+        LOG_WARNING("❌ Cannot create relationship: One or both entities not found");
         return false;
     }
 
-    relationshipGraph.addEdge(entity1, entity2);
-    relationshipGraph.addEdge(entity2, entity1);
+    if (!relationshipGraph.addEdge(entity1, entity2, relationshipType)) {
+        LOG_WARNING("❌ Cannot create relationship: Too many relationship types (max "
+                    << Graph::MAX_EDGE_TYPES << ")");
+        return false;
+    }
+    relationshipGraph.addEdge(entity2, entity1, relationshipType);
+    if (!logMutation(WalOp::ADD_RELATIONSHIP, WalPayloadWriter().putString(entity1).putString(entity2)
+                                                 .putString(relationshipType))) {
+        return false;
+    }
+    recordChange(entity1, ChangeOp::UPDATED);
+    recordChange(entity2, ChangeOp::UPDATED);
     
-    std::cout << "✅ Created relationship: " << entity1 << " <-> " << entity2 
-              << " (" << relationshipType << ")\n";
+    LOG_INFO("✅ Created relationship: " << entity1 << " <-> " << entity2
+             << " (" << relationshipType << ")");
     return true;
 }
 
 bool Engine::removeRelationship(const std::string& entity1, const std::string& entity2) {
+    if (!logHealthy()) return false;
+    if (!relationshipGraph.hasEdge(entity1, entity2) && !relationshipGraph.hasEdge(entity2, entity1)) {
+        LOG_WARNING("❌ No relationship between " << entity1 << " and " << entity2);
+        return false;
+    }
+
     relationshipGraph.removeEdge(entity1, entity2);
     relationshipGraph.removeEdge(entity2, entity1);
+    if (!logMutation(WalOp::REMOVE_RELATIONSHIP, WalPayloadWriter().putString(entity1).putString(entity2))) {
+        return false;
+    }
+    recordChange(entity1, ChangeOp::UPDATED);
+    recordChange(entity2, ChangeOp::UPDATED);
     
-    std::cout << "✅ Removed relationship: " << entity1 << " -X- " << entity2 << "\n";
+    LOG_INFO("✅ Removed relationship: " << entity1 << " -X- " << entity2);
     return true;
 }
 
@@ -424,10 +554,60 @@ std::vector<std::string> Engine::getRelationships(const std::string& entity) {
     return relationshipGraph.getNeighbors(entity);
 }
 
+std::vector<std::string> Engine::getRelationships(const std::string& entity, const std::vector<std::string>& types) {
+    return relationshipGraph.getNeighbors(entity, edgeTypeMask(types));
+}
+
+std::string Engine::getRelationshipType(const std::string& entity1, const std::string& entity2) const {
+    return relationshipGraph.getEdgeType(entity1, entity2);
+}
+
+std::vector<std::string> Engine::getRelationshipTypes() const {
+    return relationshipGraph.getEdgeTypes();
+}
+
 std::vector<std::string> Engine::findPath(const std::string& from, const std::string& to) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::FIND_PATH);
     return relationshipGraph.shortestPath(from, to);
 }
 
+std::vector<std::string> Engine::findPath(const std::string& from, const std::string& to,
+                                          const std::vector<std::string>& types) {
+    MetricsRegistry::Timer timer(metrics, EngineOp::FIND_PATH);
+    return relationshipGraph.shortestPath(from, to, edgeTypeMask(types));
+}
+
+Graph::EdgeTypeMask Engine::edgeTypeMask(const std::vector<std::string>& types) const {
+    return types.empty() ? Graph::ALL_EDGE_TYPES : relationshipGraph.makeEdgeTypeMask(types);
+}
+
+bool Engine::sameComponent(const std::string& entity1, const std::string& entity2) const {
+    return relationshipGraph.sameComponent(entity1, entity2);
+}
+
+int Engine::getComponentSize(const std::string& entity) const {
+    return relationshipGraph.getComponentSize(entity);
+}
+
+int Engine::getComponentCount() const {
+    return relationshipGraph.getComponentCount();
+}
+
+WorkStealingPool& Engine::getAnalyticsPool() const {
+    if (!analyticsPool) analyticsPool = std::make_unique<WorkStealingPool>();
+    return *analyticsPool;
+}
+
+std::vector<std::pair<std::string, double>> Engine::getKeyEntities(int count, bool parallel) const {
+    if (count <= 0) return {};
+
+    CentralityOptions options;
+    options.mode = parallel ? ExecutionMode::PARALLEL : ExecutionMode::SERIAL;
+    auto ranked = GraphAnalytics(getAnalyticsPool()).rankByBetweenness(relationshipGraph, options);
+    if (ranked.size() > static_cast<size_t>(count)) ranked.resize(count);
+    return ranked;
+}
+
 // ==================== ANALYSIS & QUERIES ====================
 std::vector<Suspect*> Engine::getSuspectsForCase(const std::string& caseTitle) {
     Case* casePtr = findCase(caseTitle);
@@ -482,16 +662,18 @@ std::vector<Suspect*> Engine::getPrimeSuspects() {
 }
 
 std::vector<Case*> Engine::getUnsolvedCases() {
+    loadPendingSnapshot();
     std::vector<Case*> result;
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         if (c->getStatus() != CaseStatus::SOLVED) result.push_back(c);
     });
     return result;
 }
 
 std::vector<Case*> Engine::getHighPriorityCases() {
+    loadPendingSnapshot();
     std::vector<Case*> result;
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         if (c->getPriority() == CasePriority::HIGH || c->getPriority() == CasePriority::URGENT) {
             result.push_back(c);
         }
@@ -499,80 +681,196 @@ std::vector<Case*> Engine::getHighPriorityCases() {
     return result;
 }
 
+CaseQuery Engine::queryCases() {
+    return CaseQuery(this);
+}
+
+std::vector<Case*> Engine::runQuery(const CaseQuery& query) {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::QUERY_CASES);
+    std::vector<Case*> result;
+    if (query.take == 0) return result;
+    size_t wanted = query.take > SIZE_MAX - query.skip ? SIZE_MAX : query.skip + query.take;
+
+    // A named suspect is checked once; its case links then drive the scan
+    Suspect* named = nullptr;
+    if (!query.suspectName.empty()) {
+        named = findSuspect(query.suspectName);
+        if (!named || !query.matchesSuspect(*named)) return result;
+    }
+
+    // score is the highest suspicion among the joined suspects
+    struct Row {
+        Case* c;
+        double score;
+    };
+    auto before = [&query](const Row& a, const Row& b) {
+        int cmp = 0;
+        switch (query.order) {
+            case CaseOrder::ID:
+                cmp = (a.c->getId() > b.c->getId()) - (a.c->getId() < b.c->getId());
+                break;
+            case CaseOrder::PRIORITY:
+                cmp = static_cast<int>(a.c->getPriority()) - static_cast<int>(b.c->getPriority());
+                break;
+            case CaseOrder::MAX_SUSPICION:
+                cmp = (a.score > b.score) - (a.score < b.score);
+                break;
+            case CaseOrder::TITLE:
+                return query.descending ? *b.c < *a.c : *a.c < *b.c;
+        }
+        if (cmp != 0) return query.descending ? cmp > 0 : cmp < 0;
+        return *a.c < *b.c;     // ties by title keep pages stable
+    };
+
+    // Streamed sources already produce the requested order and stop at a
+    // full page; anything else keeps the best `wanted` rows on a heap
+    std::vector<Row> rows;
+    bool streamed = false;
+    auto offer = [&](Case* c) {
+        if (!query.matchesCase(*c)) return true;
+        Row row{c, 0.0};
+        if (named) {
+            row.score = named->getSuspicionLevel();
+        } else if (query.joinsSuspects) {
+            bool joined = false;
+            for (int suspectId : c->getSuspects()) {
+                auto it = suspectIdIndex.find(suspectId);
+                if (it == suspectIdIndex.end() || !query.matchesSuspect(*it->second)) continue;
+                joined = true;
+                row.score = std::max(row.score, it->second->getSuspicionLevel());
+            }
+            if (!joined) return true;
+        }
+
+        if (streamed) {
+            rows.push_back(row);
+            return rows.size() < wanted;
+        }
+        if (rows.size() < wanted) {
+            rows.push_back(row);
+            std::push_heap(rows.begin(), rows.end(), before);
+        } else if (before(row, rows.front())) {
+            std::pop_heap(rows.begin(), rows.end(), before);
+            rows.back() = row;
+            std::push_heap(rows.begin(), rows.end(), before);
+        }
+        return true;
+    };
+
+    bool byId = query.order == CaseOrder::ID && !query.descending;
+    if (named) {
+        std::vector<int> caseIds = named->getCases();
+        std::sort(caseIds.begin(), caseIds.end());
+        caseIds.erase(std::unique(caseIds.begin(), caseIds.end()), caseIds.end());
+        streamed = byId;
+        for (int caseId : caseIds) {
+            auto it = caseIdIndex.find(caseId);
+            if (it != caseIdIndex.end() && !offer(it->second)) break;
+        }
+    } else if (query.order == CaseOrder::ID || query.minId != INT_MIN || query.maxId != INT_MAX) {
+        streamed = byId;
+        for (auto it = caseIdIndex.lower_bound(query.minId); it != caseIdIndex.end() && it->first <= query.maxId; ++it) {
+            if (!offer(it->second)) break;
+        }
+    } else {
+        streamed = query.order == CaseOrder::TITLE && !query.descending;
+        for (auto it = cases.lowerBound(std::string_view(query.titleFrom)); it != cases.end(); ++it) {
+            if (!offer(&*it)) break;
+        }
+    }
+
+    if (!streamed) std::sort_heap(rows.begin(), rows.end(), before);
+    for (size_t i = query.skip; i < rows.size(); i++) result.push_back(rows[i].c);
+    return result;
+}
+
 void Engine::recalculateAllSuspicionLevels() {
-    suspects.inOrderTraversal([&](Suspect* s) {
+    loadPendingSnapshot();
+    if (!logHealthy()) return;
+    suspects.forEach([&](Suspect* s) {
         s->updateSuspicionLevel();
     });
-    std::cout << "✅ Recalculated suspicion levels for all suspects\n";
+    if (!logMutation(WalOp::RECALCULATE_SUSPICION, WalPayloadWriter())) return;
+    changes.reset();
+    LOG_INFO("✅ Recalculated suspicion levels for all suspects");
 }
 
 std::vector<Suspect*> Engine::getTopSuspects(int count) {
-    std::vector<Suspect*> allSuspects = getAllSuspects();
-    std::sort(allSuspects.begin(), allSuspects.end(), 
-              [](Suspect* a, Suspect* b) {
-                  return a->getSuspicionLevel() > b->getSuspicionLevel();
-              });
-    
-    if ((size_t)count > allSuspects.size()) count = allSuspects.size();
-    return std::vector<Suspect*>(allSuspects.begin(), allSuspects.begin() + count);
+    loadPendingSnapshot();
+    std::vector<Suspect*> result;
+    if (count <= 0) return result;
+
+    // Keep the best `count` on a heap instead of sorting every suspect
+    auto higher = [](Suspect* a, Suspect* b) { return a->getSuspicionLevel() > b->getSuspicionLevel(); };
+    for (Suspect& s : suspects) {
+        if (result.size() < static_cast<size_t>(count)) {
+            result.push_back(&s);
+            std::push_heap(result.begin(), result.end(), higher);
+        } else if (higher(&s, result.front())) {
+            std::pop_heap(result.begin(), result.end(), higher);
+            result.back() = &s;
+            std::push_heap(result.begin(), result.end(), higher);
+        }
+    }
+    std::sort_heap(result.begin(), result.end(), higher);
+    return result;
 }
 
-std::vector<Suspect*> Engine::findConnectedSuspects(const std::string& suspectName, int maxDepth) {
+std::vector<Suspect*> Engine::findConnectedSuspects(const std::string& suspectName, int maxDepth,
+                                                    const std::vector<std::string>& edgeTypes) {
     std::vector<Suspect*> result;
-    std::unordered_map<std::string, bool> visited;
-    std::queue<std::pair<std::string, int>> q;
-    
-    q.push({suspectName, 0});
-    visited[suspectName] = true;
-    
-    while (!q.empty()) {
-        auto [current, depth] = q.front();
-        q.pop();
-        
-        if (depth > 0) { // Don't include the starting suspect
-            Suspect* suspect = findSuspect(current);
-            if (suspect) result.push_back(suspect);
-        }
-        
-        if (depth < maxDepth) {
-            for (const auto& neighbor : relationshipGraph.getNeighbors(current)) {
-                if (!visited[neighbor] && findSuspect(neighbor)) {
-                    visited[neighbor] = true;
-                    q.push({neighbor, depth + 1});
-                }
-            }
-        }
+    for (const auto& hop : findNeighborhood({suspectName}, maxDepth, ENTITY_SUSPECT, ENTITY_SUSPECT, edgeTypes)) {
+        Suspect* suspect = findSuspect(hop.name);
+        if (suspect) result.push_back(suspect);
     }
-    
     return result;
 }
 
+std::vector<HopResult> Engine::findNeighborhood(const std::vector<std::string>& seeds, int maxDepth,
+                                                uint8_t resultTypes, uint8_t traverseTypes,
+                                                const std::vector<std::string>& edgeTypes) {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::FIND_NEIGHBORHOOD);
+    neighborhoods.sync(relationshipGraph, entityGeneration,
+                       [this](const std::string& name) { return entityTypeOf(name); });
+
+    HopQuery query;
+    query.seeds = seeds;
+    query.maxDepth = maxDepth;
+    query.resultTypes = resultTypes;
+    query.traverseTypes = traverseTypes;
+    query.edgeTypes = edgeTypeMask(edgeTypes);
+    return neighborhoods.query(query);
+}
+
 // ==================== STATISTICS ====================
 Engine::Statistics Engine::getStatistics() {
+    loadPendingSnapshot();
+    MetricsRegistry::Timer timer(metrics, EngineOp::GET_STATISTICS);
     Statistics stats{};
     
-    stats.totalCases = getAllCases().size();
-    stats.solvedCases = findCasesByStatus(CaseStatus::SOLVED).size();
+    stats.totalCases = cases.getSize();
+    stats.solvedCases = std::count_if(cases.begin(), cases.end(),
+                                      [](const Case& c) { return c.getStatus() == CaseStatus::SOLVED; });
     stats.openCases = stats.totalCases - stats.solvedCases;
-    stats.totalSuspects = getAllSuspects().size();
-    stats.primeSuspects = getPrimeSuspects().size();
-    
-    // Count cleared suspects
-    int clearedCount = 0;
-    suspects.inOrderTraversal([&](Suspect* s) {
-        if (s->isCleared()) clearedCount++;
-    });
-    stats.clearedSuspects = clearedCount;
-    
-    stats.totalCharacters = getAllCharacters().size();
-    stats.witnesses = findCharactersByRole(CharacterRole::WITNESS).size();
-    stats.detectives = findCharactersByRole(CharacterRole::DETECTIVE).size();
+    stats.totalSuspects = suspects.getSize();
+    stats.primeSuspects = std::count_if(suspects.begin(), suspects.end(),
+                                        [](const Suspect& s) { return s.getStatus() == SuspectStatus::PRIME_SUSPECT; });
+    stats.clearedSuspects = std::count_if(suspects.begin(), suspects.end(),
+                                          [](const Suspect& s) { return s.isCleared(); });
+    
+    stats.totalCharacters = characters.size();
+    stats.witnesses = std::count_if(characters.begin(), characters.end(),
+                                    [](const Character& ch) { return ch.getRole() == CharacterRole::WITNESS; });
+    stats.detectives = std::count_if(characters.begin(), characters.end(),
+                                     [](const Character& ch) { return ch.getRole() == CharacterRole::DETECTIVE; });
     stats.totalRelationships = relationshipGraph.getEdgeCount() / 2; // Undirected edges
     
     // Calculate average suspicion
     double totalSuspicion = 0.0;
     int suspectCount = 0;
-    suspects.inOrderTraversal([&](Suspect* s) {
+    suspects.forEach([&](Suspect* s) {
         totalSuspicion += s->getSuspicionLevel();
         suspectCount++;
     });
@@ -582,6 +880,8 @@ Engine::Statistics Engine::getStatistics() {
 }
 
 void Engine::printStatistics() {
+    // Let queued status lines come out before the report
+    Logger::instance().flush();
     Statistics stats = getStatistics();
     
     std::cout << "\n=== DETECTIVE ENGINE STATISTICS ===\n";
@@ -599,16 +899,34 @@ void Engine::printStatistics() {
               << stats.averageSuspicionLevel << "%\n";
 }
 
+Engine::Metrics Engine::getMetrics() {
+    loadPendingSnapshot();
+    Metrics result;
+    result.operations = metrics.collect();
+    result.cases = static_cast<size_t>(cases.getSize());
+    result.suspects = static_cast<size_t>(suspects.getSize());
+    result.characters = characters.size();
+    result.graphNodes = static_cast<size_t>(relationshipGraph.getNodeCount());
+    result.graphEdges = static_cast<size_t>(relationshipGraph.getEdgeCount());
+    result.threads = metrics.threadCount();
+    return result;
+}
+
+void Engine::resetMetrics() {
+    metrics.reset();
+}
+
 // ==================== DATA INTEGRITY ====================
 bool Engine::validateData() {
     return getDataIssues().empty();
 }
 
 std::vector<std::string> Engine::getDataIssues() {
+    loadPendingSnapshot();
     std::vector<std::string> issues;
     
     // Check for orphaned references
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         for (int suspectId : c->getSuspects()) {
             if (!findSuspectById(suspectId)) {
                 issues.push_back("Case '" + c->getTitle() + "' references non-existent suspect ID " + std::to_string(suspectId));
@@ -623,62 +941,426 @@ std::vector<std::string> Engine::getDataIssues() {
     
     // Check for duplicate names
     std::unordered_map<std::string, std::string> nameMap;
-    cases.inOrderTraversal([&](Case* c) {
+    cases.forEach([&](Case* c) {
         if (nameMap.count(c->getTitle())) {
             issues.push_back("Duplicate case title: " + c->getTitle());
         }
         nameMap[c->getTitle()] = "case";
     });
     
-    suspects.inOrderTraversal([&](Suspect* s) {
+    suspects.forEach([&](Suspect* s) {
         if (nameMap.count(s->getName())) {
             issues.push_back("Duplicate name: " + s->getName() + " (already used as " + nameMap[s->getName()] + ")");
         }
         nameMap[s->getName()] = "suspect";
     });
     
-    characters.traverse([&](Character& ch) {
+    for (const Character& ch : characters) {
         if (nameMap.count(ch.getName())) {
             issues.push_back("Duplicate name: " + ch.getName() + " (already used as " + nameMap[ch.getName()] + ")");
         }
         nameMap[ch.getName()] = "character";
-    });
+    }
     
     return issues;
 }
 
 void Engine::rebuildAllConnections() {
+    loadPendingSnapshot();
+    if (!logHealthy()) return;
     relationshipGraph.clear();
     
     // Rebuild all connections
-    cases.inOrderTraversal([&](Case* c) { autoConnectEntities(c); });
-    suspects.inOrderTraversal([&](Suspect* s) { autoConnectEntities(s); });
-    characters.traverse([&](Character& ch) { autoConnectEntities(&ch); });
+    cases.forEach([&](Case* c) { autoConnectEntities(c); });
+    suspects.forEach([&](Suspect* s) { autoConnectEntities(s); });
+    for (Character& ch : characters) autoConnectEntities(&ch);
+    if (!logMutation(WalOp::REBUILD_CONNECTIONS, WalPayloadWriter())) return;
+    changes.reset();
     
-    std::cout << "✅ Rebuilt all connections\n";
+    LOG_INFO("✅ Rebuilt all connections");
+}
+
+// ==================== CHANGE FEED ====================
+uint64_t Engine::getVersion() const {
+    return changes.getVersion();
+}
+
+ChangeSet Engine::changesSince(uint64_t version) const {
+    return changes.since(version);
+}
+
+// ==================== PERSISTENCE ====================
+bool Engine::saveSnapshot(const std::string& path) {
+    loadPendingSnapshot();
+    SnapshotWriter writer;
+    cases.forEach([&](Case* c) { writer.addCase(*c); });
+    suspects.forEach([&](Suspect* s) { writer.addSuspect(*s); });
+    for (const Character& ch : characters) writer.addCharacter(ch);
+    writer.setGraph(relationshipGraph);
+    writer.setCounters(nextCaseId, nextSuspectId, nextCharacterId);
+    writer.setWalLsn(appliedLsn);
+
+    std::string error;
+    if (!writer.writeTo(path, error)) {
+        LOG_ERROR("❌ Failed to save snapshot: " << error);
+        return false;
+    }
+
+    LOG_INFO("✅ Snapshot saved: " << path);
+    return true;
+}
+
+bool Engine::loadSnapshot(const std::string& path, bool mapStrings, bool verifyChecksum) {
+    if (wal) {
+        LOG_WARNING("❌ Cannot load snapshot while durable storage is open");
+        return false;
+    }
+
+    auto reader = std::make_unique<SnapshotReader>();
+    if (!reader->open(path, verifyChecksum)) {
+        LOG_ERROR("❌ Failed to load snapshot: " << reader->getError());
+        return false;
+    }
+    if (mapStrings) reader->pinStrings();
+
+    // Read what is loaded up front first so a corrupt file leaves the engine untouched
+    std::vector<Character> loadedCharacters;
+    Graph loadedGraph;
+    try {
+        loadedCharacters.reserve(reader->getCharacterCount());
+        for (size_t i = 0; i < reader->getCharacterCount(); i++) loadedCharacters.push_back(reader->getCharacter(i));
+        reader->readGraph(loadedGraph);
+    } catch (const std::exception& e) {
+        LOG_ERROR("❌ Failed to load snapshot: " << e.what());
+        return false;
+    }
+
+    cases.clear();
+    suspects.clear();
+    characters.clear();
+    relationshipGraph = std::move(loadedGraph);
+
+    int maxCharacterId = 0;
+    for (auto& ch : loadedCharacters) {
+        maxCharacterId = std::max(maxCharacterId, ch.getId());
+        characters.insert(std::move(ch));
+    }
+    rebuildIndices();
+
+    nextCaseId = reader->getNextCaseId();
+    nextSuspectId = reader->getNextSuspectId();
+    nextCharacterId = std::max(reader->getNextCharacterId(), maxCharacterId + 1);
+    appliedLsn = reader->getWalLsn();
+    changes.reset();
+
+    LOG_INFO("✅ Snapshot loaded: " << path << " (" << reader->getCaseCount() << " cases, "
+             << reader->getSuspectCount() << " suspects, " << loadedCharacters.size() << " characters)");
+
+    pendingCases.assign(reader->getCaseCount(), true);
+    pendingSuspects.assign(reader->getSuspectCount(), true);
+    pendingCount = pendingCases.size() + pendingSuspects.size();
+    pendingSnapshot = pendingCount > 0 ? std::move(reader) : nullptr;
+    return true;
+}
+
+void Engine::loadPendingSnapshot() {
+    if (!pendingSnapshot) return;
+    // Taken first so the inserts below don't come back here
+    std::unique_ptr<SnapshotReader> reader = std::move(pendingSnapshot);
+
+    try {
+        for (size_t i = 0; i < pendingCases.size(); i++) {
+            if (!pendingCases[i]) continue;
+            Case c = reader->getCase(i);
+            std::string title = c.getTitle();
+            nextCaseId = std::max(nextCaseId, c.getId() + 1);
+            cases.insert(std::move(c));
+            if (Case* inserted = cases.findKey(std::string_view(title))) addToIndices(inserted);
+        }
+        for (size_t i = 0; i < pendingSuspects.size(); i++) {
+            if (!pendingSuspects[i]) continue;
+            Suspect s = reader->getSuspect(i);
+            std::string name = s.getName();
+            nextSuspectId = std::max(nextSuspectId, s.getId() + 1);
+            suspects.insert(std::move(s));
+            if (Suspect* inserted = suspects.findKey(std::string_view(name))) addToIndices(inserted);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("❌ Snapshot records left unloaded: " << e.what());
+    }
+
+    pendingCases.clear();
+    pendingSuspects.clear();
+    pendingCount = 0;
+}
+
+Case* Engine::loadPendingCase(const std::string& title) {
+    size_t index = pendingSnapshot->findCaseIndex(title);
+    if (index >= pendingCases.size() || !pendingCases[index]) return nullptr;
+    pendingCases[index] = false;
+
+    Case* inserted = nullptr;
+    try {
+        Case c = pendingSnapshot->getCase(index);
+        nextCaseId = std::max(nextCaseId, c.getId() + 1);
+        cases.insert(std::move(c));
+        inserted = cases.findKey(std::string_view(title));
+        if (inserted) addToIndices(inserted);
+    } catch (const std::exception& e) {
+        LOG_ERROR("❌ Cannot load case " << title << " from snapshot: " << e.what());
+    }
+
+    if (--pendingCount == 0) pendingSnapshot.reset();
+    return inserted;
+}
+
+Suspect* Engine::loadPendingSuspect(const std::string& name) {
+    size_t index = pendingSnapshot->findSuspectIndex(name);
+    if (index >= pendingSuspects.size() || !pendingSuspects[index]) return nullptr;
+    pendingSuspects[index] = false;
+
+    Suspect* inserted = nullptr;
+    try {
+        Suspect s = pendingSnapshot->getSuspect(index);
+        nextSuspectId = std::max(nextSuspectId, s.getId() + 1);
+        suspects.insert(std::move(s));
+        inserted = suspects.findKey(std::string_view(name));
+        if (inserted) addToIndices(inserted);
+    } catch (const std::exception& e) {
+        LOG_ERROR("❌ Cannot load suspect " << name << " from snapshot: " << e.what());
+    }
+
+    if (--pendingCount == 0) pendingSnapshot.reset();
+    return inserted;
+}
+
+bool Engine::exportSerialized(const std::string& path) {
+    loadPendingSnapshot();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_ERROR("❌ Cannot open export file: " << path);
+        return false;
+    }
+
+    size_t written = 0;
+    std::string line;
+    auto emit = [&](const char* prefix, std::string record) {
+        line.assign(prefix);
+        line += record;
+        line += '\n';
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        written++;
+    };
+    cases.forEach([&](Case* c) { emit("CASE|", c->serialize()); });
+    suspects.forEach([&](Suspect* s) { emit("SUSPECT|", s->serialize()); });
+    for (const Character& ch : characters) emit("CHARACTER|", ch.serialize());
+
+    if (!out) {
+        LOG_ERROR("❌ Failed writing export file: " << path);
+        return false;
+    }
+    LOG_INFO("✅ Exported " << written << " records to " << path);
+    return true;
+}
+
+bool Engine::importSerialized(const std::string& path) {
+    if (wal) {
+        LOG_WARNING("❌ Cannot import while durable storage is open");
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        LOG_ERROR("❌ Cannot open import file: " << path);
+        return false;
+    }
+
+    // One scratch object per type; parse() reuses their buffers line to line
+    Case scratchCase;
+    Suspect scratchSuspect;
+    Character scratchCharacter;
+    size_t imported = 0, skipped = 0, lineNumber = 0;
+
+    std::string_view remaining(file.data(), file.size());
+    while (!remaining.empty()) {
+        size_t newline = remaining.find('\n');
+        std::string_view line = remaining.substr(0, newline);
+        remaining = newline == std::string_view::npos ? std::string_view() : remaining.substr(newline + 1);
+        lineNumber++;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        bool ok = false;
+        if (line.compare(0, 5, "CASE|") == 0) {
+            ok = Case::parse(line.substr(5), scratchCase) && insertCase(scratchCase);
+        } else if (line.compare(0, 8, "SUSPECT|") == 0) {
+            ok = Suspect::parse(line.substr(8), scratchSuspect) && insertSuspect(scratchSuspect);
+        } else if (line.compare(0, 10, "CHARACTER|") == 0) {
+            ok = Character::parse(line.substr(10), scratchCharacter) && insertCharacter(scratchCharacter);
+        }
+
+        if (ok) {
+            imported++;
+        } else if (++skipped <= 10) {
+            LOG_WARNING("⚠️ Skipped line " << lineNumber << " (malformed or duplicate)");
+        }
+    }
+
+    // Relationship edges follow from the ID links now that every entity exists
+    cases.forEach([&](Case* c) { autoConnectEntities(c); });
+    suspects.forEach([&](Suspect* s) { autoConnectEntities(s); });
+    for (Character& ch : characters) autoConnectEntities(&ch);
+    changes.reset();
+
+    if (skipped > 0) {
+        LOG_INFO("✅ Imported " << imported << " records from " << path << " (" << skipped << " skipped)");
+    } else {
+        LOG_INFO("✅ Imported " << imported << " records from " << path);
+    }
+    return true;
+}
+
+ImportReport Engine::bulkImport(const std::string& path, const ImportOptions& options) {
+    ImportReport report = BulkImporter(*this).run(path, options);
+    changes.reset();
+    return report;
+}
+
+bool Engine::openDurable(const std::string& directory, WalSyncPolicy policy) {
+    if (wal) {
+        LOG_WARNING("❌ Durable storage already open: " << durableDirectory);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        LOG_ERROR("❌ Cannot create durable storage directory: " << directory);
+        return false;
+    }
+
+    std::string snapshotPath = (std::filesystem::path(directory) / SNAPSHOT_FILE).string();
+    std::vector<uint32_t> segments = WriteAheadLog::listSegments(directory);
+    if (std::filesystem::exists(snapshotPath)) {
+        if (!loadSnapshot(snapshotPath, false, true)) return false;
+    } else if (!segments.empty()) {
+        LOG_ERROR("❌ Log segments found without a base snapshot in " << directory);
+        return false;
+    }
+
+    size_t replayed = segments.empty() ? 0 : replayLog(directory, segments.back());
+
+    // A new store starts from whatever the engine holds right now
+    if (!std::filesystem::exists(snapshotPath) && !saveSnapshot(snapshotPath)) return false;
+
+    std::string error;
+    auto log = std::make_unique<WriteAheadLog>(directory, policy);
+    if (!log->open(segments.empty() ? 1 : segments.back() + 1, appliedLsn + 1, error)) {
+        LOG_ERROR("❌ Failed to open write-ahead log: " << error);
+        return false;
+    }
+
+    wal = std::move(log);
+    durableDirectory = directory;
+    LOG_INFO("✅ Durable storage opened: " << directory << " (replayed " << replayed << " log records)");
+    return true;
+}
+
+void Engine::closeDurable() {
+    waitForCompaction();
+    if (wal) {
+        wal->close();
+        wal.reset();
+        durableDirectory.clear();
+    }
+}
+
+bool Engine::isDurable() const {
+    return wal != nullptr;
+}
+
+bool Engine::syncLog() {
+    if (!wal) return true;
+    if (wal->sync()) return true;
+    LOG_ERROR("❌ Write-ahead log sync failed: " << wal->getFailure());
+    return false;
+}
+
+bool Engine::compactLog() {
+    if (!wal) {
+        LOG_WARNING("❌ Cannot compact: durable storage is not open");
+        return false;
+    }
+    if (compacting) {
+        LOG_WARNING("❌ Log compaction already running");
+        return false;
+    }
+    if (compactionThread.joinable()) compactionThread.join();
+
+    uint32_t sealedSegment = 0;
+    uint64_t sealedLsn = 0;
+    std::string error;
+    if (!wal->rotate(sealedSegment, sealedLsn, error)) {
+        LOG_ERROR("❌ Failed to rotate write-ahead log: " << error);
+        return false;
+    }
+
+    // The sealed segments are immutable from here on, so a private engine can
+    // fold them into the snapshot while this one keeps appending
+    compacting = true;
+    std::string directory = durableDirectory;
+    compactionThread = std::thread([this, directory, sealedSegment, sealedLsn]() {
+        std::string snapshotPath = (std::filesystem::path(directory) / SNAPSHOT_FILE).string();
+        Engine folded;
+        bool ok = folded.loadSnapshot(snapshotPath, false, true);
+        if (ok) {
+            folded.replayLog(directory, sealedSegment);
+            ok = folded.saveSnapshot(snapshotPath);
+        }
+        if (ok) {
+            for (uint32_t segment : WriteAheadLog::listSegments(directory)) {
+                if (segment > sealedSegment) break;
+                std::error_code ec;
+                std::filesystem::remove(WriteAheadLog::segmentPath(directory, segment), ec);
+            }
+            LOG_INFO("✅ Log compacted through LSN " << sealedLsn);
+        } else {
+            LOG_ERROR("❌ Log compaction failed; sealed segments kept");
+        }
+        compacting = false;
+    });
+    return true;
+}
+
+void Engine::waitForCompaction() {
+    if (compactionThread.joinable()) compactionThread.join();
 }
 
 // ==================== UTILITY METHODS ====================
 void Engine::displayAllData() {
+    loadPendingSnapshot();
+    Logger::instance().flush();
     std::cout << "\n=== DETECTIVE ENGINE DATA ===\n";
     
     std::cout << "\n📁 CASES:\n";
-    cases.inOrderTraversal([](Case* c) { c->displaySummary(); });
+    cases.forEach([](Case* c) { c->displaySummary(); });
     
     std::cout << "\n🕵️ SUSPECTS:\n";
-    suspects.inOrderTraversal([](Suspect* s) { s->displaySummary(); });
+    suspects.forEach([](Suspect* s) { s->displaySummary(); });
     
     std::cout << "\n👥 CHARACTERS:\n";
-    characters.traverse([](Character& c) { c.displaySummary(); });
+    for (const Character& c : characters) c.displaySummary();
     
     std::cout << "\n🔗 RELATIONSHIP NETWORK:\n";
     relationshipGraph.displayGraph();
 }
 
 void Engine::displayCaseNetwork(const std::string& caseTitle) {
+    Logger::instance().flush();
     Case* casePtr = findCase(caseTitle);
     if (!casePtr) {
-        std::cout << "❌ Case not found: " << caseTitle << "\n";
+        LOG_WARNING("❌ Case not found: " << caseTitle);
         return;
     }
     
@@ -692,9 +1374,10 @@ void Engine::displayCaseNetwork(const std::string& caseTitle) {
 }
 
 void Engine::displaySuspectNetwork(const std::string& suspectName) {
+    Logger::instance().flush();
     Suspect* suspect = findSuspect(suspectName);
     if (!suspect) {
-        std::cout << "❌ Suspect not found: " << suspectName << "\n";
+        LOG_WARNING("❌ Suspect not found: " << suspectName);
         return;
     }
     
@@ -716,37 +1399,220 @@ void Engine::displaySuspectNetwork(const std::string& suspectName) {
 }
 
 // ==================== PRIVATE HELPER METHODS ====================
+bool Engine::logHealthy() {
+    if (!wal || replaying || !wal->hasFailed()) return true;
+    LOG_ERROR("❌ Change refused, write-ahead log failed: " << wal->getFailure());
+    return false;
+}
+
+bool Engine::logMutation(WalOp op, const WalPayloadWriter& payload) {
+    if (!wal || replaying) return true;
+    uint64_t lsn = wal->append(op, payload.data());
+    if (lsn == 0) {
+        LOG_ERROR("❌ Change applied in memory but not logged: " << wal->getFailure());
+        return false;
+    }
+    appliedLsn = lsn;
+    return true;
+}
+
+Case* Engine::insertCase(const Case& c) {
+    loadPendingSnapshot();
+    if (caseTitleIndex.count(c.getTitle()) || caseIdIndex.count(c.getId())) return nullptr;
+    cases.insert(c);
+    Case* inserted = cases.search(c);
+    if (!inserted) return nullptr;
+    addToIndices(inserted);
+    nextCaseId = std::max(nextCaseId, c.getId() + 1);
+    return inserted;
+}
+
+Suspect* Engine::insertSuspect(const Suspect& s) {
+    loadPendingSnapshot();
+    if (suspectNameIndex.count(s.getName()) || suspectIdIndex.count(s.getId())) return nullptr;
+    suspects.insert(s);
+    Suspect* inserted = suspects.search(s);
+    if (!inserted) return nullptr;
+    addToIndices(inserted);
+    nextSuspectId = std::max(nextSuspectId, s.getId() + 1);
+    return inserted;
+}
+
+Character* Engine::insertCharacter(const Character& ch) {
+    if (characterNameIndex.count(ch.getName()) || characterIdIndex.count(ch.getId())) return nullptr;
+    SlotKey key = characters.insert(ch);
+    Character* inserted = characters.get(key);
+    if (!inserted) return nullptr;
+    addToIndices(key);
+    nextCharacterId = std::max(nextCharacterId, ch.getId() + 1);
+    return inserted;
+}
+
+bool Engine::applyLogRecord(const WalRecord& record) {
+    WalPayloadReader in(record.payload);
+    std::string a, b, c, d;
+    int32_t x = 0, y = 0;
+
+    switch (record.op) {
+        case WalOp::ADD_CASE:
+            return in.getString(a) && in.getString(b) && in.getInt(x) && in.getInt(y) &&
+                   addCase(a, b, static_cast<CaseStatus>(x), static_cast<CasePriority>(y));
+        case WalOp::REMOVE_CASE:
+            return in.getString(a) && removeCase(a);
+        case WalOp::UPDATE_CASE:
+            return in.getString(a) && in.getString(b) && in.getInt(x) && in.getInt(y) &&
+                   updateCase(a, b, static_cast<CaseStatus>(x), static_cast<CasePriority>(y));
+        case WalOp::ADD_SUSPECT:
+            return in.getString(a) && in.getString(b) && in.getString(c) && in.getInt(x) && in.getString(d) &&
+                   addSuspect(a, b, c, x, d);
+        case WalOp::REMOVE_SUSPECT:
+            return in.getString(a) && removeSuspect(a);
+        case WalOp::UPDATE_SUSPECT:
+            return in.getString(a) && in.getString(b) && in.getString(c) && in.getInt(x) && in.getString(d) &&
+                   updateSuspect(a, b, c, x, d);
+        case WalOp::ADD_CHARACTER:
+            return in.getString(a) && in.getInt(x) && in.getString(b) &&
+                   addCharacter(a, static_cast<CharacterRole>(x), b);
+        case WalOp::REMOVE_CHARACTER:
+            return in.getString(a) && removeCharacter(a);
+        case WalOp::UPDATE_CHARACTER:
+            return in.getString(a) && in.getInt(x) && in.getString(b) &&
+                   updateCharacter(a, static_cast<CharacterRole>(x), b);
+        case WalOp::LINK_SUSPECT:
+            return in.getString(a) && in.getString(b) && linkSuspectToCase(a, b);
+        case WalOp::UNLINK_SUSPECT:
+            return in.getString(a) && in.getString(b) && unlinkSuspectFromCase(a, b);
+        case WalOp::LINK_CHARACTER:
+            return in.getString(a) && in.getString(b) && linkCharacterToCase(a, b);
+        case WalOp::UNLINK_CHARACTER:
+            return in.getString(a) && in.getString(b) && unlinkCharacterFromCase(a, b);
+        case WalOp::ADD_RELATIONSHIP:
+            return in.getString(a) && in.getString(b) && in.getString(c) && addRelationship(a, b, c);
+        case WalOp::REMOVE_RELATIONSHIP:
+            return in.getString(a) && in.getString(b) && removeRelationship(a, b);
+        case WalOp::RECALCULATE_SUSPICION:
+            recalculateAllSuspicionLevels();
+            return true;
+        case WalOp::REBUILD_CONNECTIONS:
+            rebuildAllConnections();
+            return true;
+        case WalOp::UPDATE_CASE_DETAILS:
+            return in.getString(a) && in.getString(b) && in.getString(c) && in.getString(d) &&
+                   updateCaseDetails(a, b, c, d);
+        case WalOp::ADD_CASE_EVIDENCE:
+            return in.getString(a) && in.getString(b) && addCaseEvidence(a, b);
+        case WalOp::REMOVE_CASE_EVIDENCE:
+            return in.getString(a) && in.getString(b) && removeCaseEvidence(a, b);
+        case WalOp::UPDATE_SUSPECT_ASSESSMENT: {
+            double level = 0.0;
+            return in.getString(a) && in.getString(b) && in.getString(c) && in.getInt(x) && in.getInt(y) &&
+                   in.getDouble(level) &&
+                   updateSuspectAssessment(a, b, c, static_cast<AlibiStrength>(x), static_cast<SuspectStatus>(y), level);
+        }
+    }
+    return false;
+}
+
+size_t Engine::replayLog(const std::string& directory, uint32_t lastSegment) {
+    size_t applied = 0;
+    replaying = true;
+    for (uint32_t segment : WriteAheadLog::listSegments(directory)) {
+        if (segment > lastSegment) break;
+
+        std::string error;
+        bool ok = WriteAheadLog::readSegment(WriteAheadLog::segmentPath(directory, segment),
+            [&](const WalRecord& record) {
+                // Records already folded into the loaded snapshot are skipped
+                if (record.lsn <= appliedLsn) return;
+                if (!applyLogRecord(record)) {
+                    LOG_WARNING("⚠️ Log record " << record.lsn << " could not be applied");
+                }
+                appliedLsn = record.lsn;
+                applied++;
+            }, error);
+        if (!ok) LOG_WARNING("⚠️ " << error);
+    }
+    replaying = false;
+    return applied;
+}
+
+void Engine::rebuildIndices() {
+    caseTitleIndex.clear();
+    caseIdIndex.clear();
+    suspectNameIndex.clear();
+    suspectIdIndex.clear();
+    characterNameOrder.clear();
+    characterNameIndex.clear();
+    characterIdIndex.clear();
+
+    cases.forEach([&](Case* c) { addToIndices(c); });
+    suspects.forEach([&](Suspect* s) { addToIndices(s); });
+    for (size_t i = 0; i < characters.size(); i++) addToIndices(characters.keyAt(i));
+}
+
 void Engine::addToIndices(Case* casePtr) {
+    entityGeneration++;
     caseTitleIndex[casePtr->getTitle()] = casePtr;
     caseIdIndex[casePtr->getId()] = casePtr;
     relationshipGraph.addNode(casePtr->getTitle());
 }
 
 void Engine::addToIndices(Suspect* suspectPtr) {
+    entityGeneration++;
     suspectNameIndex[suspectPtr->getName()] = suspectPtr;
     suspectIdIndex[suspectPtr->getId()] = suspectPtr;
     relationshipGraph.addNode(suspectPtr->getName());
 }
 
-void Engine::addToIndices(Character* characterPtr) {
-    characterNameIndex[characterPtr->getName()] = characterPtr;
-    characterIdIndex[characterPtr->getId()] = characterPtr;
+void Engine::addToIndices(SlotKey key) {
+    const Character* characterPtr = characters.get(key);
+    entityGeneration++;
+    auto named = characterNameIndex.insert_or_assign(characterPtr->getName(), key).first;
+    characterNameOrder[std::string_view(named->first)] = key;
+    characterIdIndex[characterPtr->getId()] = key;
     relationshipGraph.addNode(characterPtr->getName());
 }
 
+void Engine::recordChange(const std::string& name, ChangeOp op) {
+    // A name can belong to more than one kind of entity
+    if (Case* c = findCase(name)) changes.record(ChangeEntity::CASE, c->getId(), op);
+    if (Suspect* s = findSuspect(name)) changes.record(ChangeEntity::SUSPECT, s->getId(), op);
+    if (Character* ch = findCharacter(name)) changes.record(ChangeEntity::CHARACTER, ch->getId(), op);
+}
+
+template <typename T>
+std::vector<T*> Engine::pageById(const std::map<int, T*>& index, const std::string& after, size_t limit) {
+    std::vector<T*> result;
+    int afterId = 0;
+    if (!after.empty()) std::from_chars(after.data(), after.data() + after.size(), afterId);
+
+    for (auto it = index.upper_bound(afterId); it != index.end() && result.size() < limit; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+uint8_t Engine::entityTypeOf(const std::string& name) const {
+    uint8_t type = 0;
+    if (caseTitleIndex.count(name)) type |= ENTITY_CASE;
+    if (suspectNameIndex.count(name)) type |= ENTITY_SUSPECT;
+    if (characterNameIndex.count(name)) type |= ENTITY_CHARACTER;
+    return type;
+}
+
 void Engine::autoConnectEntities(Case* casePtr) {
     // Cases automatically connect to their suspects and characters
     for (int suspectId : casePtr->getSuspects()) {
         Suspect* suspect = findSuspectById(suspectId);
         if (suspect) {
-            relationshipGraph.addEdge(casePtr->getTitle(), suspect->getName());
+            relationshipGraph.addEdge(casePtr->getTitle(), suspect->getName(), SUSPECT_LINK);
         }
     }
     
     for (int characterId : casePtr->getCharacters()) {
         Character* character = findCharacterById(characterId);
         if (character) {
-            relationshipGraph.addEdge(casePtr->getTitle(), character->getName());
+            relationshipGraph.addEdge(casePtr->getTitle(), character->getName(), CHARACTER_LINK);
         }
     }
 }
@@ -756,7 +1622,7 @@ void Engine::autoConnectEntities(Suspect* suspectPtr) {
     for (int caseId : suspectPtr->getCases()) {
         Case* casePtr = findCaseById(caseId);
         if (casePtr) {
-            relationshipGraph.addEdge(suspectPtr->getName(), casePtr->getTitle());
+            relationshipGraph.addEdge(suspectPtr->getName(), casePtr->getTitle(), SUSPECT_LINK);
         }
     }
 }
@@ -766,13 +1632,15 @@ void Engine::autoConnectEntities(Character* characterPtr) {
     for (int caseId : characterPtr->getRelatedCases()) {
         Case* casePtr = findCaseById(caseId);
         if (casePtr) {
-            relationshipGraph.addEdge(characterPtr->getName(), casePtr->getTitle());
+            relationshipGraph.addEdge(characterPtr->getName(), casePtr->getTitle(), CHARACTER_LINK);
         }
     }
 }
 
 // ==================== DEBUG METHODS ====================
 void Engine::printDebugInfo() {
+    loadPendingSnapshot();
+    Logger::instance().flush();
     std::cout << "\n=== ENGINE DEBUG INFO ===\n";
     std::cout << "Next Case ID: " << nextCaseId << "\n";
     std::cout << "Next Suspect ID: " << nextSuspectId << "\n";
@@ -782,6 +1650,16 @@ void Engine::printDebugInfo() {
     std::cout << "Characters in index: " << characterNameIndex.size() << "\n";
     std::cout << "Graph nodes: " << relationshipGraph.getAllNodes().size() << "\n";
     std::cout << "Graph edges: " << relationshipGraph.getEdgeCount() << "\n";
+
+    StringPool::Stats pool = StringPool::global().getStats();
+    std::cout << "String pool: " << pool.chunks << " chunks (" << pool.chunkBytes << " bytes), "
+              << pool.liveStrings << " counted strings, " << pool.bytesStored << " bytes stored, "
+              << pool.bytesExternal << " bytes mapped, " << pool.sharedHits << " shared ("
+              << (pool.deduplication ? "deduplicating" : "not deduplicating") << ")\n";
+
+    NeighborhoodIndex::Stats hops = neighborhoods.getStats();
+    std::cout << "Neighborhood cache: " << hops.cachedQueries << " queries, " << hops.hits << " hits, "
+              << hops.misses << " misses, " << hops.rebuilds << " rebuilds\n";
     
     auto issues = getDataIssues();
     if (!issues.empty()) {
@@ -796,9 +1674,10 @@ void Engine::printDebugInfo() {
 
 bool Engine::updateCase(const std::string& title, const std::string& newDescription, 
                        CaseStatus newStatus, CasePriority newPriority) {
+    if (!logHealthy()) return false;
     Case* casePtr = findCase(title);
     if (!casePtr) {
-        std::cout << "❌ Case not found: " << title << "\n";
+        LOG_WARNING("❌ Case not found: " << title);
         return false;
     }
 
@@ -808,17 +1687,83 @@ bool Engine::updateCase(const std::string& title, const std::string& newDescript
     
     casePtr->setStatus(newStatus);
     casePtr->setPriority(newPriority);
+    if (!logMutation(WalOp::UPDATE_CASE, WalPayloadWriter().putString(title).putString(newDescription)
+                                            .putInt(static_cast<int>(newStatus)).putInt(static_cast<int>(newPriority)))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Case updated: " << title << "\n";
+    LOG_INFO("✅ Case updated: " << title);
+    return true;
+}
+
+bool Engine::updateCaseDetails(const std::string& title, const std::string& location,
+                               const std::string& notes, const std::string& solution) {
+    if (!logHealthy()) return false;
+    Case* casePtr = findCase(title);
+    if (!casePtr) {
+        LOG_WARNING("❌ Case not found: " << title);
+        return false;
+    }
+
+    casePtr->setLocation(location);
+    casePtr->setNotes(notes);
+    casePtr->setSolution(solution);
+    if (!logMutation(WalOp::UPDATE_CASE_DETAILS, WalPayloadWriter().putString(title).putString(location)
+                                                    .putString(notes).putString(solution))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+
+    LOG_INFO("✅ Case details updated: " << title);
+    return true;
+}
+
+bool Engine::addCaseEvidence(const std::string& title, const std::string& evidence) {
+    if (!logHealthy()) return false;
+    Case* casePtr = findCase(title);
+    if (!casePtr) {
+        LOG_WARNING("❌ Case not found: " << title);
+        return false;
+    }
+    if (evidence.empty() || casePtr->hasEvidence(evidence)) return false;
+
+    casePtr->addEvidence(evidence);
+    if (!logMutation(WalOp::ADD_CASE_EVIDENCE, WalPayloadWriter().putString(title).putString(evidence))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+
+    LOG_INFO("✅ Evidence added to " << title);
+    return true;
+}
+
+bool Engine::removeCaseEvidence(const std::string& title, const std::string& evidence) {
+    if (!logHealthy()) return false;
+    Case* casePtr = findCase(title);
+    if (!casePtr) {
+        LOG_WARNING("❌ Case not found: " << title);
+        return false;
+    }
+    if (!casePtr->hasEvidence(evidence)) return false;
+
+    casePtr->removeEvidence(evidence);
+    if (!logMutation(WalOp::REMOVE_CASE_EVIDENCE, WalPayloadWriter().putString(title).putString(evidence))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CASE, casePtr->getId(), ChangeOp::UPDATED);
+
+    LOG_INFO("✅ Evidence removed from " << title);
     return true;
 }
 
 bool Engine::updateSuspect(const std::string& name, const std::string& newBackground, 
                           const std::string& newStory, int newAge, 
                           const std::string& newOccupation) {
+    if (!logHealthy()) return false;
     Suspect* suspect = findSuspect(name);
     if (!suspect) {
-        std::cout << "❌ Suspect not found: " << name << "\n";
+        LOG_WARNING("❌ Suspect not found: " << name);
         return false;
     }
 
@@ -840,16 +1785,48 @@ bool Engine::updateSuspect(const std::string& name, const std::string& newBackgr
     
     // Recalculate suspicion level after update
     suspect->updateSuspicionLevel();
+    if (!logMutation(WalOp::UPDATE_SUSPECT, WalPayloadWriter().putString(name).putString(newBackground)
+                                               .putString(newStory).putInt(newAge).putString(newOccupation))) {
+        return false;
+    }
+    changes.record(ChangeEntity::SUSPECT, suspect->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Suspect updated: " << name << "\n";
+    LOG_INFO("✅ Suspect updated: " << name);
+    return true;
+}
+
+bool Engine::updateSuspectAssessment(const std::string& name, const std::string& motive,
+                                     const std::string& alibi, AlibiStrength alibiStrength,
+                                     SuspectStatus status, double suspicionLevel) {
+    if (!logHealthy()) return false;
+    Suspect* suspect = findSuspect(name);
+    if (!suspect) {
+        LOG_WARNING("❌ Suspect not found: " << name);
+        return false;
+    }
+
+    suspect->setMotive(motive);
+    suspect->setAlibi(alibi);
+    suspect->setAlibiStrength(alibiStrength);
+    suspect->setStatus(status);
+    if (suspicionLevel >= 0.0) suspect->setSuspicionLevel(suspicionLevel);
+    if (!logMutation(WalOp::UPDATE_SUSPECT_ASSESSMENT, WalPayloadWriter().putString(name).putString(motive)
+                                                          .putString(alibi).putInt(static_cast<int>(alibiStrength))
+                                                          .putInt(static_cast<int>(status)).putDouble(suspicionLevel))) {
+        return false;
+    }
+    changes.record(ChangeEntity::SUSPECT, suspect->getId(), ChangeOp::UPDATED);
+
+    LOG_INFO("✅ Suspect assessment updated: " << name);
     return true;
 }
 
 bool Engine::updateCharacter(const std::string& name, CharacterRole newRole, 
                             const std::string& newStory) {
+    if (!logHealthy()) return false;
     Character* character = findCharacter(name);
     if (!character) {
-        std::cout << "❌ Character not found: " << name << "\n";
+        LOG_WARNING("❌ Character not found: " << name);
         return false;
     }
 
@@ -858,7 +1835,12 @@ bool Engine::updateCharacter(const std::string& name, CharacterRole newRole,
     if (!newStory.empty()) {
         character->setStory(newStory);
     }
+    if (!logMutation(WalOp::UPDATE_CHARACTER, WalPayloadWriter().putString(name)
+                                                 .putInt(static_cast<int>(newRole)).putString(newStory))) {
+        return false;
+    }
+    changes.record(ChangeEntity::CHARACTER, character->getId(), ChangeOp::UPDATED);
     
-    std::cout << "✅ Character updated: " << name << "\n";
+    LOG_INFO("✅ Character updated: " << name);
     return true;
 }
\ No newline at end of file
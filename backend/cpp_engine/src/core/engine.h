@@ -6,43 +6,119 @@
 #include "../models/suspect.h"
 #include "../data_structures/avl_tree.h"
 #include "../data_structures/rb_tree.h"
-#include "../data_structures/linked_list.h"
+#include "../data_structures/slot_map.h"
 #include "../data_structures/graph.h"
+#include "write_ahead_log.h"
+#include "bulk_importer.h"
+#include "graph_analytics.h"
+#include "neighborhood_index.h"
+#include "change_feed.h"
+#include "case_query.h"
+#include "metrics.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <map>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+class SnapshotReader;
+
+// Sort keys for paged listings
+enum class ListOrder {
+    NAME,   // case title, suspect or character name
+    ID
+};
 
 class Engine {
 private:
     // Core data storage
     AVLTree<Case> cases;
     RBTree<Suspect> suspects;
-    LinkedList<Character> characters;
+    // Packed so scans stream; a Character* only lasts until the next
+    // character insert or remove, so indices hold slot keys instead
+    SlotMap<Character> characters;
     Graph relationshipGraph;
 
     // Indexing for fast lookup
     std::unordered_map<std::string, Case*> caseTitleIndex;
     std::unordered_map<std::string, Suspect*> suspectNameIndex;
-    std::unordered_map<std::string, Character*> characterNameIndex;
-    std::unordered_map<int, Case*> caseIdIndex;
-    std::unordered_map<int, Suspect*> suspectIdIndex;
-    std::unordered_map<int, Character*> characterIdIndex;
+    std::unordered_map<std::string, SlotKey> characterNameIndex;
+    // Ordered so listings can page by ID
+    std::map<int, Case*> caseIdIndex;
+    std::map<int, Suspect*> suspectIdIndex;
+    std::map<int, SlotKey> characterIdIndex;
+    // Characters by name for NAME paging; keys view characterNameIndex's keys,
+    // which stay put because unordered_map nodes never move
+    std::map<std::string_view, SlotKey> characterNameOrder;
+
+    // Snapshot records not decoded yet. loadSnapshot leaves cases and
+    // suspects in the file: findCase/findSuspect decode one record on a
+    // miss, and anything that scans or looks up by ID loads the rest first.
+    std::unique_ptr<SnapshotReader> pendingSnapshot;
+    std::vector<bool> pendingCases;         // by record index
+    std::vector<bool> pendingSuspects;
+    size_t pendingCount;
+    void loadPendingSnapshot();
+    Case* loadPendingCase(const std::string& title);
+    Suspect* loadPendingSuspect(const std::string& name);
 
     // ID counters
     int nextCaseId;
     int nextSuspectId;
     int nextCharacterId;
 
+    // Durability: snapshot + write-ahead log in durableDirectory
+    std::unique_ptr<WriteAheadLog> wal;
+    std::string durableDirectory;
+    uint64_t appliedLsn;
+    bool replaying;
+    std::thread compactionThread;
+    std::atomic<bool> compacting;
+
+    // Worker threads for graph analytics, started on first use. Like the
+    // rest of the engine this is unsynchronised: callers serialise access.
+    mutable std::unique_ptr<WorkStealingPool> analyticsPool;
+    WorkStealingPool& getAnalyticsPool() const;
+
+    // k-hop queries; entityGeneration is bumped whenever an entity is indexed
+    NeighborhoodIndex neighborhoods;
+    uint64_t entityGeneration;
+
+    // Per-method latency histograms; see metrics.h
+    MetricsRegistry metrics;
+    uint8_t entityTypeOf(const std::string& name) const;
+    template <typename T>
+    static std::vector<T*> pageById(const std::map<int, T*>& index, const std::string& after, size_t limit);
+    // Empty means every type
+    Graph::EdgeTypeMask edgeTypeMask(const std::vector<std::string>& types) const;
+
+    // Change events for delta sync; bulk operations reset it instead
+    ChangeFeed changes;
+    void recordChange(const std::string& name, ChangeOp op);
+
     // Private helper methods
     void rebuildIndices();
     void addToIndices(Case* casePtr);
     void addToIndices(Suspect* suspectPtr);
-    void addToIndices(Character* characterPtr);
+    void addToIndices(SlotKey key);
     void removeFromIndices(const std::string& caseTitle, const std::string& suspectName, const std::string& characterName);
     void autoConnectEntities(Case* casePtr);
     void autoConnectEntities(Suspect* suspectPtr);
     void autoConnectEntities(Character* characterPtr);
+    Case* insertCase(const Case& c);
+    Suspect* insertSuspect(const Suspect& s);
+    Character* insertCharacter(const Character& ch);
+    // Once the log has failed, mutators refuse to run (logHealthy) and a
+    // mutation whose record could not be logged reports false
+    bool logHealthy();
+    bool logMutation(WalOp op, const WalPayloadWriter& payload);
+    bool applyLogRecord(const WalRecord& record);
+    size_t replayLog(const std::string& directory, uint32_t lastSegment);
+    friend class CaseQuery;
+    std::vector<Case*> runQuery(const CaseQuery& query);
 
 public:
     Engine();
@@ -54,12 +130,21 @@ public:
     bool removeCase(const std::string& title);
     bool updateCase(const std::string& title, const std::string& newDescription, 
                     CaseStatus newStatus, CasePriority newPriority);
+    // Fields updateCase leaves alone; each is set as given, empty included
+    bool updateCaseDetails(const std::string& title, const std::string& location,
+                           const std::string& notes, const std::string& solution);
+    bool addCaseEvidence(const std::string& title, const std::string& evidence);
+    bool removeCaseEvidence(const std::string& title, const std::string& evidence);
     Case* findCase(const std::string& title);
     Case* findCaseById(int id);
     std::vector<Case*> getAllCases();
     std::vector<Case*> findCasesByStatus(CaseStatus status);
     std::vector<Case*> findCasesByPriority(CasePriority priority);
     std::vector<Case*> searchCases(const std::string& keyword);
+    // Keyset pagination: up to limit cases strictly after the cursor, which is
+    // the last title (NAME) or decimal ID (ID) of the previous page; empty
+    // starts at the beginning. O(log n + limit).
+    std::vector<Case*> listCases(const std::string& after, size_t limit, ListOrder order = ListOrder::NAME);
 
     // ==================== SUSPECT MANAGEMENT ====================
     bool addSuspect(const std::string& name, const std::string& background, 
@@ -69,12 +154,18 @@ public:
     bool updateSuspect(const std::string& name, const std::string& newBackground, 
                        const std::string& newStory, int newAge, 
                        const std::string& newOccupation);
+    // Investigation fields, all set as given. Alibi strength and status
+    // recompute the suspicion level; a suspicionLevel >= 0 then overrides it.
+    bool updateSuspectAssessment(const std::string& name, const std::string& motive,
+                                 const std::string& alibi, AlibiStrength alibiStrength,
+                                 SuspectStatus status, double suspicionLevel = -1.0);
     Suspect* findSuspect(const std::string& name);
     Suspect* findSuspectById(int id);
     std::vector<Suspect*> getAllSuspects();
     std::vector<Suspect*> findSuspectsByStatus(SuspectStatus status);
     std::vector<Suspect*> findSuspectsBySuspicionRange(double minLevel, double maxLevel);
     std::vector<Suspect*> searchSuspects(const std::string& keyword);
+    std::vector<Suspect*> listSuspects(const std::string& after, size_t limit, ListOrder order = ListOrder::NAME);
 
     // ==================== CHARACTER MANAGEMENT ====================
     bool addCharacter(const std::string& name, CharacterRole role, 
@@ -87,8 +178,13 @@ public:
     std::vector<Character*> getAllCharacters();
     std::vector<Character*> findCharactersByRole(CharacterRole role);
     std::vector<Character*> searchCharacters(const std::string& keyword);
+    std::vector<Character*> listCharacters(const std::string& after, size_t limit, ListOrder order = ListOrder::NAME);
 
     // ==================== RELATIONSHIP MANAGEMENT ====================
+    // Edge types for case links; addRelationship uses the caller's type
+    static constexpr const char* SUSPECT_LINK = "case_suspect";
+    static constexpr const char* CHARACTER_LINK = "case_character";
+
     bool linkSuspectToCase(const std::string& suspectName, const std::string& caseTitle);
     bool unlinkSuspectFromCase(const std::string& suspectName, const std::string& caseTitle);
     bool linkCharacterToCase(const std::string& characterName, const std::string& caseTitle);
@@ -97,7 +193,19 @@ public:
                          const std::string& relationshipType = "related");
     bool removeRelationship(const std::string& entity1, const std::string& entity2);
     std::vector<std::string> getRelationships(const std::string& entity);
+    // The type-filtered overloads take relationship type names; empty means all
+    std::vector<std::string> getRelationships(const std::string& entity, const std::vector<std::string>& types);
+    std::string getRelationshipType(const std::string& entity1, const std::string& entity2) const;
+    std::vector<std::string> getRelationshipTypes() const;
     std::vector<std::string> findPath(const std::string& from, const std::string& to);
+    std::vector<std::string> findPath(const std::string& from, const std::string& to,
+                                      const std::vector<std::string>& types);
+    // Investigation clusters: connected components of the relationship graph
+    bool sameComponent(const std::string& entity1, const std::string& entity2) const;
+    int getComponentSize(const std::string& entity) const;
+    int getComponentCount() const;
+    // Entities that sit on the most shortest paths between others (betweenness)
+    std::vector<std::pair<std::string, double>> getKeyEntities(int count = 10, bool parallel = true) const;
 
     // ==================== ANALYSIS & QUERIES ====================
     std::vector<Suspect*> getSuspectsForCase(const std::string& caseTitle);
@@ -108,11 +216,20 @@ public:
     std::vector<Suspect*> getPrimeSuspects();
     std::vector<Case*> getUnsolvedCases();
     std::vector<Case*> getHighPriorityCases();
+    // Composable filter/join/sort over cases; see case_query.h
+    CaseQuery queryCases();
     
     // Suspicion analysis
     void recalculateAllSuspicionLevels();
     std::vector<Suspect*> getTopSuspects(int count = 5);
-    std::vector<Suspect*> findConnectedSuspects(const std::string& suspectName, int maxDepth = 2);
+    std::vector<Suspect*> findConnectedSuspects(const std::string& suspectName, int maxDepth = 2,
+                                                const std::vector<std::string>& edgeTypes = {});
+    // Everything within maxDepth hops of any seed. Only entities in
+    // traverseTypes are walked through; only those in resultTypes are returned.
+    std::vector<HopResult> findNeighborhood(const std::vector<std::string>& seeds, int maxDepth = 2,
+                                            uint8_t resultTypes = ENTITY_ANY,
+                                            uint8_t traverseTypes = ENTITY_ANY,
+                                            const std::vector<std::string>& edgeTypes = {});
 
     // ==================== STATISTICS ====================
     struct Statistics {
@@ -132,11 +249,64 @@ public:
     Statistics getStatistics();
     void printStatistics();
 
+    // Call counts and latency percentiles per instrumented method (merged
+    // over all calling threads), plus container sizes
+    struct Metrics {
+        std::vector<OperationMetrics> operations;
+        size_t cases;
+        size_t suspects;
+        size_t characters;
+        size_t graphNodes;
+        size_t graphEdges;
+        size_t threads;     // threads that have called an instrumented method
+    };
+
+    Metrics getMetrics();
+    void resetMetrics();
+
     // ==================== DATA INTEGRITY ====================
     bool validateData();
     std::vector<std::string> getDataIssues();
     void rebuildAllConnections();
 
+    // ==================== CHANGE FEED ====================
+    // Bumped by every mutation. changesSince() lists what changed after the
+    // given version, or sets fullSync if those events are no longer held.
+    uint64_t getVersion() const;
+    ChangeSet changesSince(uint64_t version) const;
+
+    // ==================== PERSISTENCE ====================
+    // Binary snapshot of all entities, the relationship graph and ID counters.
+    // Loading reads characters and the graph; cases and suspects are decoded
+    // from the file as they are first needed, so it must not be modified in
+    // place meanwhile (saveSnapshot replaces files by renaming). With
+    // mapStrings entity text points into the file rather than being copied,
+    // and the mapping stays open while any of that text is in use.
+    // verifyChecksum checks the whole file's CRC up front; without it, damaged
+    // text or numbers load silently. Durable storage always verifies.
+    bool saveSnapshot(const std::string& path);
+    bool loadSnapshot(const std::string& path, bool mapStrings = false, bool verifyChecksum = false);
+
+    // Text dump: one serialize() record per line, prefixed with CASE|,
+    // SUSPECT| or CHARACTER|. Import keeps the stored IDs.
+    bool exportSerialized(const std::string& path);
+    bool importSerialized(const std::string& path);
+
+    // Parallel CSV/NDJSON loader; see bulk_importer.h for the record format
+    ImportReport bulkImport(const std::string& path, const ImportOptions& options = ImportOptions());
+
+    // Opens (or creates) a durable store: loads its snapshot, replays the log
+    // and logs every later mutation. Replaces the current engine contents
+    // unless the directory is new, in which case they become the base snapshot.
+    // If the log cannot be written, mutators return false until it is reopened.
+    bool openDurable(const std::string& directory, WalSyncPolicy policy = WalSyncPolicy::ALWAYS);
+    void closeDurable();
+    bool isDurable() const;
+    bool syncLog();
+    // Folds sealed log segments into a fresh snapshot on a background thread
+    bool compactLog();
+    void waitForCompaction();
+
     // ==================== UTILITY METHODS ====================
     void displayAllData();
     void displayCaseNetwork(const std::string& caseTitle);
@@ -144,6 +314,8 @@ public:
     
     // Debug
     void printDebugInfo();
+
+    friend class BulkImporter;
 };
 
 #endif // ENGINE_H
\ No newline at end of file
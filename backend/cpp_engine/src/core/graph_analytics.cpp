@@ -0,0 +1,390 @@
+#include "graph_analytics.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+
+namespace {
+
+constexpr size_t NODE_GRAIN = 2048;
+
+// Incoming adjacency in the same CSR layout, for bottom-up BFS steps
+struct ReverseCsr {
+    std::vector<int> offsets;
+    std::vector<int> sources;
+};
+
+ReverseCsr buildReverse(const Graph::DenseView& view) {
+    int n = view.nodeCount();
+    ReverseCsr reverse;
+    reverse.offsets.assign(n + 1, 0);
+    reverse.sources.resize(view.targets.size());
+
+    for (int target : view.targets) reverse.offsets[target + 1]++;
+    for (int i = 0; i < n; i++) reverse.offsets[i + 1] += reverse.offsets[i];
+
+    std::vector<int> fill(reverse.offsets.begin(), reverse.offsets.end() - 1);
+    for (int u = 0; u < n; u++) {
+        for (int e = view.offsets[u]; e < view.offsets[u + 1]; e++) {
+            reverse.sources[fill[view.targets[e]]++] = u;
+        }
+    }
+    return reverse;
+}
+
+int outDegree(const Graph::DenseView& view, int node) {
+    return view.offsets[node + 1] - view.offsets[node];
+}
+
+// Lowers target to value if it is smaller; returns whether it did
+bool atomicMin(std::atomic<int>& target, int value) {
+    int current = target.load(std::memory_order_relaxed);
+    while (value < current) {
+        if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+void appendLocked(std::mutex& mutex, std::vector<int>& out, const std::vector<int>& local) {
+    if (local.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    out.insert(out.end(), local.begin(), local.end());
+}
+
+}
+
+GraphAnalytics::GraphAnalytics(WorkStealingPool& pool) : pool(pool) {}
+
+void GraphAnalytics::forRange(ExecutionMode mode, size_t count, size_t grain,
+                              const std::function<void(size_t, size_t)>& body) const {
+    if (mode == ExecutionMode::SERIAL || pool.getThreadCount() <= 1) {
+        if (count > 0) body(0, count);
+        return;
+    }
+    pool.parallelFor(count, grain, body);
+}
+
+// ==================== BFS ====================
+
+std::vector<int> GraphAnalytics::bfsLevels(const Graph::DenseView& view, int source,
+                                           const BfsOptions& options) const {
+    int n = view.nodeCount();
+    if (source < 0 || source >= n) return std::vector<int>(n, -1);
+
+    std::vector<std::atomic<int>> level(n);
+    forRange(options.mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) level[i].store(-1, std::memory_order_relaxed);
+    });
+
+    ReverseCsr reverse;
+    std::vector<char> inFrontier;
+    if (options.directionOptimizing) {
+        reverse = buildReverse(view);
+        inFrontier.assign(n, 0);
+    }
+
+    level[source].store(0, std::memory_order_relaxed);
+    std::vector<int> frontier{source};
+    long long unexploredEdges = static_cast<long long>(view.targets.size()) - outDegree(view, source);
+    bool bottomUp = false;
+    int depth = 0;
+    std::mutex mergeMutex;
+
+    while (!frontier.empty()) {
+        if (options.directionOptimizing) {
+            if (!bottomUp) {
+                long long frontierEdges = 0;
+                for (int u : frontier) frontierEdges += outDegree(view, u);
+                bottomUp = frontierEdges > unexploredEdges / std::max(1, options.alpha);
+            } else {
+                bottomUp = static_cast<long long>(frontier.size()) >= n / std::max(1, options.beta);
+            }
+        }
+
+        std::vector<int> next;
+        if (bottomUp) {
+            // Every unvisited node looks for any parent in the frontier; each
+            // node is written only by the chunk that owns it
+            for (int u : frontier) inFrontier[u] = 1;
+            forRange(options.mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+                std::vector<int> local;
+                for (size_t v = begin; v < end; v++) {
+                    if (level[v].load(std::memory_order_relaxed) != -1) continue;
+                    for (int e = reverse.offsets[v]; e < reverse.offsets[v + 1]; e++) {
+                        if (inFrontier[reverse.sources[e]]) {
+                            level[v].store(depth + 1, std::memory_order_relaxed);
+                            local.push_back(static_cast<int>(v));
+                            break;
+                        }
+                    }
+                }
+                appendLocked(mergeMutex, next, local);
+            });
+            for (int u : frontier) inFrontier[u] = 0;
+        } else {
+            // Frontier nodes push to their children; the CAS picks one discoverer
+            forRange(options.mode, frontier.size(), 64, [&](size_t begin, size_t end) {
+                std::vector<int> local;
+                for (size_t i = begin; i < end; i++) {
+                    int u = frontier[i];
+                    for (int e = view.offsets[u]; e < view.offsets[u + 1]; e++) {
+                        int v = view.targets[e];
+                        int expected = -1;
+                        if (level[v].load(std::memory_order_relaxed) == -1 &&
+                            level[v].compare_exchange_strong(expected, depth + 1, std::memory_order_relaxed)) {
+                            local.push_back(v);
+                        }
+                    }
+                }
+                appendLocked(mergeMutex, next, local);
+            });
+        }
+
+        for (int v : next) unexploredEdges -= outDegree(view, v);
+        frontier.swap(next);
+        depth++;
+    }
+
+    std::vector<int> result(n);
+    for (int i = 0; i < n; i++) result[i] = level[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+// ==================== CONNECTED COMPONENTS ====================
+
+std::vector<int> GraphAnalytics::componentLabels(const Graph::DenseView& view, ComponentAlgorithm algorithm,
+                                                 ExecutionMode mode) const {
+    int n = view.nodeCount();
+    std::vector<std::atomic<int>> parent(n);
+    forRange(mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) parent[i].store(static_cast<int>(i), std::memory_order_relaxed);
+    });
+
+    // Path halving until every node points straight at its root
+    auto compress = [&]() {
+        forRange(mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t u = begin; u < end; u++) {
+                int p = parent[u].load(std::memory_order_relaxed);
+                int gp;
+                while (p != (gp = parent[p].load(std::memory_order_relaxed))) {
+                    parent[u].store(gp, std::memory_order_relaxed);
+                    p = gp;
+                }
+            }
+        });
+    };
+
+    if (algorithm == ComponentAlgorithm::LABEL_PROPAGATION) {
+        // Both ends of an edge take the smaller label until nothing changes
+        std::atomic<bool> changed(true);
+        while (changed.load()) {
+            changed = false;
+            forRange(mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+                bool localChange = false;
+                for (size_t u = begin; u < end; u++) {
+                    for (int e = view.offsets[u]; e < view.offsets[u + 1]; e++) {
+                        int v = view.targets[e];
+                        int lu = parent[u].load(std::memory_order_relaxed);
+                        int lv = parent[v].load(std::memory_order_relaxed);
+                        if (lu < lv) localChange |= atomicMin(parent[v], lu);
+                        else if (lv < lu) localChange |= atomicMin(parent[u], lv);
+                    }
+                }
+                if (localChange) changed = true;
+            });
+            compress();
+        }
+    } else {
+        // Roots are only ever hung below a smaller root, so each component
+        // ends up labelled by its smallest id, as with label propagation
+        auto link = [&](int u, int v) {
+            int p1 = parent[u].load(std::memory_order_relaxed);
+            int p2 = parent[v].load(std::memory_order_relaxed);
+            while (p1 != p2) {
+                int high = std::max(p1, p2);
+                int low = std::min(p1, p2);
+                int highParent = parent[high].load(std::memory_order_relaxed);
+                if (highParent == low) break;
+                if (highParent == high) {
+                    int expected = high;
+                    if (parent[high].compare_exchange_strong(expected, low, std::memory_order_relaxed)) break;
+                }
+                p1 = parent[parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+                p2 = parent[low].load(std::memory_order_relaxed);
+            }
+        };
+
+        const int sampledNeighbors = 2;
+        for (int round = 0; round < sampledNeighbors; round++) {
+            forRange(mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+                for (size_t u = begin; u < end; u++) {
+                    int e = view.offsets[u] + round;
+                    if (e < view.offsets[u + 1]) link(static_cast<int>(u), view.targets[e]);
+                }
+            });
+            compress();
+        }
+
+        // Guess the dominant component from a fixed sample
+        int dominant = -1;
+        if (n > 0) {
+            std::unordered_map<int, int> counts;
+            std::mt19937 rng(27491095);
+            std::uniform_int_distribution<int> pick(0, n - 1);
+            int best = 0;
+            for (int i = 0; i < 1024; i++) {
+                int label = parent[pick(rng)].load(std::memory_order_relaxed);
+                int count = ++counts[label];
+                if (count > best) {
+                    best = count;
+                    dominant = label;
+                }
+            }
+        }
+
+        // Remaining edges. Inside the dominant component only those leaving it
+        // matter; edges are directed, so its members still have to check.
+        forRange(mode, n, NODE_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t u = begin; u < end; u++) {
+                bool inDominant = parent[u].load(std::memory_order_relaxed) == dominant;
+                for (int e = view.offsets[u] + sampledNeighbors; e < view.offsets[u + 1]; e++) {
+                    int v = view.targets[e];
+                    if (inDominant && parent[v].load(std::memory_order_relaxed) == dominant) continue;
+                    link(static_cast<int>(u), v);
+                }
+            }
+        });
+        compress();
+    }
+
+    std::vector<int> labels(n);
+    for (int i = 0; i < n; i++) labels[i] = parent[i].load(std::memory_order_relaxed);
+    return labels;
+}
+
+// ==================== CENTRALITY ====================
+
+std::vector<double> GraphAnalytics::betweenness(const Graph::DenseView& view,
+                                                const CentralityOptions& options) const {
+    int n = view.nodeCount();
+    std::vector<double> scores(n, 0.0);
+    if (n == 0) return scores;
+
+    // Sampled sources are spread evenly over the id range and scaled back up
+    std::vector<int> sources;
+    if (options.sampleSources == 0 || options.sampleSources >= static_cast<size_t>(n)) {
+        sources.resize(n);
+        for (int i = 0; i < n; i++) sources[i] = i;
+    } else {
+        for (size_t i = 0; i < options.sampleSources; i++) {
+            sources.push_back(static_cast<int>(i * n / options.sampleSources));
+        }
+    }
+    double scale = static_cast<double>(n) / sources.size();
+
+    std::mutex mergeMutex;
+    size_t grain = std::max<size_t>(1, sources.size() / (pool.getThreadCount() * 4));
+
+    forRange(options.mode, sources.size(), grain, [&](size_t begin, size_t end) {
+        std::vector<double> local(n, 0.0), sigma(n, 0.0), delta(n, 0.0);
+        std::vector<int> dist(n, -1);
+        std::vector<int> order;
+        order.reserve(n);
+
+        for (size_t i = begin; i < end; i++) {
+            int s = sources[i];
+            order.clear();
+            order.push_back(s);
+            dist[s] = 0;
+            sigma[s] = 1.0;
+
+            for (size_t head = 0; head < order.size(); head++) {
+                int v = order[head];
+                for (int e = view.offsets[v]; e < view.offsets[v + 1]; e++) {
+                    int w = view.targets[e];
+                    if (dist[w] < 0) {
+                        dist[w] = dist[v] + 1;
+                        order.push_back(w);
+                    }
+                    if (dist[w] == dist[v] + 1) sigma[w] += sigma[v];
+                }
+            }
+
+            // Reverse BFS order: successors are final before their parents
+            for (size_t k = order.size(); k-- > 0;) {
+                int v = order[k];
+                double dependency = 0.0;
+                for (int e = view.offsets[v]; e < view.offsets[v + 1]; e++) {
+                    int w = view.targets[e];
+                    if (dist[w] == dist[v] + 1) dependency += sigma[v] / sigma[w] * (1.0 + delta[w]);
+                }
+                delta[v] = dependency;
+                if (v != s) local[v] += dependency;
+            }
+
+            for (int v : order) {
+                dist[v] = -1;
+                sigma[v] = 0.0;
+                delta[v] = 0.0;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        for (int v = 0; v < n; v++) scores[v] += local[v];
+    });
+
+    if (scale != 1.0) {
+        for (double& score : scores) score *= scale;
+    }
+    return scores;
+}
+
+// ==================== NAME-LEVEL WRAPPERS ====================
+
+std::unordered_map<std::string, int> GraphAnalytics::bfsDistances(const Graph& graph, const std::string& source,
+                                                                  const BfsOptions& options) const {
+    std::unordered_map<std::string, int> result;
+    auto view = graph.getDenseView();
+    auto it = view->ids.find(source);
+    if (it == view->ids.end()) return result;
+
+    std::vector<int> levels = bfsLevels(*view, it->second, options);
+    for (int i = 0; i < view->nodeCount(); i++) {
+        if (levels[i] >= 0) result.emplace(view->names[i], levels[i]);
+    }
+    return result;
+}
+
+std::vector<std::vector<std::string>> GraphAnalytics::connectedComponents(const Graph& graph,
+                                                                          ComponentAlgorithm algorithm,
+                                                                          ExecutionMode mode) const {
+    std::vector<std::vector<std::string>> result;
+    auto view = graph.getDenseView();
+    std::vector<int> labels = componentLabels(*view, algorithm, mode);
+
+    // Labels are the smallest id in each component, so first sight is name order
+    std::vector<int> slotForLabel(view->nodeCount(), -1);
+    for (int i = 0; i < view->nodeCount(); i++) {
+        int& slot = slotForLabel[labels[i]];
+        if (slot < 0) {
+            slot = static_cast<int>(result.size());
+            result.emplace_back();
+        }
+        result[slot].push_back(view->names[i]);
+    }
+    return result;
+}
+
+std::vector<std::pair<std::string, double>> GraphAnalytics::rankByBetweenness(const Graph& graph,
+                                                                              const CentralityOptions& options) const {
+    auto view = graph.getDenseView();
+    std::vector<double> scores = betweenness(*view, options);
+
+    std::vector<std::pair<std::string, double>> ranked;
+    ranked.reserve(scores.size());
+    for (int i = 0; i < view->nodeCount(); i++) ranked.emplace_back(view->names[i], scores[i]);
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    return ranked;
+}
@@ -0,0 +1,79 @@
+#ifndef GRAPH_ANALYTICS_H
+#define GRAPH_ANALYTICS_H
+
+#include "../data_structures/graph.h"
+#include "work_stealing_pool.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Multi-core versions of the heavier Graph algorithms.
+//
+// Kernels run on the graph's dense view (CSR over ids 0..V-1), never on the
+// string-keyed adjacency, and every call picks its own execution mode so a
+// caller can compare a kernel against itself on one thread. Results do not
+// depend on the mode or the number of workers (betweenness only up to
+// floating-point rounding).
+
+enum class ExecutionMode {
+    SERIAL,     // run the kernel on the calling thread
+    PARALLEL    // spread it over the pool
+};
+
+enum class ComponentAlgorithm {
+    // Repeated min-label exchange over every edge. Simple, but needs about
+    // one round per unit of diameter, so long chains are slow.
+    LABEL_PROPAGATION,
+    // Lock-free union-find. Links a couple of sampled neighbours per node,
+    // finds the dominant component, then only does full work outside it.
+    AFFOREST
+};
+
+struct BfsOptions {
+    ExecutionMode mode = ExecutionMode::PARALLEL;
+    // Switch to bottom-up steps while the frontier is large (Beamer et al.)
+    bool directionOptimizing = true;
+    int alpha = 14;     // go bottom-up once frontier edges > unexplored edges / alpha
+    int beta = 24;      // go back top-down once frontier nodes < V / beta
+};
+
+struct CentralityOptions {
+    ExecutionMode mode = ExecutionMode::PARALLEL;
+    size_t sampleSources = 0;   // 0 = exact (every node is a source)
+};
+
+class GraphAnalytics {
+private:
+    WorkStealingPool& pool;
+
+    void forRange(ExecutionMode mode, size_t count, size_t grain,
+                  const std::function<void(size_t, size_t)>& body) const;
+
+public:
+    explicit GraphAnalytics(WorkStealingPool& pool);
+
+    // Dense-id kernels. Edges are followed in their stored direction, except
+    // for components, which are weak (direction ignored).
+    std::vector<int> bfsLevels(const Graph::DenseView& view, int source,
+                               const BfsOptions& options = BfsOptions()) const;
+    std::vector<int> componentLabels(const Graph::DenseView& view, ComponentAlgorithm algorithm,
+                                     ExecutionMode mode = ExecutionMode::PARALLEL) const;
+    // Brandes betweenness over unweighted shortest paths. Ordered pairs are
+    // counted, so on a symmetric graph each path contributes twice.
+    std::vector<double> betweenness(const Graph::DenseView& view,
+                                    const CentralityOptions& options = CentralityOptions()) const;
+
+    // Name-level wrappers
+    std::unordered_map<std::string, int> bfsDistances(const Graph& graph, const std::string& source,
+                                                      const BfsOptions& options = BfsOptions()) const;
+    // Same grouping and order as Graph::findConnectedComponents()
+    std::vector<std::vector<std::string>> connectedComponents(const Graph& graph,
+                                                              ComponentAlgorithm algorithm = ComponentAlgorithm::AFFOREST,
+                                                              ExecutionMode mode = ExecutionMode::PARALLEL) const;
+    // Highest score first, ties by name
+    std::vector<std::pair<std::string, double>> rankByBetweenness(const Graph& graph,
+                                                                  const CentralityOptions& options = CentralityOptions()) const;
+};
+
+#endif // GRAPH_ANALYTICS_H
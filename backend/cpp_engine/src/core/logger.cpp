@@ -0,0 +1,192 @@
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+namespace {
+    constexpr size_t RING_MASK = Logger::RING_SIZE - 1;
+    static_assert((Logger::RING_SIZE & RING_MASK) == 0, "RING_SIZE must be a power of two");
+
+    // Drain thread naps this long when idle; producers only wake it when
+    // they catch it asleep, so a missed wakeup costs at most one nap
+    constexpr auto IDLE_WAIT = std::chrono::milliseconds(50);
+
+    const char* levelTag(LogLevel level) {
+        switch (level) {
+            case LogLevel::VERBOSE: return "[DEBUG] ";
+            case LogLevel::INFO: return "[INFO] ";
+            case LogLevel::WARNING: return "[WARNING] ";
+            case LogLevel::ERROR: return "[ERROR] ";
+            default: return "";
+        }
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : ring(new Slot[RING_SIZE]), enqueuePos(0), dequeuePos(0), written(0), dropped(0),
+      droppedReported(0), synchronous(false), sleeping(false), flushRequested(false), stopping(false) {
+    for (size_t i = 0; i < RING_SIZE; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    drainThread = std::thread(&Logger::drainLoop, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    drainThread.join();
+    delete[] ring;
+}
+
+bool Logger::push(LogLevel level, const char* text, size_t length) {
+    // Bounded multi-producer queue: claim a position, fill the slot, then
+    // publish it by advancing its sequence
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &ring[pos & RING_MASK];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->time = static_cast<int64_t>(std::time(nullptr));
+    slot->level = level;
+    slot->length = static_cast<uint16_t>(length);
+    std::memcpy(slot->text, text, length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    if (synchronous.load(std::memory_order_relaxed)) {
+        flush();
+    } else if (sleeping.load(std::memory_order_acquire)) {
+        wake.notify_one();
+    }
+    return true;
+}
+
+void Logger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex);
+    flushRequested = true;
+    wake.notify_one();
+    drained.wait(lock, [&] { return written.load(std::memory_order_acquire) >= target; });
+}
+
+bool Logger::hasPending() const {
+    const Slot& slot = ring[dequeuePos & RING_MASK];
+    return slot.sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+}
+
+void Logger::drainLoop() {
+    std::string out;
+    int64_t stampTime = -1;
+    char stamp[32] = "";
+
+    for (;;) {
+        out.clear();
+        size_t count = 0;
+
+        while (hasPending()) {
+            Slot& slot = ring[dequeuePos & RING_MASK];
+            if (slot.time != stampTime) {
+                stampTime = slot.time;
+                std::time_t t = static_cast<std::time_t>(slot.time);
+                std::tm local{};
+#ifdef _WIN32
+                localtime_s(&local, &t);
+#else
+                localtime_r(&t, &local);
+#endif
+                std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+            }
+
+            std::string line;
+            line.reserve(slot.length + 40);
+            line += levelTag(slot.level);
+            line += stamp;
+            line += " - ";
+            line.append(slot.text, slot.length);
+            line += '\n';
+
+            if (slot.level == LogLevel::ERROR) {
+                // Keep stdout and stderr lines in order
+                std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+                std::cout.flush();
+                out.clear();
+                std::cerr << line;
+            } else {
+                out += line;
+            }
+
+            slot.sequence.store(dequeuePos + RING_SIZE, std::memory_order_release);
+            dequeuePos++;
+            count++;
+        }
+
+        uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+        if (droppedNow != droppedReported) {
+            out += "[WARNING] ";
+            out += stamp;
+            out += " - " + std::to_string(droppedNow - droppedReported) + " log messages dropped (queue full)\n";
+            droppedReported = droppedNow;
+        }
+
+        if (!out.empty()) {
+            std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+            std::cout.flush();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (count > 0) {
+            written.fetch_add(count, std::memory_order_release);
+            drained.notify_all();
+            continue;
+        }
+        if (stopping) break;
+
+        flushRequested = false;
+        sleeping.store(true, std::memory_order_release);
+        wake.wait_for(lock, IDLE_WAIT, [&] { return stopping || flushRequested || hasPending(); });
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+void LogLine::append(const char* text, size_t size) {
+    size_t room = Logger::MESSAGE_CAPACITY - length;
+    if (size > room) {
+        size = room;
+        truncated = true;
+    }
+    std::memcpy(buffer + length, text, size);
+    length += size;
+}
+
+LogLine& LogLine::operator<<(double value) {
+    char digits[32];
+    int n = std::snprintf(digits, sizeof(digits), "%.2f", value);
+    if (n > 0) append(digits, std::min(static_cast<size_t>(n), sizeof(digits) - 1));
+    return *this;
+}
+
+void LogLine::submit() {
+    if (truncated) std::memcpy(buffer + Logger::MESSAGE_CAPACITY - 3, "...", 3);
+    Logger::instance().push(level, buffer, length);
+}
@@ -0,0 +1,184 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Leveled, asynchronous logging for the engine.
+//
+// Callers format into a fixed stack buffer and push it onto a lock-free ring;
+// a background thread drains the ring and writes whole batches to stdout
+// (stderr for errors), so a mutator never waits on terminal I/O. When the
+// ring is full the message is dropped and counted rather than blocking.
+//
+// Two filters run before any formatting:
+//   - WHODUNNIT_LOG_LEVEL (0 = VERBOSE .. 4 = NONE) compiles out the LOG_*
+//     calls below it, arguments included;
+//   - Logger::setLevel() skips the rest at run time for one atomic load.
+
+// Not DEBUG: builds are allowed to define DEBUG as a macro
+enum class LogLevel : uint8_t {
+    VERBOSE = 0,
+    INFO,
+    WARNING,
+    ERROR,
+    NONE
+};
+
+#ifndef WHODUNNIT_LOG_LEVEL
+#ifdef DEBUG
+#define WHODUNNIT_LOG_LEVEL 0
+#else
+#define WHODUNNIT_LOG_LEVEL 1
+#endif
+#endif
+
+class Logger {
+public:
+    // Longer messages are cut and end in "..."
+    static constexpr size_t MESSAGE_CAPACITY = 232;
+    static constexpr size_t RING_SIZE = 4096;   // power of two
+
+    static Logger& instance();
+
+    // Runtime threshold; defaults to INFO
+    static bool enabled(LogLevel level) {
+        return static_cast<uint8_t>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level) {
+        minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+    static LogLevel getLevel() { return static_cast<LogLevel>(minLevel.load(std::memory_order_relaxed)); }
+
+    // Queue one message; false if the ring was full and it was dropped
+    bool push(LogLevel level, const char* text, size_t length);
+
+    // Block until everything queued so far has been written
+    void flush();
+
+    // Synchronous mode flushes after every message, for callers that
+    // interleave their own std::cout output with the engine's (the CLI demo)
+    void setSynchronous(bool enabled) { synchronous.store(enabled, std::memory_order_relaxed); }
+
+    uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        int64_t time;       // seconds since the epoch
+        LogLevel level;
+        uint16_t length;
+        char text[MESSAGE_CAPACITY];
+    };
+
+    static inline std::atomic<uint8_t> minLevel{static_cast<uint8_t>(LogLevel::INFO)};
+
+    Slot* ring;
+    std::atomic<size_t> enqueuePos;
+    size_t dequeuePos;                  // drain thread only
+    std::atomic<size_t> written;        // messages written so far
+    std::atomic<uint64_t> dropped;
+    uint64_t droppedReported;           // drain thread only
+    std::atomic<bool> synchronous;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::atomic<bool> sleeping;
+    bool flushRequested;
+    bool stopping;
+    std::thread drainThread;
+
+    Logger();
+    ~Logger();
+
+    bool hasPending() const;
+    void drainLoop();
+};
+
+// One message being formatted on the caller's stack. Strings, characters,
+// integers and bools print as usual; floating point prints with two decimals.
+class LogLine {
+private:
+    LogLevel level;
+    size_t length;
+    bool truncated;
+    char buffer[Logger::MESSAGE_CAPACITY];
+
+    void append(const char* text, size_t size);
+
+public:
+    explicit LogLine(LogLevel level) : level(level), length(0), truncated(false) {}
+
+    LogLine& operator<<(std::string_view text) { append(text.data(), text.size()); return *this; }
+    LogLine& operator<<(const char* text) { return *this << std::string_view(text); }
+    LogLine& operator<<(const std::string& text) { append(text.data(), text.size()); return *this; }
+    LogLine& operator<<(char c) { append(&c, 1); return *this; }
+    LogLine& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogLine& operator<<(double value);
+
+    template <typename I, typename = std::enable_if_t<std::is_integral_v<I>>>
+    LogLine& operator<<(I value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        append(digits, static_cast<size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    void submit();
+};
+
+#define WHODUNNIT_LOG(level, message)                   \
+    do {                                                \
+        if (Logger::enabled(level)) {                   \
+            LogLine whodunnitLogLine(level);            \
+            whodunnitLogLine << message;                \
+            whodunnitLogLine.submit();                  \
+        }                                               \
+    } while (0)
+
+// Compiled-out calls are still type-checked but never evaluated
+#define WHODUNNIT_LOG_DISCARD(level, message)           \
+    do {                                                \
+        if (false) {                                    \
+            LogLine whodunnitLogLine(level);            \
+            whodunnitLogLine << message;                \
+        }                                               \
+    } while (0)
+
+#if WHODUNNIT_LOG_LEVEL <= 0
+#define LOG_VERBOSE(message) WHODUNNIT_LOG(LogLevel::VERBOSE, message)
+#else
+#define LOG_VERBOSE(message) WHODUNNIT_LOG_DISCARD(LogLevel::VERBOSE, message)
+#endif
+
+#if WHODUNNIT_LOG_LEVEL <= 1
+#define LOG_INFO(message) WHODUNNIT_LOG(LogLevel::INFO, message)
+#else
+#define LOG_INFO(message) WHODUNNIT_LOG_DISCARD(LogLevel::INFO, message)
+#endif
+
+#if WHODUNNIT_LOG_LEVEL <= 2
+#define LOG_WARNING(message) WHODUNNIT_LOG(LogLevel::WARNING, message)
+#else
+#define LOG_WARNING(message) WHODUNNIT_LOG_DISCARD(LogLevel::WARNING, message)
+#endif
+
+#if WHODUNNIT_LOG_LEVEL <= 3
+#define LOG_ERROR(message) WHODUNNIT_LOG(LogLevel::ERROR, message)
+#else
+#define LOG_ERROR(message) WHODUNNIT_LOG_DISCARD(LogLevel::ERROR, message)
+#endif
+
+#endif // LOGGER_H
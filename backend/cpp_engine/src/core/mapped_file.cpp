@@ -0,0 +1,87 @@
+#include "mapped_file.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : mappedData(nullptr), mappedSize(0), usingMmap(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size == 0) {
+        // mmap rejects empty ranges; an empty file is still a valid open file
+        ::close(fd);
+        mappedData = "";
+        return true;
+    }
+
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr != MAP_FAILED) {
+        mappedData = static_cast<const char*>(addr);
+        mappedSize = static_cast<size_t>(st.st_size);
+        usingMmap = true;
+        return true;
+    }
+#endif
+
+    // Fallback: read the whole file
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    std::streamsize length = file.tellg();
+    file.seekg(0, std::ios::beg);
+    fallbackBuffer.resize(static_cast<size_t>(length));
+    if (length > 0 && !file.read(fallbackBuffer.data(), length)) {
+        fallbackBuffer.clear();
+        return false;
+    }
+
+    mappedData = fallbackBuffer.empty() ? "" : fallbackBuffer.data();
+    mappedSize = fallbackBuffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (usingMmap && mappedData) {
+        munmap(const_cast<char*>(mappedData), mappedSize);
+    }
+#endif
+    fallbackBuffer.clear();
+    fallbackBuffer.shrink_to_fit();
+    mappedData = nullptr;
+    mappedSize = 0;
+    usingMmap = false;
+}
+
+bool MappedFile::isOpen() const {
+    return mappedData != nullptr;
+}
+
+const char* MappedFile::data() const {
+    return mappedData;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
@@ -0,0 +1,32 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Read-only view of a whole file. Uses mmap where the platform has it and
+// falls back to reading the file into memory everywhere else.
+class MappedFile {
+private:
+    const char* mappedData;
+    size_t mappedSize;
+    bool usingMmap;
+    std::vector<char> fallbackBuffer;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+};
+
+#endif // MAPPED_FILE_H
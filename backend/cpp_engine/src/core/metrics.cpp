@@ -0,0 +1,187 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr size_t OP_COUNT = static_cast<size_t>(EngineOp::COUNT);
+
+    std::atomic<uint64_t> nextRegistryId{1};
+
+    // Only the owning thread writes a shard, so a plain load + store is
+    // enough and skips the locked read-modify-write
+    inline void add(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    inline int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#else
+        int bit = 0;
+        while (value >>= 1) bit++;
+        return bit;
+#endif
+    }
+}
+
+const char* engineOpName(EngineOp op) {
+    switch (op) {
+        case EngineOp::ADD_CASE: return "add_case";
+        case EngineOp::ADD_SUSPECT: return "add_suspect";
+        case EngineOp::ADD_CHARACTER: return "add_character";
+        case EngineOp::FIND_CASE: return "find_case";
+        case EngineOp::FIND_SUSPECT: return "find_suspect";
+        case EngineOp::FIND_CHARACTER: return "find_character";
+        case EngineOp::SEARCH_CASES: return "search_cases";
+        case EngineOp::SEARCH_SUSPECTS: return "search_suspects";
+        case EngineOp::SEARCH_CHARACTERS: return "search_characters";
+        case EngineOp::QUERY_CASES: return "query_cases";
+        case EngineOp::FIND_PATH: return "find_path";
+        case EngineOp::FIND_NEIGHBORHOOD: return "find_neighborhood";
+        case EngineOp::GET_STATISTICS: return "get_statistics";
+        default: return "unknown";
+    }
+}
+
+// ==================== HISTOGRAM BUCKETS ====================
+// Values below SUB_BUCKETS get a bucket each; above that, every power of
+// two [2^e, 2^(e+1)) is split into SUB_BUCKETS equal parts
+int LatencyHistogram::bucketFor(uint64_t ns) {
+    if (ns < static_cast<uint64_t>(SUB_BUCKETS)) return static_cast<int>(ns);
+    int exponent = highestBit(ns);
+    if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+    int sub = static_cast<int>(ns >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketLow(int bucket) {
+    if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+    int exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    return (SUB_BUCKETS + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+uint64_t LatencyHistogram::bucketWidth(int bucket) {
+    if (bucket < SUB_BUCKETS) return 1;
+    int exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    return uint64_t(1) << (exponent - SUB_BUCKET_BITS);
+}
+
+// ==================== REGISTRY ====================
+void MetricsRegistry::Shard::clear() {
+    for (OpShard& op : ops) {
+        op.calls.store(0, std::memory_order_relaxed);
+        op.timedCalls.store(0, std::memory_order_relaxed);
+        op.totalNs.store(0, std::memory_order_relaxed);
+        op.maxNs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : op.buckets) bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+MetricsRegistry::MetricsRegistry() : id(nextRegistryId.fetch_add(1, std::memory_order_relaxed)) {}
+
+MetricsRegistry::Shard& MetricsRegistry::localShard() {
+    struct Cached {
+        uint64_t registry = 0;
+        Shard* shard = nullptr;
+    };
+    thread_local Cached cached;
+    if (cached.registry == id) return *cached.shard;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Shard*& shard = shardByThread[std::this_thread::get_id()];
+    if (!shard) {
+        shards.push_back(std::make_unique<Shard>());
+        shard = shards.back().get();
+    }
+    cached.registry = id;
+    cached.shard = shard;
+    return *shard;
+}
+
+void MetricsRegistry::addLatency(OpShard& stats, uint64_t ns) {
+    add(stats.timedCalls, 1);
+    add(stats.totalNs, ns);
+    if (ns > stats.maxNs.load(std::memory_order_relaxed)) stats.maxNs.store(ns, std::memory_order_relaxed);
+    add(stats.buckets[LatencyHistogram::bucketFor(ns)], 1);
+}
+
+void MetricsRegistry::record(EngineOp op, uint64_t ns) {
+    OpShard& stats = localShard().ops[static_cast<size_t>(op)];
+    add(stats.calls, 1);
+    addLatency(stats, ns);
+}
+
+MetricsRegistry::Timer::Timer(MetricsRegistry& registry, EngineOp op)
+    : stats(registry.localShard().ops[static_cast<size_t>(op)]) {
+    uint64_t call = stats.calls.load(std::memory_order_relaxed);
+    stats.calls.store(call + 1, std::memory_order_relaxed);
+    timed = (call & engineOpSampleMask(op)) == 0;
+    if (timed) start = std::chrono::steady_clock::now();
+}
+
+std::vector<OperationMetrics> MetricsRegistry::collect() {
+    std::vector<uint64_t> merged(LatencyHistogram::BUCKET_COUNT);
+    std::vector<OperationMetrics> result;
+    result.reserve(OP_COUNT);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t op = 0; op < OP_COUNT; op++) {
+        std::fill(merged.begin(), merged.end(), 0);
+        uint64_t calls = 0;
+        uint64_t timedCalls = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        for (const auto& shard : shards) {
+            const OpShard& stats = shard->ops[op];
+            calls += stats.calls.load(std::memory_order_relaxed);
+            timedCalls += stats.timedCalls.load(std::memory_order_relaxed);
+            totalNs += stats.totalNs.load(std::memory_order_relaxed);
+            maxNs = std::max(maxNs, stats.maxNs.load(std::memory_order_relaxed));
+            for (int b = 0; b < LatencyHistogram::BUCKET_COUNT; b++) {
+                merged[b] += stats.buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+
+        // Percentiles report the middle of the bucket holding that rank
+        // (never above the recorded maximum)
+        auto percentile = [&](double q) -> double {
+            if (timedCalls == 0) return 0.0;
+            uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(timedCalls)));
+            rank = std::max<uint64_t>(rank, 1);
+            uint64_t seen = 0;
+            for (int b = 0; b < LatencyHistogram::BUCKET_COUNT; b++) {
+                seen += merged[b];
+                if (seen >= rank) {
+                    uint64_t mid = LatencyHistogram::bucketLow(b) + LatencyHistogram::bucketWidth(b) / 2;
+                    return static_cast<double>(std::min(mid, maxNs)) / 1000.0;
+                }
+            }
+            return static_cast<double>(maxNs) / 1000.0;
+        };
+
+        OperationMetrics metrics;
+        metrics.name = engineOpName(static_cast<EngineOp>(op));
+        metrics.calls = calls;
+        metrics.timedCalls = timedCalls;
+        metrics.meanUs = timedCalls ? static_cast<double>(totalNs) / static_cast<double>(timedCalls) / 1000.0 : 0.0;
+        metrics.totalMs = metrics.meanUs * static_cast<double>(calls) / 1000.0;
+        metrics.p50Us = percentile(0.50);
+        metrics.p90Us = percentile(0.90);
+        metrics.p99Us = percentile(0.99);
+        metrics.p999Us = percentile(0.999);
+        metrics.maxUs = static_cast<double>(maxNs) / 1000.0;
+        result.push_back(std::move(metrics));
+    }
+    return result;
+}
+
+size_t MetricsRegistry::threadCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return shards.size();
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& shard : shards) shard->clear();
+}
@@ -0,0 +1,140 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Always-on call counts and latency histograms for engine methods.
+//
+// Each thread records into its own shard with single-writer relaxed
+// stores, so the hot path takes no lock and shares no cache lines with
+// other threads; collect() merges the shards when read. Latencies land in
+// HDR-style log-linear buckets: 16 per power of two (within ~6%), from
+// 1 ns up to about a minute.
+//
+// Reading the clock costs about as much as a hashed name lookup, so the
+// find methods count every call but time only one in 16; their latency
+// figures come from that sample.
+
+// Instrumented methods. Engine-internal calls count too (linking a
+// suspect looks up both names through findSuspect and findCase).
+enum class EngineOp : uint8_t {
+    ADD_CASE,
+    ADD_SUSPECT,
+    ADD_CHARACTER,
+    FIND_CASE,
+    FIND_SUSPECT,
+    FIND_CHARACTER,
+    SEARCH_CASES,
+    SEARCH_SUSPECTS,
+    SEARCH_CHARACTERS,
+    QUERY_CASES,
+    FIND_PATH,
+    FIND_NEIGHBORHOOD,
+    GET_STATISTICS,
+    COUNT
+};
+
+const char* engineOpName(EngineOp op);
+
+// Time one call in (mask + 1); counts stay exact
+constexpr uint64_t engineOpSampleMask(EngineOp op) {
+    return op == EngineOp::FIND_CASE || op == EngineOp::FIND_SUSPECT || op == EngineOp::FIND_CHARACTER ? 15 : 0;
+}
+
+struct OperationMetrics {
+    std::string name;
+    uint64_t calls;
+    uint64_t timedCalls;
+    double totalMs;     // extrapolated from the timed calls when sampled
+    double meanUs;
+    double p50Us;
+    double p90Us;
+    double p99Us;
+    double p999Us;
+    double maxUs;
+};
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 36;     // 2^36 ns is ~69 s; slower calls share the top bucket
+    static constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    static int bucketFor(uint64_t ns);
+    static uint64_t bucketLow(int bucket);      // smallest value the bucket holds
+    static uint64_t bucketWidth(int bucket);
+};
+
+class MetricsRegistry {
+private:
+    struct OpShard {
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> timedCalls;
+        std::atomic<uint64_t> totalNs;
+        std::atomic<uint64_t> maxNs;
+        std::atomic<uint64_t> buckets[LatencyHistogram::BUCKET_COUNT];
+    };
+
+    struct Shard {
+        OpShard ops[static_cast<size_t>(EngineOp::COUNT)];
+        Shard() { clear(); }
+        void clear();
+    };
+
+    // Process-unique, so a thread's cached shard never outlives its
+    // registry even if a new one reuses the address
+    uint64_t id;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+    // Finished threads' IDs can be reused; the new thread then keeps
+    // adding to the old shard, which bounds the shard count
+    std::unordered_map<std::thread::id, Shard*> shardByThread;
+
+    Shard& localShard();
+    static void addLatency(OpShard& stats, uint64_t ns);
+
+public:
+    MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Count one call that took ns
+    void record(EngineOp op, uint64_t ns);
+
+    // One entry per EngineOp, merged over all threads
+    std::vector<OperationMetrics> collect();
+    size_t threadCount();
+    // Counts recorded concurrently with reset() may survive it
+    void reset();
+
+    // Counts a call and, unless it falls outside the op's sample, times
+    // its own scope
+    class Timer {
+    private:
+        OpShard& stats;
+        bool timed;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        Timer(MetricsRegistry& registry, EngineOp op);
+        ~Timer() {
+            if (!timed) return;
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            addLatency(stats, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+    };
+};
+
+#endif // METRICS_H
@@ -0,0 +1,146 @@
+#include "neighborhood_index.h"
+#include <algorithm>
+
+NeighborhoodIndex::NeighborhoodIndex(size_t cacheCapacity)
+    : graphVersion(0), entityGeneration(0), built(false), stamp(0),
+      capacity(cacheCapacity), hits(0), misses(0), rebuilds(0) {}
+
+void NeighborhoodIndex::sync(const Graph& graph, uint64_t generation, const TypeResolver& typeOf) {
+    if (built && graphVersion == graph.getVersion() && entityGeneration == generation) return;
+
+    rebuild(graph, typeOf);
+    graphVersion = graph.getVersion();
+    entityGeneration = generation;
+    built = true;
+}
+
+void NeighborhoodIndex::rebuild(const Graph& graph, const TypeResolver& typeOf) {
+    view = graph.getDenseView();
+    int n = view->nodeCount();
+
+    typedIds.resize(n);
+    for (int i = 0; i < n; i++) {
+        uint32_t type = typeOf(view->names[i]) & ENTITY_ANY;
+        typedIds[i] = static_cast<uint32_t>(i) | (type << TYPE_SHIFT);
+    }
+
+    auto retype = [&](const std::vector<int>& offsets, const std::vector<int>& targets, Adjacency& out) {
+        out.offsets = offsets;
+        out.targets.resize(targets.size());
+        for (size_t e = 0; e < targets.size(); e++) out.targets[e] = typedIds[targets[e]];
+    };
+    retype(view->offsets, view->targets, all);
+    byEdgeType.resize(view->byType.size());
+    for (size_t t = 0; t < byEdgeType.size(); t++) {
+        retype(view->byType[t].offsets, view->byType[t].targets, byEdgeType[t]);
+    }
+
+    seenStamp.assign(n, 0);
+    stamp = 0;
+    invalidate();
+    rebuilds++;
+}
+
+void NeighborhoodIndex::invalidate() {
+    lru.clear();
+    cache.clear();
+}
+
+std::string NeighborhoodIndex::cacheKey(const HopQuery& query) {
+    std::vector<std::string> seeds = query.seeds;
+    std::sort(seeds.begin(), seeds.end());
+    seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+    std::string key = std::to_string(query.maxDepth) + "/" + std::to_string(query.resultTypes) + "/" +
+                      std::to_string(query.traverseTypes) + "/" + std::to_string(query.edgeTypes);
+    for (const auto& seed : seeds) key += "/" + std::to_string(seed.size()) + ":" + seed;
+    return key;
+}
+
+std::vector<HopResult> NeighborhoodIndex::query(const HopQuery& query) {
+    if (capacity == 0) return run(query);
+
+    std::string key = cacheKey(query);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        hits++;
+        lru.splice(lru.begin(), lru, it->second);
+        return *it->second->second;
+    }
+
+    misses++;
+    auto results = std::make_shared<const std::vector<HopResult>>(run(query));
+    lru.emplace_front(key, results);
+    cache[key] = lru.begin();
+    if (lru.size() > capacity) {
+        cache.erase(lru.back().first);
+        lru.pop_back();
+    }
+    return *results;
+}
+
+std::vector<HopResult> NeighborhoodIndex::run(const HopQuery& query) {
+    std::vector<HopResult> results;
+    if (!view || query.maxDepth <= 0) return results;
+
+    if (++stamp == 0) {
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        stamp = 1;
+    }
+
+    std::vector<uint32_t> frontier;
+    for (const auto& seed : query.seeds) {
+        auto it = view->ids.find(seed);
+        if (it == view->ids.end() || seenStamp[it->second] == stamp) continue;
+        seenStamp[it->second] = stamp;
+        frontier.push_back(typedIds[it->second]);
+    }
+
+    // Only the partitions for the requested edge types are scanned
+    std::vector<const Adjacency*> adjacency;
+    Graph::EdgeTypeMask used = byEdgeType.size() >= 64 ? Graph::ALL_EDGE_TYPES
+                                                       : (Graph::EdgeTypeMask(1) << byEdgeType.size()) - 1;
+    if ((query.edgeTypes & used) == used) {
+        adjacency.push_back(&all);
+    } else {
+        for (size_t t = 0; t < byEdgeType.size(); t++) {
+            if (query.edgeTypes & (Graph::EdgeTypeMask(1) << t)) adjacency.push_back(&byEdgeType[t]);
+        }
+    }
+
+    std::vector<uint32_t> found;
+    std::vector<uint32_t> next;
+    for (int depth = 1; depth <= query.maxDepth && !frontier.empty(); depth++) {
+        found.clear();
+        for (uint32_t id : frontier) {
+            uint32_t index = id & INDEX_MASK;
+            for (const Adjacency* adj : adjacency) {
+                for (int e = adj->offsets[index]; e < adj->offsets[index + 1]; e++) {
+                    uint32_t target = adj->targets[e];
+                    uint32_t targetIndex = target & INDEX_MASK;
+                    if (seenStamp[targetIndex] == stamp) continue;
+                    seenStamp[targetIndex] = stamp;
+                    found.push_back(target);
+                }
+            }
+        }
+
+        // Dense indices follow name order, so this makes each level deterministic
+        std::sort(found.begin(), found.end(), [](uint32_t a, uint32_t b) {
+            return (a & INDEX_MASK) < (b & INDEX_MASK);
+        });
+
+        next.clear();
+        for (uint32_t id : found) {
+            uint8_t type = static_cast<uint8_t>(id >> TYPE_SHIFT);
+            if (type & query.resultTypes) results.push_back({view->names[id & INDEX_MASK], type, depth});
+            if (type & query.traverseTypes) next.push_back(id);
+        }
+        frontier.swap(next);
+    }
+    return results;
+}
+
+NeighborhoodIndex::Stats NeighborhoodIndex::getStats() const {
+    return {hits, misses, rebuilds, lru.size()};
+}
@@ -0,0 +1,104 @@
+#ifndef NEIGHBORHOOD_INDEX_H
+#define NEIGHBORHOOD_INDEX_H
+
+#include "../data_structures/graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// k-hop neighbourhood queries over the relationship graph.
+//
+// Nodes are renumbered into typed ids: the dense index in the low bits and
+// the entity type flags in the top bits, so "is this a suspect" during a
+// traversal is a mask test on the id itself. Results are kept in a small
+// LRU cache that is dropped whenever the graph or the set of entities
+// changes.
+
+enum EntityTypeMask : uint8_t {
+    ENTITY_CASE = 1,
+    ENTITY_SUSPECT = 2,
+    ENTITY_CHARACTER = 4,
+    ENTITY_ANY = ENTITY_CASE | ENTITY_SUSPECT | ENTITY_CHARACTER
+};
+
+struct HopQuery {
+    std::vector<std::string> seeds;
+    int maxDepth = 2;
+    uint8_t resultTypes = ENTITY_ANY;      // which entities are returned
+    uint8_t traverseTypes = ENTITY_ANY;    // which entities a path may pass through
+    Graph::EdgeTypeMask edgeTypes = Graph::ALL_EDGE_TYPES;     // which edges may be followed
+};
+
+struct HopResult {
+    std::string name;
+    uint8_t type;
+    int depth;
+};
+
+class NeighborhoodIndex {
+public:
+    // Type flags for a node name; 0 for a bare graph node
+    using TypeResolver = std::function<uint8_t(const std::string&)>;
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t rebuilds;
+        size_t cachedQueries;
+    };
+
+private:
+    static constexpr int TYPE_SHIFT = 29;
+    static constexpr uint32_t INDEX_MASK = (1u << TYPE_SHIFT) - 1;
+
+    // Typed CSR, whole and split by edge type, rebuilt when the stamps below go stale
+    struct Adjacency {
+        std::vector<int> offsets;
+        std::vector<uint32_t> targets;  // typed ids
+    };
+
+    std::shared_ptr<const Graph::DenseView> view;
+    std::vector<uint32_t> typedIds;     // by dense index
+    Adjacency all;
+    std::vector<Adjacency> byEdgeType;
+    uint64_t graphVersion;
+    uint64_t entityGeneration;
+    bool built;
+
+    // Per-node "visited in query N" stamps, so queries never clear or allocate
+    std::vector<uint32_t> seenStamp;
+    uint32_t stamp;
+
+    using ResultList = std::shared_ptr<const std::vector<HopResult>>;
+    size_t capacity;
+    std::list<std::pair<std::string, ResultList>> lru;     // most recent first
+    std::unordered_map<std::string, std::list<std::pair<std::string, ResultList>>::iterator> cache;
+    size_t hits;
+    size_t misses;
+    size_t rebuilds;
+
+    void rebuild(const Graph& graph, const TypeResolver& typeOf);
+    std::vector<HopResult> run(const HopQuery& query);
+    static std::string cacheKey(const HopQuery& query);
+
+public:
+    explicit NeighborhoodIndex(size_t cacheCapacity = 256);
+
+    // Brings the typed ids up to date; cheap when nothing changed
+    void sync(const Graph& graph, uint64_t entityGeneration, const TypeResolver& typeOf);
+
+    // Multi-source BFS from every seed at once. Seeds themselves are not
+    // returned; each result carries its distance from the nearest seed.
+    // Results come in BFS order, ties in name order.
+    std::vector<HopResult> query(const HopQuery& query);
+
+    void invalidate();
+    Stats getStats() const;
+};
+
+#endif // NEIGHBORHOOD_INDEX_H
@@ -0,0 +1,581 @@
+#include "snapshot.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace SnapshotFormat;
+
+namespace {
+    int64_t toNanos(const std::chrono::system_clock::time_point& tp) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+    }
+
+    std::chrono::system_clock::time_point fromNanos(int64_t nanos) {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    // Enum bytes are checked against the last enumerator before the cast
+    template <typename E>
+    E toEnum(uint8_t value, E last, const char* field) {
+        if (value > static_cast<uint8_t>(last)) {
+            throw std::out_of_range(std::string("Snapshot ") + field + " out of range");
+        }
+        return static_cast<E>(value);
+    }
+
+    uint64_t alignUp(uint64_t value) {
+        return (value + 7) & ~uint64_t(7);
+    }
+
+    struct PendingSection {
+        uint32_t type;
+        const void* data;
+        uint64_t size;
+        uint64_t count;
+    };
+
+    template <typename V>
+    PendingSection section(uint32_t type, const V& values) {
+        return {type, values.data(), values.size() * sizeof(typename V::value_type), values.size()};
+    }
+}
+
+// ==================== WRITER ====================
+SnapshotWriter::SnapshotWriter() : nextCaseId(1), nextSuspectId(1), nextCharacterId(1), walLsn(0) {
+    stringOffsets.push_back(0);
+}
+
+uint32_t SnapshotWriter::intern(const std::string& value) {
+    auto it = stringIds.find(value);
+    if (it != stringIds.end()) return it->second;
+
+    uint32_t index = static_cast<uint32_t>(stringOffsets.size() - 1);
+    stringData.append(value);
+    stringOffsets.push_back(stringData.size());
+    stringIds.emplace(value, index);
+    return index;
+}
+
+// Entities copied from one another share pool entries, so the text address
+// is a cheap first check before the value is hashed
+uint32_t SnapshotWriter::intern(const PooledString& value) {
+    auto it = pooledIds.find(value.data());
+    if (it != pooledIds.end() && stringOffsets[it->second + 1] - stringOffsets[it->second] == value.size()) {
+        return it->second;
+    }
+    uint32_t index = intern(value.str());
+    pooledIds[value.data()] = index;
+    return index;
+}
+
+ListRef SnapshotWriter::addIntList(const std::vector<int>& values) {
+    ListRef ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(values.size())};
+    for (int value : values) pool.push_back(static_cast<uint32_t>(value));
+    return ref;
+}
+
+ListRef SnapshotWriter::addStringList(const std::vector<PooledString>& values) {
+    ListRef ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(values.size())};
+    for (const auto& value : values) pool.push_back(intern(value));
+    return ref;
+}
+
+void SnapshotWriter::addCase(const Case& c) {
+    CaseRecord r{};
+    r.dateCreated = toNanos(c.dateCreated);
+    r.dateModified = toNanos(c.dateModified);
+    r.incidentDate = toNanos(c.incidentDate);
+    r.id = c.id;
+    r.title = intern(c.title);
+    r.description = intern(c.description);
+    r.location = intern(c.location);
+    r.solution = intern(c.solution);
+    r.notes = intern(c.notes);
+    r.status = static_cast<uint8_t>(c.status);
+    r.priority = static_cast<uint8_t>(c.priority);
+    r.suspectIds = addIntList(c.suspectIds);
+    r.characterIds = addIntList(c.characterIds);
+    r.evidence = addStringList(c.evidence);
+    r.tags = addStringList(c.tags);
+    caseRecords.push_back(r);
+}
+
+void SnapshotWriter::addSuspect(const Suspect& s) {
+    SuspectRecord r{};
+    r.dateAdded = toNanos(s.dateAdded);
+    r.lastModified = toNanos(s.lastModified);
+    r.suspicionLevel = s.suspicionLevel;
+    r.id = s.id;
+    r.age = s.age;
+    r.name = intern(s.name);
+    r.story = intern(s.story);
+    r.background = intern(s.background);
+    r.motive = intern(s.motive);
+    r.alibi = intern(s.alibi);
+    r.occupation = intern(s.occupation);
+    r.lastKnownLocation = intern(s.lastKnownLocation);
+    r.alibiStrength = static_cast<uint8_t>(s.alibiStrength);
+    r.status = static_cast<uint8_t>(s.status);
+    r.caseIds = addIntList(s.caseIds);
+    r.physicalDescription = addStringList(s.physicalDescription);
+    r.knownAssociates = addStringList(s.knownAssociates);
+    r.evidenceAgainst = addStringList(s.evidenceAgainst);
+    r.evidenceFor = addStringList(s.evidenceFor);
+    suspectRecords.push_back(r);
+}
+
+void SnapshotWriter::addCharacter(const Character& ch) {
+    CharacterRecord r{};
+    r.id = ch.id;
+    r.name = intern(ch.name);
+    r.story = intern(ch.story);
+    r.role = static_cast<uint8_t>(ch.role);
+    r.relatedCases = addIntList(ch.relatedCases);
+    r.knownSuspects = addStringList(ch.knownSuspects);
+    characterRecords.push_back(r);
+}
+
+void SnapshotWriter::setGraph(const Graph& graph) {
+    std::vector<std::string> nodes = graph.getAllNodes();
+    std::unordered_map<std::string, uint32_t> nodeIndex;
+    nodeIndex.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodeIndex[nodes[i]] = static_cast<uint32_t>(i);
+    }
+
+    graphNodes.clear();
+    graphOffsets.assign(1, 0);
+    graphTargets.clear();
+    graphWeights.clear();
+    graphEdgeTypes.clear();
+
+    for (const auto& node : nodes) {
+        graphNodes.push_back(intern(node));
+        for (const auto& neighbor : graph.getNeighbors(node)) {
+            graphTargets.push_back(nodeIndex[neighbor]);
+            graphWeights.push_back(graph.getEdgeWeight(node, neighbor));
+            graphEdgeTypes.push_back(intern(graph.getEdgeType(node, neighbor)));
+        }
+        graphOffsets.push_back(graphTargets.size());
+    }
+}
+
+void SnapshotWriter::setCounters(int caseId, int suspectId, int characterId) {
+    nextCaseId = caseId;
+    nextSuspectId = suspectId;
+    nextCharacterId = characterId;
+}
+
+void SnapshotWriter::setWalLsn(uint64_t lsn) {
+    walLsn = lsn;
+}
+
+bool SnapshotWriter::writeTo(const std::string& path, std::string& error) const {
+    std::vector<uint64_t> walState{walLsn};
+    std::vector<PendingSection> sections = {
+        section(STRING_OFFSETS, stringOffsets),
+        {STRING_DATA, stringData.data(), stringData.size(), stringData.size()},
+        section(U32_POOL, pool),
+        section(CASES, caseRecords),
+        section(SUSPECTS, suspectRecords),
+        section(CHARACTERS, characterRecords),
+        section(GRAPH_NODES, graphNodes),
+        section(GRAPH_OFFSETS, graphOffsets),
+        section(GRAPH_TARGETS, graphTargets),
+        section(GRAPH_WEIGHTS, graphWeights),
+        section(WAL_STATE, walState),
+        section(GRAPH_EDGE_TYPES, graphEdgeTypes)
+    };
+
+    // Lay out the section table
+    std::vector<SectionEntry> table;
+    uint64_t offset = sizeof(Header) + sections.size() * sizeof(SectionEntry);
+    for (const auto& s : sections) {
+        offset = alignUp(offset);
+        table.push_back({s.type, 0, offset, s.size, s.count});
+        offset += s.size;
+    }
+    uint64_t fileSize = alignUp(offset);
+
+    std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        error = "Cannot open " + tmpPath + " for writing";
+        return false;
+    }
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+    header.fileSize = fileSize;
+    header.nextCaseId = nextCaseId;
+    header.nextSuspectId = nextSuspectId;
+    header.nextCharacterId = nextCharacterId;
+
+    // Header is rewritten once the checksum is known
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    static const char padding[8] = {0};
+    uint64_t written = sizeof(Header);
+    uint32_t crc = 0;
+    auto emit = [&](const void* data, uint64_t size) {
+        if (size == 0) return;
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        crc = DetectiveUtils::crc32(data, static_cast<size_t>(size), crc);
+        written += size;
+    };
+
+    emit(table.data(), table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections.size(); i++) {
+        emit(padding, table[i].offset - written);
+        emit(sections[i].data, sections[i].size);
+    }
+    emit(padding, fileSize - written);
+
+    header.checksum = crc;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+
+    if (!out) {
+        error = "Failed writing " + tmpPath;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        error = "Cannot replace " + path;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ==================== READER ====================
+SnapshotReader::SnapshotReader()
+    : header(nullptr), stringOffsets(nullptr), stringData(nullptr), stringCount(0), stringDataSize(0),
+      pool(nullptr), poolSize(0), caseRecords(nullptr), caseCount(0),
+      suspectRecords(nullptr), suspectCount(0), characterRecords(nullptr), characterCount(0),
+      graphNodes(nullptr), graphNodeCount(0), graphOffsets(nullptr), graphTargets(nullptr),
+      graphWeights(nullptr), graphEdgeTypes(nullptr), graphEdgeCount(0), walLsn(0) {
+    file = std::make_shared<MappedFile>();
+    stringsPinned = false;
+}
+
+void SnapshotReader::releaseFile() {
+    pooled.clear();
+    // Pooled text may still point into a pinned mapping and keeps it open
+    if (stringsPinned) {
+        file = std::make_shared<MappedFile>();
+        stringsPinned = false;
+    } else {
+        file->close();
+    }
+}
+
+bool SnapshotReader::fail(const std::string& message) {
+    lastError = message;
+    releaseFile();
+    header = nullptr;
+    return false;
+}
+
+bool SnapshotReader::open(const std::string& path, bool verifyChecksum) {
+    releaseFile();
+    if (!file->open(path)) return fail("Cannot open snapshot: " + path);
+
+    const char* base = file->data();
+    size_t size = file->size();
+    if (size < sizeof(Header)) return fail("Snapshot too small: " + path);
+
+    header = reinterpret_cast<const Header*>(base);
+    if (header->magic != MAGIC) return fail("Not a snapshot file: " + path);
+    if (header->version != VERSION) {
+        return fail("Unsupported snapshot version " + std::to_string(header->version));
+    }
+    if (header->fileSize != size) return fail("Snapshot is truncated: " + path);
+
+    uint64_t tableEnd = sizeof(Header) + uint64_t(header->sectionCount) * sizeof(SectionEntry);
+    if (tableEnd > size) return fail("Corrupt snapshot section table");
+
+    if (verifyChecksum) {
+        uint32_t crc = DetectiveUtils::crc32(base + sizeof(Header), size - sizeof(Header));
+        if (crc != header->checksum) return fail("Snapshot checksum mismatch: " + path);
+    }
+
+    const SectionEntry* table = reinterpret_cast<const SectionEntry*>(base + sizeof(Header));
+    std::unordered_map<uint32_t, const SectionEntry*> byType;
+    for (uint32_t i = 0; i < header->sectionCount; i++) {
+        const SectionEntry& e = table[i];
+        if (e.offset % 8 != 0 || e.offset > size || e.size > size - e.offset) {
+            return fail("Corrupt snapshot section " + std::to_string(e.type));
+        }
+        byType[e.type] = &e;
+    }
+
+    // Resolves a section and checks its byte size against its element count
+    auto resolve = [&](uint32_t type, size_t elemSize, size_t& count) -> const char* {
+        auto it = byType.find(type);
+        if (it == byType.end()) throw std::runtime_error("Missing snapshot section " + std::to_string(type));
+        const SectionEntry* e = it->second;
+        if (e->size != e->count * elemSize) throw std::runtime_error("Corrupt snapshot section " + std::to_string(type));
+        count = static_cast<size_t>(e->count);
+        return base + e->offset;
+    };
+
+    try {
+        size_t offsetCount = 0;
+        stringOffsets = reinterpret_cast<const uint64_t*>(resolve(STRING_OFFSETS, sizeof(uint64_t), offsetCount));
+        if (offsetCount == 0) throw std::runtime_error("Corrupt snapshot string table");
+        stringCount = offsetCount - 1;
+        stringData = resolve(STRING_DATA, 1, stringDataSize);
+        if (stringOffsets[stringCount] > stringDataSize) throw std::runtime_error("Corrupt snapshot string table");
+
+        pool = reinterpret_cast<const uint32_t*>(resolve(U32_POOL, sizeof(uint32_t), poolSize));
+        caseRecords = reinterpret_cast<const CaseRecord*>(resolve(CASES, sizeof(CaseRecord), caseCount));
+        suspectRecords = reinterpret_cast<const SuspectRecord*>(resolve(SUSPECTS, sizeof(SuspectRecord), suspectCount));
+        characterRecords = reinterpret_cast<const CharacterRecord*>(resolve(CHARACTERS, sizeof(CharacterRecord), characterCount));
+
+        size_t graphOffsetCount = 0;
+        size_t weightCount = 0;
+        graphNodes = reinterpret_cast<const uint32_t*>(resolve(GRAPH_NODES, sizeof(uint32_t), graphNodeCount));
+        graphOffsets = reinterpret_cast<const uint64_t*>(resolve(GRAPH_OFFSETS, sizeof(uint64_t), graphOffsetCount));
+        graphTargets = reinterpret_cast<const uint32_t*>(resolve(GRAPH_TARGETS, sizeof(uint32_t), graphEdgeCount));
+        graphWeights = reinterpret_cast<const int32_t*>(resolve(GRAPH_WEIGHTS, sizeof(int32_t), weightCount));
+        if (graphOffsetCount != graphNodeCount + 1 || weightCount != graphEdgeCount ||
+            graphOffsets[graphNodeCount] != graphEdgeCount) {
+            throw std::runtime_error("Corrupt snapshot graph section");
+        }
+
+        graphEdgeTypes = nullptr;
+        if (byType.count(GRAPH_EDGE_TYPES)) {
+            size_t typeCount = 0;
+            graphEdgeTypes = reinterpret_cast<const uint32_t*>(resolve(GRAPH_EDGE_TYPES, sizeof(uint32_t), typeCount));
+            if (typeCount != graphEdgeCount) throw std::runtime_error("Corrupt snapshot graph section");
+        }
+
+        walLsn = 0;
+        if (byType.count(WAL_STATE)) {
+            size_t walCount = 0;
+            const uint64_t* walState = reinterpret_cast<const uint64_t*>(resolve(WAL_STATE, sizeof(uint64_t), walCount));
+            if (walCount > 0) walLsn = walState[0];
+        }
+    } catch (const std::exception& e) {
+        return fail(e.what());
+    }
+
+    lastError.clear();
+    return true;
+}
+
+const std::string& SnapshotReader::getError() const {
+    return lastError;
+}
+
+std::string_view SnapshotReader::getString(uint32_t index) const {
+    if (index >= stringCount) throw std::out_of_range("Snapshot string index out of range");
+    uint64_t begin = stringOffsets[index];
+    uint64_t end = stringOffsets[index + 1];
+    if (begin > end || end > stringDataSize) throw std::out_of_range("Corrupt snapshot string table");
+    return std::string_view(stringData + begin, static_cast<size_t>(end - begin));
+}
+
+// The string table is deduplicated, so each index is pooled once per reader
+PooledString SnapshotReader::getPooledString(uint32_t index) const {
+    std::string_view value = getString(index);
+    if (pooled.size() != stringCount) pooled.resize(stringCount);
+    PooledString& slot = pooled[index];
+    if (slot.empty() && !value.empty()) {
+        slot = stringsPinned ? StringPool::global().internExternal(value, file) : StringPool::global().intern(value);
+    }
+    return slot;
+}
+
+void SnapshotReader::pinStrings() {
+    if (stringsPinned || !header) return;
+    pooled.clear();
+    stringsPinned = true;
+}
+
+std::vector<int> SnapshotReader::readIntList(ListRef ref) const {
+    if (uint64_t(ref.offset) + ref.count > poolSize) throw std::out_of_range("Snapshot list out of range");
+    std::vector<int> result;
+    result.reserve(ref.count);
+    for (uint32_t i = 0; i < ref.count; i++) {
+        result.push_back(static_cast<int>(pool[ref.offset + i]));
+    }
+    return result;
+}
+
+std::vector<PooledString> SnapshotReader::readStringList(ListRef ref) const {
+    if (uint64_t(ref.offset) + ref.count > poolSize) throw std::out_of_range("Snapshot list out of range");
+    std::vector<PooledString> result;
+    result.reserve(ref.count);
+    for (uint32_t i = 0; i < ref.count; i++) {
+        result.push_back(getPooledString(pool[ref.offset + i]));
+    }
+    return result;
+}
+
+size_t SnapshotReader::getCaseCount() const { return caseCount; }
+size_t SnapshotReader::getSuspectCount() const { return suspectCount; }
+size_t SnapshotReader::getCharacterCount() const { return characterCount; }
+
+Case SnapshotReader::getCase(size_t index) const {
+    if (index >= caseCount) throw std::out_of_range("Snapshot case index out of range");
+    const CaseRecord& r = caseRecords[index];
+
+    Case c;
+    c.id = r.id;
+    c.title = std::string(getString(r.title));
+    c.description = getPooledString(r.description);
+    c.location = getPooledString(r.location);
+    c.solution = getPooledString(r.solution);
+    c.notes = getPooledString(r.notes);
+    c.status = toEnum(r.status, CaseStatus::UNSOLVED, "case status");
+    c.priority = toEnum(r.priority, CasePriority::URGENT, "case priority");
+    c.suspectIds = readIntList(r.suspectIds);
+    c.characterIds = readIntList(r.characterIds);
+    c.evidence = readStringList(r.evidence);
+    c.tags = readStringList(r.tags);
+    c.dateCreated = fromNanos(r.dateCreated);
+    c.dateModified = fromNanos(r.dateModified);
+    c.incidentDate = fromNanos(r.incidentDate);
+    return c;
+}
+
+Suspect SnapshotReader::getSuspect(size_t index) const {
+    if (index >= suspectCount) throw std::out_of_range("Snapshot suspect index out of range");
+    const SuspectRecord& r = suspectRecords[index];
+
+    Suspect s;
+    s.id = r.id;
+    s.age = r.age;
+    s.name = std::string(getString(r.name));
+    s.story = getPooledString(r.story);
+    s.background = getPooledString(r.background);
+    s.motive = getPooledString(r.motive);
+    s.alibi = getPooledString(r.alibi);
+    s.occupation = getPooledString(r.occupation);
+    s.lastKnownLocation = getPooledString(r.lastKnownLocation);
+    s.alibiStrength = toEnum(r.alibiStrength, AlibiStrength::CONFIRMED, "alibi strength");
+    s.status = toEnum(r.status, SuspectStatus::ACQUITTED, "suspect status");
+    s.suspicionLevel = r.suspicionLevel;
+    s.caseIds = readIntList(r.caseIds);
+    s.physicalDescription = readStringList(r.physicalDescription);
+    s.knownAssociates = readStringList(r.knownAssociates);
+    s.evidenceAgainst = readStringList(r.evidenceAgainst);
+    s.evidenceFor = readStringList(r.evidenceFor);
+    s.dateAdded = fromNanos(r.dateAdded);
+    s.lastModified = fromNanos(r.lastModified);
+    return s;
+}
+
+Character SnapshotReader::getCharacter(size_t index) const {
+    if (index >= characterCount) throw std::out_of_range("Snapshot character index out of range");
+    const CharacterRecord& r = characterRecords[index];
+
+    Character ch;
+    ch.id = r.id;
+    ch.name = std::string(getString(r.name));
+    ch.story = getPooledString(r.story);
+    ch.role = toEnum(r.role, CharacterRole::OTHER, "character role");
+    ch.relatedCases = readIntList(r.relatedCases);
+    ch.knownSuspects = readStringList(r.knownSuspects);
+    return ch;
+}
+
+size_t SnapshotReader::findCaseIndex(std::string_view title) const {
+    const CaseRecord* end = caseRecords + caseCount;
+    const CaseRecord* it = std::lower_bound(caseRecords, end, title,
+        [&](const CaseRecord& r, std::string_view key) { return getString(r.title) < key; });
+    if (it == end || getString(it->title) != title) return caseCount;
+    return static_cast<size_t>(it - caseRecords);
+}
+
+size_t SnapshotReader::findSuspectIndex(std::string_view name) const {
+    const SuspectRecord* end = suspectRecords + suspectCount;
+    const SuspectRecord* it = std::lower_bound(suspectRecords, end, name,
+        [&](const SuspectRecord& r, std::string_view key) { return getString(r.name) < key; });
+    if (it == end || getString(it->name) != name) return suspectCount;
+    return static_cast<size_t>(it - suspectRecords);
+}
+
+bool SnapshotReader::findCase(std::string_view title, Case& out) const {
+    size_t index = findCaseIndex(title);
+    if (index == caseCount) return false;
+    out = getCase(index);
+    return true;
+}
+
+bool SnapshotReader::findSuspect(std::string_view name, Suspect& out) const {
+    size_t index = findSuspectIndex(name);
+    if (index == suspectCount) return false;
+    out = getSuspect(index);
+    return true;
+}
+
+size_t SnapshotReader::getGraphNodeCount() const { return graphNodeCount; }
+size_t SnapshotReader::getGraphEdgeCount() const { return graphEdgeCount; }
+
+std::string_view SnapshotReader::getGraphNode(size_t index) const {
+    if (index >= graphNodeCount) throw std::out_of_range("Snapshot graph node out of range");
+    return getString(graphNodes[index]);
+}
+
+void SnapshotReader::forEachEdge(std::function<void(std::string_view, std::string_view, int, std::string_view)> fn) const {
+    for (size_t u = 0; u < graphNodeCount; u++) {
+        std::string_view from = getGraphNode(u);
+        uint64_t begin = graphOffsets[u];
+        uint64_t end = graphOffsets[u + 1];
+        if (begin > end || end > graphEdgeCount) throw std::out_of_range("Corrupt snapshot adjacency");
+        for (uint64_t e = begin; e < end; e++) {
+            std::string_view type = graphEdgeTypes ? getString(graphEdgeTypes[e]) : std::string_view();
+            fn(from, getGraphNode(graphTargets[e]), graphWeights[e], type);
+        }
+    }
+}
+
+void SnapshotReader::readGraph(Graph& out) const {
+    std::vector<std::string> nodes;
+    nodes.reserve(graphNodeCount);
+    for (size_t i = 0; i < graphNodeCount; i++) nodes.emplace_back(getGraphNode(i));
+
+    // Type names are string-table indices; give each distinct one a slot
+    std::vector<std::string> types;
+    std::unordered_map<uint32_t, uint32_t> typeSlots;
+    std::vector<IndexedEdge> edgeList;
+    edgeList.reserve(graphEdgeCount);
+    for (size_t u = 0; u < graphNodeCount; u++) {
+        uint64_t begin = graphOffsets[u];
+        uint64_t end = graphOffsets[u + 1];
+        if (begin > end || end > graphEdgeCount) throw std::out_of_range("Corrupt snapshot adjacency");
+        for (uint64_t e = begin; e < end; e++) {
+            uint32_t type = 0;
+            if (graphEdgeTypes) {
+                auto slot = typeSlots.emplace(graphEdgeTypes[e], static_cast<uint32_t>(types.size()));
+                if (slot.second) types.emplace_back(getString(graphEdgeTypes[e]));
+                type = slot.first->second;
+            } else if (types.empty()) {
+                types.emplace_back();
+            }
+            edgeList.push_back({static_cast<uint32_t>(u), graphTargets[e], graphWeights[e], type});
+        }
+    }
+
+    if (!out.assign(nodes, types, edgeList)) throw std::runtime_error("Corrupt snapshot graph section");
+}
+
+int SnapshotReader::getNextCaseId() const { return header ? header->nextCaseId : 1; }
+int SnapshotReader::getNextSuspectId() const { return header ? header->nextSuspectId : 1; }
+int SnapshotReader::getNextCharacterId() const { return header ? header->nextCharacterId : 1; }
+uint64_t SnapshotReader::getWalLsn() const { return walLsn; }
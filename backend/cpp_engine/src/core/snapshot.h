@@ -0,0 +1,248 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "mapped_file.h"
+#include "../models/case.h"
+#include "../models/character.h"
+#include "../models/suspect.h"
+#include "../data_structures/graph.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <functional>
+#include <memory>
+
+// Binary engine snapshot.
+//
+// Layout (little-endian, every section 8-byte aligned):
+//   Header | SectionEntry[sectionCount] | section payloads
+//
+// Text lives once in a deduplicated string table; entities are fixed-width
+// records that refer to it by index. Variable-length lists (IDs, evidence,
+// tags...) are ListRefs into a shared uint32 pool. The relationship graph is
+// stored as CSR adjacency arrays with a type name per edge. The checksum is
+// a CRC-32 over everything after the header.
+namespace SnapshotFormat {
+    constexpr uint32_t MAGIC = 0x50534457;  // "WDSP"
+    constexpr uint32_t VERSION = 1;
+
+    enum SectionType : uint32_t {
+        STRING_OFFSETS = 1,
+        STRING_DATA,
+        U32_POOL,
+        CASES,
+        SUSPECTS,
+        CHARACTERS,
+        GRAPH_NODES,
+        GRAPH_OFFSETS,
+        GRAPH_TARGETS,
+        GRAPH_WEIGHTS,
+        WAL_STATE,      // optional: last log sequence number folded into the snapshot
+        GRAPH_EDGE_TYPES    // optional: string index of each edge's type, parallel to GRAPH_TARGETS
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t sectionCount;
+        uint32_t checksum;
+        uint64_t fileSize;
+        int32_t nextCaseId;
+        int32_t nextSuspectId;
+        int32_t nextCharacterId;
+        uint32_t reserved;
+    };
+
+    struct SectionEntry {
+        uint32_t type;
+        uint32_t reserved;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t count;
+    };
+
+    struct ListRef {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct CaseRecord {
+        int64_t dateCreated;
+        int64_t dateModified;
+        int64_t incidentDate;
+        int32_t id;
+        uint32_t title;
+        uint32_t description;
+        uint32_t location;
+        uint32_t solution;
+        uint32_t notes;
+        uint8_t status;
+        uint8_t priority;
+        uint16_t reserved;
+        ListRef suspectIds;
+        ListRef characterIds;
+        ListRef evidence;
+        ListRef tags;
+        uint32_t reserved2;
+    };
+
+    struct SuspectRecord {
+        int64_t dateAdded;
+        int64_t lastModified;
+        double suspicionLevel;
+        int32_t id;
+        int32_t age;
+        uint32_t name;
+        uint32_t story;
+        uint32_t background;
+        uint32_t motive;
+        uint32_t alibi;
+        uint32_t occupation;
+        uint32_t lastKnownLocation;
+        uint8_t alibiStrength;
+        uint8_t status;
+        uint16_t reserved;
+        ListRef caseIds;
+        ListRef physicalDescription;
+        ListRef knownAssociates;
+        ListRef evidenceAgainst;
+        ListRef evidenceFor;
+    };
+
+    struct CharacterRecord {
+        int32_t id;
+        uint32_t name;
+        uint32_t story;
+        uint8_t role;
+        uint8_t reserved[3];
+        ListRef relatedCases;
+        ListRef knownSuspects;
+    };
+
+    static_assert(sizeof(Header) == 40, "snapshot header layout changed");
+    static_assert(sizeof(SectionEntry) == 32, "snapshot section layout changed");
+    static_assert(sizeof(CaseRecord) == 88, "case record layout changed");
+    static_assert(sizeof(SuspectRecord) == 104, "suspect record layout changed");
+    static_assert(sizeof(CharacterRecord) == 32, "character record layout changed");
+}
+
+class SnapshotWriter {
+private:
+    std::string stringData;
+    std::vector<uint64_t> stringOffsets;
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::unordered_map<const char*, uint32_t> pooledIds;
+    std::vector<uint32_t> pool;
+    std::vector<SnapshotFormat::CaseRecord> caseRecords;
+    std::vector<SnapshotFormat::SuspectRecord> suspectRecords;
+    std::vector<SnapshotFormat::CharacterRecord> characterRecords;
+    std::vector<uint32_t> graphNodes;
+    std::vector<uint64_t> graphOffsets;
+    std::vector<uint32_t> graphTargets;
+    std::vector<int32_t> graphWeights;
+    std::vector<uint32_t> graphEdgeTypes;
+    int32_t nextCaseId;
+    int32_t nextSuspectId;
+    int32_t nextCharacterId;
+    uint64_t walLsn;
+
+    uint32_t intern(const std::string& value);
+    uint32_t intern(const PooledString& value);
+    SnapshotFormat::ListRef addIntList(const std::vector<int>& values);
+    SnapshotFormat::ListRef addStringList(const std::vector<PooledString>& values);
+
+public:
+    SnapshotWriter();
+
+    void addCase(const Case& c);
+    void addSuspect(const Suspect& s);
+    void addCharacter(const Character& ch);
+    void setGraph(const Graph& graph);
+    void setCounters(int caseId, int suspectId, int characterId);
+    void setWalLsn(uint64_t lsn);
+
+    // Writes to "<path>.tmp" and renames over path so readers never see a torn file
+    bool writeTo(const std::string& path, std::string& error) const;
+};
+
+class SnapshotReader {
+private:
+    std::shared_ptr<MappedFile> file;
+    bool stringsPinned;
+    const SnapshotFormat::Header* header;
+    const uint64_t* stringOffsets;
+    const char* stringData;
+    size_t stringCount;
+    size_t stringDataSize;
+    const uint32_t* pool;
+    size_t poolSize;
+    const SnapshotFormat::CaseRecord* caseRecords;
+    size_t caseCount;
+    const SnapshotFormat::SuspectRecord* suspectRecords;
+    size_t suspectCount;
+    const SnapshotFormat::CharacterRecord* characterRecords;
+    size_t characterCount;
+    const uint32_t* graphNodes;
+    size_t graphNodeCount;
+    const uint64_t* graphOffsets;
+    const uint32_t* graphTargets;
+    const int32_t* graphWeights;
+    const uint32_t* graphEdgeTypes;     // null in snapshots written before edge types
+    size_t graphEdgeCount;
+    uint64_t walLsn;
+    std::string lastError;
+    mutable std::vector<PooledString> pooled;   // by string index, filled on first use
+
+    bool fail(const std::string& message);
+    std::vector<int> readIntList(SnapshotFormat::ListRef ref) const;
+    std::vector<PooledString> readStringList(SnapshotFormat::ListRef ref) const;
+    void releaseFile();
+
+public:
+    SnapshotReader();
+
+    // Maps the file and validates header and section table. Entities are
+    // only materialised when asked for. The CRC over the whole file is only
+    // checked with verifyChecksum; without it, decoding catches out-of-range
+    // indices and enum values but not altered text or numbers.
+    bool open(const std::string& path, bool verifyChecksum = false);
+    const std::string& getError() const;
+
+    std::string_view getString(uint32_t index) const;
+    PooledString getPooledString(uint32_t index) const;
+
+    // Entity text materialised afterwards points into the file instead of
+    // being copied; the mapping stays open until the last such text is gone.
+    void pinStrings();
+
+    size_t getCaseCount() const;
+    size_t getSuspectCount() const;
+    size_t getCharacterCount() const;
+    Case getCase(size_t index) const;
+    Suspect getSuspect(size_t index) const;
+    Character getCharacter(size_t index) const;
+
+    // Records are written in tree order, so these are binary searches. The
+    // index forms return the record count when there is no match.
+    size_t findCaseIndex(std::string_view title) const;
+    size_t findSuspectIndex(std::string_view name) const;
+    bool findCase(std::string_view title, Case& out) const;
+    bool findSuspect(std::string_view name, Suspect& out) const;
+
+    size_t getGraphNodeCount() const;
+    size_t getGraphEdgeCount() const;
+    std::string_view getGraphNode(size_t index) const;
+    // fn(from, to, weight, type); type is empty when the snapshot has none
+    void forEachEdge(std::function<void(std::string_view, std::string_view, int, std::string_view)> fn) const;
+    // Replaces out with the stored graph; throws if the adjacency is corrupt
+    void readGraph(Graph& out) const;
+
+    int getNextCaseId() const;
+    int getNextSuspectId() const;
+    int getNextCharacterId() const;
+    uint64_t getWalLsn() const;
+};
+
+#endif // SNAPSHOT_H
@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "logger.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -203,18 +204,23 @@ namespace DetectiveUtils {
     }
 
     // ==================== RANDOM UTILITIES ====================
+    static std::mt19937& randomGenerator() {
+        static std::mt19937 gen(std::random_device{}());
+        return gen;
+    }
+
+    void seedRandom(unsigned seed) {
+        randomGenerator().seed(seed);
+    }
+
     int randomInt(int min, int max) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
         std::uniform_int_distribution<> dis(min, max);
-        return dis(gen);
+        return dis(randomGenerator());
     }
 
     double randomDouble(double min, double max) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
         std::uniform_real_distribution<> dis(min, max);
-        return dis(gen);
+        return dis(randomGenerator());
     }
 
     std::string randomName() {
@@ -477,6 +483,28 @@ namespace DetectiveUtils {
         return true;
     }
 
+    // ==================== CHECKSUM UTILITIES ====================
+    uint32_t crc32(const void* data, size_t length, uint32_t crc) {
+        static const auto table = [] {
+            std::vector<uint32_t> t(256);
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                t[i] = c;
+            }
+            return t;
+        }();
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < length; i++) {
+            crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
     // ==================== MATHEMATICAL UTILITIES ====================
     double normalize(double value, double min, double max) {
         if (max == min) return 0.0;
@@ -567,21 +595,19 @@ namespace DetectiveUtils {
 
     // ==================== DEBUG UTILITIES ====================
     void logInfo(const std::string& message) {
-        std::cout << "[INFO] " << getCurrentDateTime() << " - " << message << std::endl;
+        LOG_INFO(message);
     }
 
     void logWarning(const std::string& message) {
-        std::cout << "[WARNING] " << getCurrentDateTime() << " - " << message << std::endl;
+        LOG_WARNING(message);
     }
 
     void logError(const std::string& message) {
-        std::cerr << "[ERROR] " << getCurrentDateTime() << " - " << message << std::endl;
+        LOG_ERROR(message);
     }
 
     void logDebug(const std::string& message) {
-        #ifdef DEBUG
-        std::cout << "[DEBUG] " << getCurrentDateTime() << " - " << message << std::endl;
-        #endif
+        LOG_VERBOSE(message);
     }
 
     std::string getCallStack() {
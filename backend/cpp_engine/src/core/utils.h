@@ -11,6 +11,7 @@
 #include <functional>  // ADD THIS LINE
 #include <regex>       // ADD THIS LINE
 #include <cmath>  
+#include <cstdint>
 namespace DetectiveUtils {
 
     // ==================== STRING UTILITIES ====================
@@ -44,6 +45,9 @@ namespace DetectiveUtils {
     bool isEmptyOrWhitespace(const std::string& str);
 
     // ==================== RANDOM UTILITIES ====================
+    // The random* helpers share one generator, seeded from std::random_device
+    // unless seedRandom() fixes the sequence (benchmarks, reproducible data)
+    void seedRandom(unsigned seed);
     int randomInt(int min, int max);
     double randomDouble(double min, double max);
     std::string randomName();
@@ -79,6 +83,9 @@ namespace DetectiveUtils {
     std::vector<std::string> readLines(const std::string& filename);
     bool writeLines(const std::string& filename, const std::vector<std::string>& lines);
 
+    // ==================== CHECKSUM UTILITIES ====================
+    uint32_t crc32(const void* data, size_t length, uint32_t crc = 0);
+
     // ==================== MATHEMATICAL UTILITIES ====================
     double normalize(double value, double min, double max);
     double clamp(double value, double min, double max);
@@ -0,0 +1,152 @@
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <exception>
+
+namespace {
+
+// Which pool (if any) the current thread works for, and its deque
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threads) : queued(0), nextQueue(0), stopping(false) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threads; i++) queues.push_back(std::make_unique<Queue>());
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; i++) workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+unsigned WorkStealingPool::getThreadCount() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+size_t WorkStealingPool::homeQueue() {
+    if (currentPool == this) return currentIndex;
+    return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    Queue& queue = *queues[homeQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+    {
+        // Pairs with the predicate check in workerLoop so the wakeup can't be lost
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool WorkStealingPool::runOne(size_t home) {
+    std::function<void()> task;
+
+    {
+        Queue& own = *queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    for (size_t i = 1; !task && i < queues.size(); i++) {
+        Queue& victim = *queues[(home + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task) return false;
+    queued.fetch_sub(1);
+    task();
+    return true;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    while (true) {
+        if (runOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) break;
+    }
+}
+
+void WorkStealingPool::parallelFor(size_t count, size_t grain,
+                                   const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // Helpers may still be queued after we return, so they share ownership
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> remaining{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+        const std::function<void(size_t, size_t)>* body = nullptr;
+        size_t count = 0;
+        size_t grain = 0;
+        size_t chunks = 0;
+    };
+    auto state = std::make_shared<State>();
+    state->remaining = chunks;
+    state->body = &body;
+    state->count = count;
+    state->grain = grain;
+    state->chunks = chunks;
+
+    // Chunks are claimed from a shared counter, so whoever is free takes the next one
+    auto drain = [](const std::shared_ptr<State>& s) {
+        size_t chunk;
+        while ((chunk = s->next.fetch_add(1)) < s->chunks) {
+            size_t begin = chunk * s->grain;
+            size_t end = std::min(s->count, begin + s->grain);
+            try {
+                (*s->body)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(s->mutex);
+                if (!s->error) s->error = std::current_exception();
+            }
+            if (s->remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(s->mutex);
+                s->done.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(chunks - 1, workers.size());
+    for (size_t i = 0; i < helpers; i++) {
+        submit([state, drain] { drain(state); });
+    }
+    drain(state);
+
+    // Only chunks already running elsewhere are left; they can't be waiting on us
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->remaining.load() == 0; });
+    if (state->error) std::rethrow_exception(state->error);
+}
@@ -0,0 +1,56 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque.
+//
+// A worker pushes and pops at the back of its own deque (newest first, warm
+// caches) and, when that runs dry, steals from the front of the others'.
+// Tasks submitted from outside the pool are dealt round-robin. parallelFor()
+// lets the calling thread work too and returns once every chunk has run, so
+// it is safe to call from inside a task.
+class WorkStealingPool {
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued;
+    std::atomic<size_t> nextQueue;
+    std::atomic<bool> stopping;
+
+    void workerLoop(size_t index);
+    bool runOne(size_t home);
+    size_t homeQueue();
+
+public:
+    // 0 = hardware concurrency
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned getThreadCount() const;
+
+    void submit(std::function<void()> task);
+
+    // Calls body(begin, end) over [0, count) in chunks of at most grain items.
+    // Blocks until all chunks are done; the first exception thrown is rethrown.
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,348 @@
+#include "write_ahead_log.h"
+#include "mapped_file.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr size_t RECORD_HEADER_SIZE = 4 + 4 + 8 + 1;
+    // INTERVAL mode still wakes the flusher once this much is buffered
+    constexpr size_t FLUSH_THRESHOLD = 1 << 20;
+
+    void putRaw(std::string& out, const void* data, size_t size) {
+        out.append(static_cast<const char*>(data), size);
+    }
+
+    bool syncFile(std::FILE* f) {
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+}
+
+// ==================== PAYLOAD ENCODING ====================
+WalPayloadWriter& WalPayloadWriter::putInt(int32_t value) {
+    putRaw(buffer, &value, sizeof(value));
+    return *this;
+}
+
+WalPayloadWriter& WalPayloadWriter::putDouble(double value) {
+    putRaw(buffer, &value, sizeof(value));
+    return *this;
+}
+
+WalPayloadWriter& WalPayloadWriter::putString(std::string_view value) {
+    uint32_t length = static_cast<uint32_t>(value.size());
+    putRaw(buffer, &length, sizeof(length));
+    buffer.append(value.data(), value.size());
+    return *this;
+}
+
+const std::string& WalPayloadWriter::data() const {
+    return buffer;
+}
+
+WalPayloadReader::WalPayloadReader(std::string_view payload) : data(payload), pos(0) {}
+
+bool WalPayloadReader::getInt(int32_t& value) {
+    if (data.size() - pos < sizeof(value)) return false;
+    std::memcpy(&value, data.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+bool WalPayloadReader::getDouble(double& value) {
+    if (data.size() - pos < sizeof(value)) return false;
+    std::memcpy(&value, data.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+bool WalPayloadReader::getString(std::string& value) {
+    uint32_t length;
+    if (data.size() - pos < sizeof(length)) return false;
+    std::memcpy(&length, data.data() + pos, sizeof(length));
+    pos += sizeof(length);
+    if (data.size() - pos < length) return false;
+    value.assign(data.data() + pos, length);
+    pos += length;
+    return true;
+}
+
+// ==================== LOG ====================
+WriteAheadLog::WriteAheadLog(const std::string& directory, WalSyncPolicy policy, int syncIntervalMs)
+    : directory(directory), policy(policy), syncIntervalMs(std::max(1, syncIntervalMs)),
+      file(nullptr), segment(0), lastLsn(0), pendingLsn(0), durableLsn(0),
+      syncRequested(false), stopping(false), failed(false) {}
+
+WriteAheadLog::~WriteAheadLog() {
+    close();
+}
+
+bool WriteAheadLog::open(uint32_t segmentNumber, uint64_t nextLsn, std::string& error) {
+    close();
+
+    std::string path = segmentPath(directory, segmentNumber);
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        error = "Cannot open log segment " + path;
+        return false;
+    }
+
+    segment = segmentNumber;
+    lastLsn = nextLsn > 0 ? nextLsn - 1 : 0;
+    pendingLsn = lastLsn;
+    durableLsn = lastLsn;
+    stopping = false;
+    syncRequested = false;
+    failed = false;
+    failure.clear();
+    flusher = std::thread(&WriteAheadLog::flusherLoop, this);
+    return true;
+}
+
+void WriteAheadLog::close() {
+    if (flusher.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        flushRequested.notify_one();
+        flusher.join();
+    }
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool WriteAheadLog::isOpen() const {
+    return file != nullptr;
+}
+
+uint64_t WriteAheadLog::append(WalOp op, const std::string& payload) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (failed || !file) return 0;
+    uint64_t lsn = ++lastLsn;
+
+    std::string body;
+    body.reserve(sizeof(lsn) + 1 + payload.size());
+    putRaw(body, &lsn, sizeof(lsn));
+    body.push_back(static_cast<char>(op));
+    body.append(payload);
+
+    uint32_t length = static_cast<uint32_t>(payload.size());
+    uint32_t crc = DetectiveUtils::crc32(body.data(), body.size());
+    putRaw(pending, &length, sizeof(length));
+    putRaw(pending, &crc, sizeof(crc));
+    pending.append(body);
+    pendingLsn = lsn;
+
+    if (policy == WalSyncPolicy::ALWAYS) {
+        flushRequested.notify_one();
+        flushed.wait(lock, [&] { return durableLsn >= lsn || failed || stopping; });
+        if (durableLsn < lsn) return 0;
+    } else if (policy == WalSyncPolicy::NEVER || pending.size() >= FLUSH_THRESHOLD) {
+        flushRequested.notify_one();
+    }
+    return lsn;
+}
+
+bool WriteAheadLog::sync() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!flusher.joinable() || failed) return !failed;
+    uint64_t target = lastLsn;
+    syncRequested = true;
+    flushRequested.notify_one();
+    flushed.wait(lock, [&] { return durableLsn >= target || failed || stopping; });
+    return durableLsn >= target;
+}
+
+bool WriteAheadLog::writeAndSync(const std::string& batch, bool forceSync) {
+    if (!file) return false;
+    bool ok = true;
+    if (!batch.empty()) {
+        ok = std::fwrite(batch.data(), 1, batch.size(), file) == batch.size();
+        ok = std::fflush(file) == 0 && ok;
+    }
+    if (ok && (forceSync || policy != WalSyncPolicy::NEVER)) {
+        ok = syncFile(file);
+    }
+    return ok;
+}
+
+// Called with mutex held
+void WriteAheadLog::fail(const std::string& reason) {
+    if (!failed) DetectiveUtils::logError(reason);
+    failed = true;
+    failure = reason;
+    pending.clear();
+    flushed.notify_all();
+}
+
+void WriteAheadLog::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        auto ready = [&] { return stopping || syncRequested || !pending.empty(); };
+        if (policy == WalSyncPolicy::INTERVAL) {
+            flushRequested.wait_for(lock, std::chrono::milliseconds(syncIntervalMs),
+                                    [&] { return stopping || syncRequested || pending.size() >= FLUSH_THRESHOLD; });
+        } else {
+            flushRequested.wait(lock, ready);
+        }
+
+        if (failed) {
+            // Nothing after a torn write could be replayed; drop it
+            pending.clear();
+            syncRequested = false;
+        } else if (!pending.empty() || syncRequested) {
+            // Take the batch while holding ioMutex so rotate() never sees a
+            // batch that has left pending but not yet reached its segment
+            std::unique_lock<std::mutex> io(ioMutex);
+            std::string batch;
+            batch.swap(pending);
+            uint64_t batchLsn = pendingLsn;
+            bool forceSync = syncRequested;
+            syncRequested = false;
+            lock.unlock();
+
+            bool ok = writeAndSync(batch, forceSync);
+
+            io.unlock();
+            lock.lock();
+            if (ok) {
+                durableLsn = std::max(durableLsn, batchLsn);
+                flushed.notify_all();
+            } else {
+                fail("Write-ahead log flush failed for segment " + std::to_string(segment));
+            }
+        }
+
+        if (stopping && pending.empty()) break;
+    }
+    flushed.notify_all();
+}
+
+bool WriteAheadLog::rotate(uint32_t& sealedSegment, uint64_t& sealedLsn, std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> io(ioMutex);
+
+    if (!file) {
+        error = "Write-ahead log is not open";
+        return false;
+    }
+    if (failed) {
+        error = failure;
+        return false;
+    }
+
+    if (!writeAndSync(pending, true)) {
+        error = "Failed to flush log segment " + std::to_string(segment);
+        fail(error);
+        return false;
+    }
+    pending.clear();
+    durableLsn = pendingLsn;
+    flushed.notify_all();
+
+    std::string nextPath = segmentPath(directory, segment + 1);
+    std::FILE* next = std::fopen(nextPath.c_str(), "ab");
+    if (!next) {
+        error = "Cannot open log segment " + nextPath;
+        return false;
+    }
+
+    std::fclose(file);
+    file = next;
+    sealedSegment = segment++;
+    sealedLsn = lastLsn;
+    return true;
+}
+
+uint64_t WriteAheadLog::getLastLsn() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastLsn;
+}
+
+uint64_t WriteAheadLog::getDurableLsn() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return durableLsn;
+}
+
+uint32_t WriteAheadLog::getSegment() const {
+    return segment;
+}
+
+bool WriteAheadLog::hasFailed() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+std::string WriteAheadLog::getFailure() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failure;
+}
+
+// ==================== SEGMENT FILES ====================
+std::string WriteAheadLog::segmentPath(const std::string& directory, uint32_t segmentNumber) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "wal-%06u.log", segmentNumber);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+std::vector<uint32_t> WriteAheadLog::listSegments(const std::string& directory) {
+    std::vector<uint32_t> segments;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        std::string name = entry.path().filename().string();
+        unsigned int number = 0;
+        char tail = 0;
+        if (name.size() == 14 && std::sscanf(name.c_str(), "wal-%6u.lo%c", &number, &tail) == 2 && tail == 'g') {
+            segments.push_back(number);
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool WriteAheadLog::readSegment(const std::string& path, const std::function<void(const WalRecord&)>& fn,
+                                std::string& error) {
+    MappedFile mapped;
+    if (!mapped.open(path)) {
+        error = "Cannot open log segment " + path;
+        return false;
+    }
+
+    const char* data = mapped.data();
+    size_t size = mapped.size();
+    size_t pos = 0;
+    while (size - pos >= RECORD_HEADER_SIZE) {
+        uint32_t length, crc;
+        std::memcpy(&length, data + pos, sizeof(length));
+        std::memcpy(&crc, data + pos + 4, sizeof(crc));
+        size_t bodySize = 8 + 1 + size_t(length);
+        if (size - pos - 8 < bodySize) break;
+
+        const char* body = data + pos + 8;
+        if (DetectiveUtils::crc32(body, bodySize) != crc) break;
+
+        WalRecord record;
+        std::memcpy(&record.lsn, body, sizeof(record.lsn));
+        record.op = static_cast<WalOp>(static_cast<uint8_t>(body[8]));
+        record.payload = std::string_view(body + 9, length);
+        fn(record);
+
+        pos += 8 + bodySize;
+    }
+    return true;
+}
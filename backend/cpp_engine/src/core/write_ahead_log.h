@@ -0,0 +1,148 @@
+#ifndef WRITE_AHEAD_LOG_H
+#define WRITE_AHEAD_LOG_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Append-only log of engine mutations.
+//
+// Each record on disk is:
+//   [u32 payloadLength][u32 crc][u64 lsn][u8 op][payload]
+// where the CRC-32 covers lsn, op and payload. Records are buffered in memory
+// and written by a background flusher, so concurrent appenders share a
+// single write + fsync (group commit).
+//
+// A failed write or fsync is sticky: durableLsn stays where it was, waiters
+// wake up, and every later append() or sync() fails until the log is reopened.
+
+enum class WalSyncPolicy {
+    ALWAYS,     // append() returns once the record is fsynced
+    INTERVAL,   // fsync every syncIntervalMs; a crash can lose that window
+    NEVER       // leave flushing to the OS
+};
+
+enum class WalOp : uint8_t {
+    ADD_CASE = 1,
+    REMOVE_CASE,
+    UPDATE_CASE,
+    ADD_SUSPECT,
+    REMOVE_SUSPECT,
+    UPDATE_SUSPECT,
+    ADD_CHARACTER,
+    REMOVE_CHARACTER,
+    UPDATE_CHARACTER,
+    LINK_SUSPECT,
+    UNLINK_SUSPECT,
+    LINK_CHARACTER,
+    UNLINK_CHARACTER,
+    ADD_RELATIONSHIP,
+    REMOVE_RELATIONSHIP,
+    RECALCULATE_SUSPICION,
+    REBUILD_CONNECTIONS,
+    UPDATE_CASE_DETAILS,
+    ADD_CASE_EVIDENCE,
+    REMOVE_CASE_EVIDENCE,
+    UPDATE_SUSPECT_ASSESSMENT
+};
+
+struct WalRecord {
+    uint64_t lsn;
+    WalOp op;
+    std::string_view payload;
+};
+
+// Payload encoding: strings are length-prefixed, integers are 4 bytes,
+// doubles 8
+class WalPayloadWriter {
+private:
+    std::string buffer;
+
+public:
+    WalPayloadWriter& putInt(int32_t value);
+    WalPayloadWriter& putDouble(double value);
+    WalPayloadWriter& putString(std::string_view value);
+    const std::string& data() const;
+};
+
+class WalPayloadReader {
+private:
+    std::string_view data;
+    size_t pos;
+
+public:
+    explicit WalPayloadReader(std::string_view payload);
+    bool getInt(int32_t& value);
+    bool getDouble(double& value);
+    bool getString(std::string& value);
+};
+
+class WriteAheadLog {
+private:
+    std::string directory;
+    WalSyncPolicy policy;
+    int syncIntervalMs;
+
+    std::FILE* file;
+    uint32_t segment;
+
+    // Guards pending, lastLsn, durableLsn, failure and the flags below
+    std::mutex mutex;
+    // Held by whoever is writing to file; always taken after mutex
+    std::mutex ioMutex;
+    std::condition_variable flushRequested;
+    std::condition_variable flushed;
+    std::string pending;
+    uint64_t lastLsn;
+    uint64_t pendingLsn;
+    uint64_t durableLsn;
+    bool syncRequested;
+    bool stopping;
+    bool failed;
+    std::string failure;
+    std::thread flusher;
+
+    void flusherLoop();
+    bool writeAndSync(const std::string& batch, bool forceSync);
+    void fail(const std::string& reason);
+
+public:
+    WriteAheadLog(const std::string& directory, WalSyncPolicy policy, int syncIntervalMs = 50);
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Starts appending to the given segment with LSNs from nextLsn
+    bool open(uint32_t segmentNumber, uint64_t nextLsn, std::string& error);
+    void close();
+    bool isOpen() const;
+
+    // Returns the record's LSN, or 0 once the log has failed. Under ALWAYS a
+    // record whose flush fails also returns 0.
+    uint64_t append(WalOp op, const std::string& payload);
+    // Blocks until everything appended so far is on disk; false if it never got there
+    bool sync();
+    // Seals the current segment and starts the next one
+    bool rotate(uint32_t& sealedSegment, uint64_t& sealedLsn, std::string& error);
+
+    uint64_t getLastLsn();
+    uint64_t getDurableLsn();
+    uint32_t getSegment() const;
+    bool hasFailed();
+    std::string getFailure();
+
+    static std::string segmentPath(const std::string& directory, uint32_t segmentNumber);
+    static std::vector<uint32_t> listSegments(const std::string& directory);
+    // Calls fn for each valid record; stops quietly at a torn or corrupt tail
+    static bool readSegment(const std::string& path, const std::function<void(const WalRecord&)>& fn,
+                            std::string& error);
+};
+
+#endif // WRITE_AHEAD_LOG_H
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <string_view>
 #include "../models/case.h"
 // Constructor
 template <typename T>
@@ -27,6 +28,22 @@ int AVLTree<T>::getBalance(AVLNode<T>* node) {
     return getHeight(node->left) - getHeight(node->right);
 }
 
+// Subtree size (0 for null)
+template <typename T>
+int AVLTree<T>::getSize(const AVLNode<T>* node) const {
+    return node ? node->size : 0;
+}
+
+// Recompute height and size from the children
+template <typename T>
+void AVLTree<T>::update(AVLNode<T>* node) {
+    node->height = std::max(getHeight(node->left), getHeight(node->right)) + 1;
+    node->size = getSize(node->left) + getSize(node->right) + 1;
+    // Every relink ends with an update of the new parent
+    if (node->left) node->left->parent = node;
+    if (node->right) node->right->parent = node;
+}
+
 // Right rotation
 template <typename T>
 AVLNode<T>* AVLTree<T>::rightRotate(AVLNode<T>* y) {
@@ -36,8 +53,8 @@ AVLNode<T>* AVLTree<T>::rightRotate(AVLNode<T>* y) {
     x->right = y;
     y->left = T2;
 
-    y->height = std::max(getHeight(y->left), getHeight(y->right)) + 1;
-    x->height = std::max(getHeight(x->left), getHeight(x->right)) + 1;
+    update(y);
+    update(x);
 
     return x;
 }
@@ -51,8 +68,8 @@ AVLNode<T>* AVLTree<T>::leftRotate(AVLNode<T>* x) {
     y->left = x;
     x->right = T2;
 
-    x->height = std::max(getHeight(x->left), getHeight(x->right)) + 1;
-    y->height = std::max(getHeight(y->left), getHeight(y->right)) + 1;
+    update(x);
+    update(y);
 
     return y;
 }
@@ -62,7 +79,7 @@ template <typename T>
 AVLNode<T>* AVLTree<T>::balanceNode(AVLNode<T>* node) {
     if (!node) return node;
 
-    node->height = 1 + std::max(getHeight(node->left), getHeight(node->right));
+    update(node);
     int balance = getBalance(node);
 
     // Left Left Case
@@ -90,8 +107,8 @@ AVLNode<T>* AVLTree<T>::balanceNode(AVLNode<T>* node) {
 
 // Insert node
 template <typename T>
-AVLNode<T>* AVLTree<T>::insertNode(AVLNode<T>* node, T value) {
-    if (!node) return new AVLNode<T>(value);
+AVLNode<T>* AVLTree<T>::insertNode(AVLNode<T>* node, T& value) {
+    if (!node) return new AVLNode<T>(std::move(value));
 
     if (value < node->data)
         node->left = insertNode(node->left, value);
@@ -107,6 +124,7 @@ AVLNode<T>* AVLTree<T>::insertNode(AVLNode<T>* node, T value) {
 template <typename T>
 void AVLTree<T>::insert(T value) {
     root = insertNode(root, value);
+    root->parent = nullptr;
 }
 
 // Find minimum value node
@@ -118,30 +136,40 @@ AVLNode<T>* AVLTree<T>::minValueNode(AVLNode<T>* node) {
     return current;
 }
 
-// Delete node
+// Unlink the minimum node of a subtree, rebalancing on the way back up
 template <typename T>
-AVLNode<T>* AVLTree<T>::deleteNode(AVLNode<T>* node, T value) {
+AVLNode<T>* AVLTree<T>::detachMin(AVLNode<T>* node, AVLNode<T>*& detached) {
+    if (!node->left) {
+        detached = node;
+        return node->right;
+    }
+    node->left = detachMin(node->left, detached);
+    return balanceNode(node);
+}
+
+// Delete node. Nodes are relinked rather than having their data copied,
+// so pointers to the remaining elements stay valid.
+template <typename T>
+template <typename K>
+AVLNode<T>* AVLTree<T>::deleteNode(AVLNode<T>* node, const K& key, bool& removed) {
     if (!node) return node;
 
-    if (value < node->data)
-        node->left = deleteNode(node->left, value);
-    else if (value > node->data)
-        node->right = deleteNode(node->right, value);
+    if (key < node->data)
+        node->left = deleteNode(node->left, key, removed);
+    else if (node->data < key)
+        node->right = deleteNode(node->right, key, removed);
     else {
+        removed = true;
+        AVLNode<T>* replacement;
         if (!node->left || !node->right) {
-            AVLNode<T>* temp = node->left ? node->left : node->right;
-            if (!temp) {
-                temp = node;
-                node = nullptr;
-            } else {
-                *node = *temp;
-            }
-            delete temp;
+            replacement = node->left ? node->left : node->right;
         } else {
-            AVLNode<T>* temp = minValueNode(node->right);
-            node->data = temp->data;
-            node->right = deleteNode(node->right, temp->data);
+            AVLNode<T>* right = detachMin(node->right, replacement);
+            replacement->left = node->left;
+            replacement->right = right;
         }
+        delete node;
+        node = replacement;
     }
 
     if (!node) return node;
@@ -150,13 +178,25 @@ AVLNode<T>* AVLTree<T>::deleteNode(AVLNode<T>* node, T value) {
 
 // Public remove
 template <typename T>
-void AVLTree<T>::remove(T value) {
-    root = deleteNode(root, value);
+void AVLTree<T>::remove(const T& value) {
+    bool removed = false;
+    root = deleteNode(root, value, removed);
+    if (root) root->parent = nullptr;
+}
+
+// Remove by key
+template <typename T>
+template <typename K>
+bool AVLTree<T>::removeKey(const K& key) {
+    bool removed = false;
+    root = deleteNode(root, key, removed);
+    if (root) root->parent = nullptr;
+    return removed;
 }
 
 // Search
 template <typename T>
-T* AVLTree<T>::search(T value) {
+T* AVLTree<T>::search(const T& value) {
     AVLNode<T>* current = root;
     while (current) {
         if (value == current->data)
@@ -171,7 +211,7 @@ T* AVLTree<T>::search(T value) {
 
 // Const search
 template <typename T>
-const T* AVLTree<T>::search(T value) const {
+const T* AVLTree<T>::search(const T& value) const {
     const AVLNode<T>* current = root;
     while (current) {
         if (value == current->data)
@@ -186,10 +226,41 @@ const T* AVLTree<T>::search(T value) const {
 
 // Check if value exists
 template <typename T>
-bool AVLTree<T>::contains(T value) {
+bool AVLTree<T>::contains(const T& value) {
     return search(value) != nullptr;
 }
 
+// Node whose data is equivalent to key, or nullptr
+template <typename T>
+template <typename K>
+const AVLNode<T>* AVLTree<T>::findNode(const K& key) const {
+    const AVLNode<T>* current = root;
+    while (current) {
+        if (key < current->data)
+            current = current->left;
+        else if (current->data < key)
+            current = current->right;
+        else
+            return current;
+    }
+    return nullptr;
+}
+
+// Search by key
+template <typename T>
+template <typename K>
+T* AVLTree<T>::findKey(const K& key) {
+    const AVLNode<T>* node = findNode(key);
+    return node ? const_cast<T*>(&node->data) : nullptr;
+}
+
+template <typename T>
+template <typename K>
+const T* AVLTree<T>::findKey(const K& key) const {
+    const AVLNode<T>* node = findNode(key);
+    return node ? &node->data : nullptr;
+}
+
 // Clear tree
 template <typename T>
 void AVLTree<T>::clear() {
@@ -207,7 +278,7 @@ void AVLTree<T>::clearTree(AVLNode<T>* node) {
 
 // In-order traversal
 template <typename T>
-void AVLTree<T>::inOrderNodes(AVLNode<T>* node, std::function<void(T*)> fn) {
+void AVLTree<T>::inOrderNodes(AVLNode<T>* node, const std::function<void(T*)>& fn) {
     if (!node) return;
     inOrderNodes(node->left, fn);
     fn(&node->data);
@@ -221,7 +292,7 @@ void AVLTree<T>::inOrderTraversal(std::function<void(T*)> fn) {
 
 // Const in-order traversal
 template <typename T>
-void AVLTree<T>::inOrderNodes(const AVLNode<T>* node, std::function<void(const T*)> fn) const {
+void AVLTree<T>::inOrderNodes(const AVLNode<T>* node, const std::function<void(const T*)>& fn) const {
     if (!node) return;
     inOrderNodes(node->left, fn);
     fn(&node->data);
@@ -235,7 +306,7 @@ void AVLTree<T>::inOrderTraversal(std::function<void(const T*)> fn) const {
 
 // Pre-order traversal
 template <typename T>
-void AVLTree<T>::preOrderNodes(AVLNode<T>* node, std::function<void(T*)> fn) {
+void AVLTree<T>::preOrderNodes(AVLNode<T>* node, const std::function<void(T*)>& fn) {
     if (!node) return;
     fn(&node->data);
     preOrderNodes(node->left, fn);
@@ -249,7 +320,7 @@ void AVLTree<T>::preOrderTraversal(std::function<void(T*)> fn) {
 
 // Post-order traversal
 template <typename T>
-void AVLTree<T>::postOrderNodes(AVLNode<T>* node, std::function<void(T*)> fn) {
+void AVLTree<T>::postOrderNodes(AVLNode<T>* node, const std::function<void(T*)>& fn) {
     if (!node) return;
     postOrderNodes(node->left, fn);
     postOrderNodes(node->right, fn);
@@ -289,13 +360,43 @@ int AVLTree<T>::getHeight() {
 // Get tree size
 template <typename T>
 int AVLTree<T>::getSize() const {
-    return countNodes(root);
+    return getSize(root);
 }
 
+// Select by in-order index
 template <typename T>
-int AVLTree<T>::countNodes(AVLNode<T>* node) const {
-    if (!node) return 0;
-    return 1 + countNodes(node->left) + countNodes(node->right);
+T* AVLTree<T>::select(int index) {
+    if (index < 0 || index >= getSize(root)) return nullptr;
+
+    AVLNode<T>* current = root;
+    while (current) {
+        int leftSize = getSize(current->left);
+        if (index < leftSize) {
+            current = current->left;
+        } else if (index == leftSize) {
+            return &current->data;
+        } else {
+            index -= leftSize + 1;
+            current = current->right;
+        }
+    }
+    return nullptr;
+}
+
+// Number of elements less than value
+template <typename T>
+int AVLTree<T>::rank(const T& value) const {
+    int result = 0;
+    const AVLNode<T>* current = root;
+    while (current) {
+        if (current->data < value) {
+            result += getSize(current->left) + 1;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return result;
 }
 
 // Check if empty
@@ -325,10 +426,10 @@ T* AVLTree<T>::getMax() {
 template <typename T>
 T* AVLTree<T>::searchByCriteria(std::function<bool(const T&)> criteria) {
     T* result = nullptr;
-    inOrderTraversal([&](T* data) {
-        if (!result && criteria(*data)) {
-            result = data;
-        }
+    forEach([&](T* data) {
+        if (!criteria(*data)) return true;
+        result = data;
+        return false;
     });
     return result;
 }
@@ -353,7 +454,7 @@ void AVLTree<T>::collectNodes(AVLNode<T>* node, std::vector<T>& collection) {
 template <typename T>
 std::vector<T> AVLTree<T>::filter(std::function<bool(const T&)> criteria) {
     std::vector<T> result;
-    inOrderTraversal([&](T* data) {
+    forEach([&](T* data) {
         if (criteria(*data)) {
             result.push_back(*data);
         }
@@ -382,7 +483,7 @@ template <typename T>
 bool AVLTree<T>::isComplete() {
     if (!root) return true;
     
-    int nodeCount = countNodes(root);
+    int nodeCount = getSize(root);
     return isComplete(root, 0, nodeCount);
 }
 
@@ -432,7 +533,7 @@ void AVLTree<T>::printTreeHelper(AVLNode<T>* node, std::string indent, bool last
         std::cout << "├── ";
         indent += "│   ";
     }
-    std::cout << node->data << " (h:" << node->height << ")" << std::endl;
+    std::cout << node->data << " (h:" << node->height << ", n:" << node->size << ")" << std::endl;
     
     printTreeHelper(node->left, indent, false);
     printTreeHelper(node->right, indent, true);
@@ -589,4 +690,9 @@ void AVLTree<T>::displayStats() {
 template class AVLTree<int>;
 template class AVLTree<std::string>;
 template class AVLTree<double>;
-template class AVLTree<Case>;
\ No newline at end of file
+template class AVLTree<Case>;
+
+// Key lookups on cases by title
+template Case* AVLTree<Case>::findKey(const std::string_view&);
+template const Case* AVLTree<Case>::findKey(const std::string_view&) const;
+template bool AVLTree<Case>::removeKey(const std::string_view&);
@@ -1,18 +1,25 @@
 #ifndef AVL_TREE_H
 #define AVL_TREE_H
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
+#include "visitor.h"
 
 template <typename T>
 struct AVLNode {
     T data;
     AVLNode* left;
     AVLNode* right;
+    AVLNode* parent;    // kept by update(), for iterators
     int height;
+    int size;   // nodes in this subtree, for select/rank
     
-    AVLNode(T value) : data(value), left(nullptr), right(nullptr), height(1) {}
+    AVLNode(T value) : data(std::move(value)), left(nullptr), right(nullptr), parent(nullptr), height(1), size(1) {}
 };
 
 template <typename T>
@@ -23,23 +30,70 @@ private:
     // Helper functions
     int getHeight(AVLNode<T>* node);
     int getBalance(AVLNode<T>* node);
+    int getSize(const AVLNode<T>* node) const;
+    void update(AVLNode<T>* node);
     AVLNode<T>* rightRotate(AVLNode<T>* y);
     AVLNode<T>* leftRotate(AVLNode<T>* x);
     AVLNode<T>* balanceNode(AVLNode<T>* node);
-    AVLNode<T>* insertNode(AVLNode<T>* node, T value);
-    AVLNode<T>* deleteNode(AVLNode<T>* node, T value);
+    AVLNode<T>* insertNode(AVLNode<T>* node, T& value);
+    template <typename K>
+    AVLNode<T>* deleteNode(AVLNode<T>* node, const K& key, bool& removed);
+    template <typename K>
+    const AVLNode<T>* findNode(const K& key) const;
+    AVLNode<T>* detachMin(AVLNode<T>* node, AVLNode<T>*& detached);
     AVLNode<T>* minValueNode(AVLNode<T>* node);
     void clearTree(AVLNode<T>* node);
-    void inOrderNodes(AVLNode<T>* node, std::function<void(T*)> fn);
-    void inOrderNodes(const AVLNode<T>* node, std::function<void(const T*)> fn) const;
-    void preOrderNodes(AVLNode<T>* node, std::function<void(T*)> fn);
-    void postOrderNodes(AVLNode<T>* node, std::function<void(T*)> fn);
-    int countNodes(AVLNode<T>* node) const;
+    void inOrderNodes(AVLNode<T>* node, const std::function<void(T*)>& fn);
+    void inOrderNodes(const AVLNode<T>* node, const std::function<void(const T*)>& fn) const;
+    void preOrderNodes(AVLNode<T>* node, const std::function<void(T*)>& fn);
+    void postOrderNodes(AVLNode<T>* node, const std::function<void(T*)>& fn);
     void collectNodes(AVLNode<T>* node, std::vector<T>& collection);
     bool isBalanced(AVLNode<T>* node);
     bool isComplete(AVLNode<T>* node, int index, int nodeCount);
     void printTreeHelper(AVLNode<T>* node, std::string indent, bool last);
 
+    template <typename Node, typename F>
+    static bool forEachNode(Node* node, F& fn) {
+        if (!node) return true;
+        return forEachNode<Node>(node->left, fn) && continueVisit(fn, &node->data) &&
+               forEachNode<Node>(node->right, fn);
+    }
+
+    static AVLNode<T>* leftmost(AVLNode<T>* node) {
+        while (node && node->left) node = node->left;
+        return node;
+    }
+    static AVLNode<T>* rightmost(AVLNode<T>* node) {
+        while (node && node->right) node = node->right;
+        return node;
+    }
+    static AVLNode<T>* successor(AVLNode<T>* node) {
+        if (node->right) return leftmost(node->right);
+        while (node->parent && node == node->parent->right) node = node->parent;
+        return node->parent;
+    }
+    static AVLNode<T>* predecessor(AVLNode<T>* node) {
+        if (node->left) return rightmost(node->left);
+        while (node->parent && node == node->parent->left) node = node->parent;
+        return node->parent;
+    }
+
+    // First node not less than key (upper = false) or greater than key
+    template <typename K>
+    AVLNode<T>* boundNode(const K& key, bool upper) const {
+        AVLNode<T>* result = nullptr;
+        AVLNode<T>* current = root;
+        while (current) {
+            if (upper ? key < current->data : !(current->data < key)) {
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return result;
+    }
+
 public:
     // Constructor and Destructor
     AVLTree();
@@ -47,12 +101,19 @@ public:
 
     // Basic operations
     void insert(T value);
-    void remove(T value);
-    T* search(T value);
-    const T* search(T value) const;
-    bool contains(T value);
+    void remove(const T& value);
+    T* search(const T& value);
+    const T* search(const T& value) const;
+    bool contains(const T& value);
     void clear();
 
+    // Lookups by key: K only has to be ordered against T the same way T is
+    // ordered (Case against a string_view title), so no temporary T is
+    // built. Instantiated for the key types at the end of avl_tree.cpp.
+    template <typename K> T* findKey(const K& key);
+    template <typename K> const T* findKey(const K& key) const;
+    template <typename K> bool removeKey(const K& key);
+
     // Traversals
     void inOrderTraversal(std::function<void(T*)> fn);
     void inOrderTraversal(std::function<void(const T*)> fn) const;
@@ -60,15 +121,27 @@ public:
     void postOrderTraversal(std::function<void(T*)> fn);
     void levelOrderTraversal(std::function<void(T*)> fn);
 
+    // Inlined in-order walk for hot scans: fn(T*) returns void, or bool
+    // where false stops early. Returns false if the walk was stopped.
+    template <typename F>
+    bool forEach(F&& fn) { return forEachNode(root, fn); }
+    template <typename F>
+    bool forEach(F&& fn) const { return forEachNode<const AVLNode<T>>(root, fn); }
+
     // Tree properties
     int getHeight();
-    int getSize() const;
+    int getSize() const;    // O(1)
     bool isEmpty();
     T* getMin();
     T* getMax();
     bool isBalanced();
     bool isComplete();
 
+    // Order statistics, O(log n): the element at a 0-based in-order index
+    // (nullptr if out of range), and how many elements are less than value
+    T* select(int index);
+    int rank(const T& value) const;
+
     // Utility functions
     T* searchByCriteria(std::function<bool(const T&)> criteria);
     std::vector<T> toVector();
@@ -79,6 +152,58 @@ public:
     // Display functions
     void printTree();
     void displayStats();
+
+    // Bidirectional in-order iterators over the parent links. Nodes are
+    // relinked, never moved, so an iterator stays valid until its own
+    // element is removed.
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() : node(nullptr), tree(nullptr) {}
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : node(other.node), tree(other.tree) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        Iterator& operator++() { node = successor(node); return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator& operator--() { node = node ? predecessor(node) : rightmost(tree->root); return *this; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        friend class AVLTree;
+        template <bool> friend class Iterator;
+        Iterator(AVLNode<T>* node, const AVLTree* tree) : node(node), tree(tree) {}
+
+        AVLNode<T>* node;   // nullptr at end()
+        const AVLTree* tree;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return iterator(leftmost(root), this); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator begin() const { return const_iterator(leftmost(root), this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+
+    // First element not less than key / greater than key; any key type
+    // that findKey accepts works here too
+    template <typename K>
+    iterator lowerBound(const K& key) { return iterator(boundNode(key, false), this); }
+    template <typename K>
+    iterator upperBound(const K& key) { return iterator(boundNode(key, true), this); }
+    template <typename K>
+    const_iterator lowerBound(const K& key) const { return const_iterator(boundNode(key, false), this); }
+    template <typename K>
+    const_iterator upperBound(const K& key) const { return const_iterator(boundNode(key, true), this); }
 };
 
 #endif // AVL_TREE_H
\ No newline at end of file
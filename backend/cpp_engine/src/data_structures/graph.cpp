@@ -1,4 +1,5 @@
 #include "graph.h"
+#include "union_find.h"
 #include <algorithm>
 #include <queue>
 #include <stack>
@@ -7,8 +8,89 @@
 #include <iostream>
 #include <unordered_map>
 
+namespace {
+    using DenseView = Graph::DenseView;
+
+    // One explicit-stack DFS frame: a node and the next edge to look at
+    struct Frame {
+        int node;
+        int edge;
+    };
+
+    // Preorder DFS from start over nodes not yet visited
+    template <typename Visit>
+    void denseDfs(const DenseView& g, int start, std::vector<char>& visited, std::vector<Frame>& stack, Visit visit) {
+        visited[start] = 1;
+        visit(start);
+        stack.push_back({start, g.offsets[start]});
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.edge == g.offsets[top.node + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            int v = g.targets[top.edge++];
+            if (!visited[v]) {
+                visited[v] = 1;
+                visit(v);
+                stack.push_back({v, g.offsets[v]});
+            }
+        }
+    }
+
+    // Tarjan's low-link DFS shared by articulation points and bridges. Edges
+    // are followed as stored and the edge back to the DFS parent is ignored.
+    void lowLinkDfs(const DenseView& g, std::function<void(int)> onArticulation,
+                    std::function<void(int, int)> onBridge) {
+        int n = g.nodeCount();
+        std::vector<int> disc(n, 0), low(n, 0), parent(n, -1), children(n, 0);
+        std::vector<char> reported(n, 0);
+        std::vector<Frame> stack;
+        int time = 0;
+
+        for (int root = 0; root < n; root++) {
+            if (disc[root]) continue;
+            disc[root] = low[root] = ++time;
+            stack.push_back({root, g.offsets[root]});
+
+            while (!stack.empty()) {
+                Frame& top = stack.back();
+                int u = top.node;
+                if (top.edge < g.offsets[u + 1]) {
+                    int v = g.targets[top.edge++];
+                    if (!disc[v]) {
+                        parent[v] = u;
+                        children[u]++;
+                        disc[v] = low[v] = ++time;
+                        stack.push_back({v, g.offsets[v]});
+                    } else if (v != parent[u]) {
+                        low[u] = std::min(low[u], disc[v]);
+                    }
+                    continue;
+                }
+
+                // u is finished: fold its low value into the parent
+                stack.pop_back();
+                int p = parent[u];
+                if (p < 0) continue;
+                low[p] = std::min(low[p], low[u]);
+
+                if (onBridge && low[u] > disc[p]) onBridge(p, u);
+                if (onArticulation && !reported[p]) {
+                    bool isRoot = parent[p] < 0;
+                    if ((isRoot && children[p] > 1) || (!isRoot && low[u] >= disc[p])) {
+                        reported[p] = 1;
+                        onArticulation(p);
+                    }
+                }
+            }
+        }
+    }
+}
+
 // Constructor
-Graph::Graph() {}
+Graph::Graph() : edgeTypeNames{DEFAULT_EDGE_TYPE}, edgeTypeIds{{DEFAULT_EDGE_TYPE, 0}},
+                 edgeCount(0), version(0), denseCacheVersion(0), componentsDirty(false) {}
 
 // Destructor
 Graph::~Graph() {}
@@ -16,61 +98,175 @@ Graph::~Graph() {}
 // Add a node
 void Graph::addNode(const std::string& node) {
     if (adjList.find(node) == adjList.end()) {
+        version++;
         adjList[node] = std::vector<std::string>();
+        inDegrees[node] = 0;
+        if (!componentsDirty) componentIds.emplace(node, components.add());
     }
 }
 
 // Add a directed edge with optional weight
 void Graph::addEdge(const std::string& from, const std::string& to, int weight) {
+    insertEdge(from, to, weight, -1);
+}
+
+// Add a directed edge of a named type
+bool Graph::addEdge(const std::string& from, const std::string& to, const std::string& type, int weight) {
+    int typeId = internEdgeType(type);
+    if (typeId < 0) return false;
+    insertEdge(from, to, weight, typeId);
+    return true;
+}
+
+// type < 0 keeps an existing edge's type
+void Graph::insertEdge(const std::string& from, const std::string& to, int weight, int type) {
     addNode(from);
     addNode(to);
+    version++;
     
-    // Add to adjacency list if not already present
-    if (std::find(adjList[from].begin(), adjList[from].end(), to) == adjList[from].end()) {
+    // Add to adjacency list if not already present. edges holds exactly
+    // the edge set, so it doubles as an O(1) membership check.
+    auto& outEdges = edges[from];
+    auto existing = outEdges.find(to);
+    if (existing == outEdges.end()) {
         adjList[from].push_back(to);
+        inDegrees[to]++;
+        edgeCount++;
+        if (!componentsDirty) components.unite(componentIds.at(from), componentIds.at(to));
+        outEdges.emplace(to, EdgeData{weight, static_cast<uint8_t>(type < 0 ? 0 : type)});
+        return;
     }
     
-    // Set weight
-    weights[from][to] = weight;
+    existing->second.weight = weight;
+    if (type >= 0) existing->second.type = static_cast<uint8_t>(type);
+}
+
+int Graph::internEdgeType(const std::string& type) {
+    auto it = edgeTypeIds.find(type);
+    if (it != edgeTypeIds.end()) return it->second;
+    if (static_cast<int>(edgeTypeNames.size()) >= MAX_EDGE_TYPES) return -1;
+
+    uint8_t id = static_cast<uint8_t>(edgeTypeNames.size());
+    edgeTypeNames.push_back(type);
+    edgeTypeIds.emplace(type, id);
+    return id;
 }
 
 // Remove an edge
 void Graph::removeEdge(const std::string& from, const std::string& to) {
     if (adjList.find(from) != adjList.end()) {
+        version++;
         auto& neighbors = adjList[from];
-        neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), to), neighbors.end());
-        
-        // Remove weight
-        if (weights.find(from) != weights.end() && weights[from].find(to) != weights[from].end()) {
-            weights[from].erase(to);
+        auto it = std::find(neighbors.begin(), neighbors.end(), to);
+        if (it != neighbors.end()) {
+            neighbors.erase(it);
+            inDegrees[to]--;
+            edgeCount--;
+            componentsDirty = true;
         }
+        
+        // Remove edge data
+        auto outEdges = edges.find(from);
+        if (outEdges != edges.end()) outEdges->second.erase(to);
     }
 }
 
 // Remove a node and all its edges
 void Graph::removeNode(const std::string& node) {
+    auto found = adjList.find(node);
+    if (found == adjList.end()) return;
+    version++;
+    componentsDirty = true;
+
+    // Outgoing edges: their targets lose in-degree
+    for (const auto& target : found->second) {
+        edgeCount--;
+        if (target != node) inDegrees[target]--;
+    }
+
     // Remove node from adjacency list
-    adjList.erase(node);
+    adjList.erase(found);
+    inDegrees.erase(node);
     
-    // Remove node from weights
-    weights.erase(node);
+    // Remove node's outgoing edge data
+    edges.erase(node);
     
     // Remove all edges pointing to this node
     for (auto& pair : adjList) {
         auto& neighbors = pair.second;
-        neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), node), neighbors.end());
+        auto it = std::find(neighbors.begin(), neighbors.end(), node);
+        if (it == neighbors.end()) continue;
+
+        neighbors.erase(it);
+        edgeCount--;
         
-        // Remove weights for edges to this node
-        if (weights.find(pair.first) != weights.end()) {
-            weights[pair.first].erase(node);
-        }
+        // Remove edge data for edges to this node
+        auto outEdges = edges.find(pair.first);
+        if (outEdges != edges.end()) outEdges->second.erase(node);
     }
 }
 
 // Clear 
 void Graph::clear() {
+    version++;
     adjList.clear();
-    weights.clear();
+    edges.clear();
+    inDegrees.clear();
+    edgeCount = 0;
+    components.reset(0);
+    componentIds.clear();
+    componentsDirty = false;
+}
+
+bool Graph::assign(const std::vector<std::string>& nodes, const std::vector<std::string>& types,
+                   const std::vector<IndexedEdge>& edgeList) {
+    clear();
+
+    std::vector<uint8_t> typeIds(types.size(), 0);
+    for (size_t i = 0; i < types.size(); i++) {
+        if (types[i].empty()) continue;
+        int id = internEdgeType(types[i]);
+        if (id < 0) return false;
+        typeIds[i] = static_cast<uint8_t>(id);
+    }
+
+    std::vector<uint32_t> outCounts(nodes.size(), 0);
+    for (const auto& e : edgeList) {
+        if (e.from >= nodes.size() || e.to >= nodes.size() || e.type >= types.size()) return false;
+        outCounts[e.from]++;
+    }
+
+    // Element references stay valid across rehashing, so resolve each node once
+    adjList.reserve(nodes.size());
+    inDegrees.reserve(nodes.size());
+    std::vector<std::vector<std::string>*> outLists(nodes.size());
+    std::vector<std::unordered_map<std::string, EdgeData>*> outEdges(nodes.size(), nullptr);
+    std::vector<int*> inCounts(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        outLists[i] = &adjList[nodes[i]];
+        inCounts[i] = &inDegrees[nodes[i]];
+        if (outCounts[i] == 0) continue;
+        outLists[i]->reserve(outCounts[i]);
+        outEdges[i] = &edges[nodes[i]];
+        outEdges[i]->reserve(outCounts[i]);
+    }
+
+    for (const auto& e : edgeList) {
+        EdgeData data{e.weight, typeIds[e.type]};
+        auto [it, inserted] = outEdges[e.from]->emplace(nodes[e.to], data);
+        if (!inserted) {
+            it->second = data;
+            continue;
+        }
+        outLists[e.from]->push_back(nodes[e.to]);
+        (*inCounts[e.to])++;
+        edgeCount++;
+    }
+
+    // Component ids are rebuilt by the first query that needs them
+    componentsDirty = true;
+    version++;
+    return true;
 }
 
 // checking if node exists
@@ -80,16 +276,16 @@ bool Graph::hasNode(const std::string& node) const {
 
 // checking if edge exists
 bool Graph::hasEdge(const std::string& from, const std::string& to) const {
-    if (adjList.find(from) == adjList.end()) return false;
-    const auto& neighbors = adjList.at(from);
-    return std::find(neighbors.begin(), neighbors.end(), to) != neighbors.end();
+    auto it = edges.find(from);
+    return it != edges.end() && it->second.find(to) != it->second.end();
 }
 
 // edge weight
 int Graph::getEdgeWeight(const std::string& from, const std::string& to) const {
-    if (weights.find(from) != weights.end() && 
-        weights.at(from).find(to) != weights.at(from).end()) {
-        return weights.at(from).at(to);
+    auto it = edges.find(from);
+    if (it != edges.end()) {
+        auto edge = it->second.find(to);
+        if (edge != it->second.end()) return edge->second.weight;
     }
     return 1; 
 }
@@ -97,8 +293,44 @@ int Graph::getEdgeWeight(const std::string& from, const std::string& to) const {
 // edge weight
 void Graph::setEdgeWeight(const std::string& from, const std::string& to, int weight) {
     if (hasEdge(from, to)) {
-        weights[from][to] = weight;
+        version++;
+        edges[from][to].weight = weight;
+    }
+}
+
+// edge type name, empty when there is no such edge
+std::string Graph::getEdgeType(const std::string& from, const std::string& to) const {
+    auto it = edges.find(from);
+    if (it == edges.end()) return "";
+    auto edge = it->second.find(to);
+    return edge == it->second.end() ? "" : edgeTypeNames[edge->second.type];
+}
+
+bool Graph::setEdgeType(const std::string& from, const std::string& to, const std::string& type) {
+    if (!hasEdge(from, to)) return false;
+    int typeId = internEdgeType(type);
+    if (typeId < 0) return false;
+    version++;
+    edges[from][to].type = static_cast<uint8_t>(typeId);
+    return true;
+}
+
+int Graph::getEdgeTypeId(const std::string& type) const {
+    auto it = edgeTypeIds.find(type);
+    return it == edgeTypeIds.end() ? -1 : it->second;
+}
+
+std::vector<std::string> Graph::getEdgeTypes() const {
+    return edgeTypeNames;
+}
+
+Graph::EdgeTypeMask Graph::makeEdgeTypeMask(const std::vector<std::string>& types) const {
+    EdgeTypeMask mask = 0;
+    for (const auto& type : types) {
+        int id = getEdgeTypeId(type);
+        if (id >= 0) mask |= EdgeTypeMask(1) << id;
     }
+    return mask;
 }
 
 // neighbors of a node
@@ -107,6 +339,21 @@ std::vector<std::string> Graph::getNeighbors(const std::string& node) const {
     return adjList.at(node);
 }
 
+// neighbors over edges of the given types
+std::vector<std::string> Graph::getNeighbors(const std::string& node, EdgeTypeMask types) const {
+    auto found = adjList.find(node);
+    if (found == adjList.end()) return {};
+    // Nodes added without edges have no entry here
+    auto outEdges = edges.find(node);
+    if (outEdges == edges.end()) return {};
+
+    std::vector<std::string> result;
+    for (const auto& neighbor : found->second) {
+        if (types & (EdgeTypeMask(1) << outEdges->second.at(neighbor).type)) result.push_back(neighbor);
+    }
+    return result;
+}
+
 // all nodes
 std::vector<std::string> Graph::getAllNodes() const {
     std::vector<std::string> nodes;
@@ -127,6 +374,74 @@ std::vector<std::pair<std::string, std::string>> Graph::getAllEdges() const {
     return edges;
 }
 
+// dense CSR copy
+Graph::DenseView Graph::buildDenseView() const {
+    DenseView view;
+    view.names.reserve(adjList.size());
+    for (const auto& pair : adjList) view.names.push_back(pair.first);
+    std::sort(view.names.begin(), view.names.end());
+
+    view.ids.reserve(view.names.size());
+    for (size_t i = 0; i < view.names.size(); i++) view.ids.emplace(view.names[i], static_cast<int>(i));
+
+    view.offsets.reserve(view.names.size() + 1);
+    view.offsets.push_back(0);
+    view.targets.reserve(edgeCount);
+    view.weights.reserve(edgeCount);
+    view.edgeTypes.reserve(edgeCount);
+    std::vector<int> typeCounts(edgeTypeNames.size(), 0);
+    for (const auto& name : view.names) {
+        const auto& neighbors = adjList.at(name);
+        auto nodeEdges = edges.find(name);
+        for (const auto& neighbor : neighbors) {
+            const EdgeData& edge = nodeEdges->second.at(neighbor);
+            view.targets.push_back(view.ids.at(neighbor));
+            view.weights.push_back(edge.weight);
+            view.edgeTypes.push_back(edge.type);
+            typeCounts[edge.type]++;
+        }
+        view.offsets.push_back(static_cast<int>(view.targets.size()));
+    }
+
+    // Split the adjacency by type, keeping each node's neighbour order
+    int n = view.nodeCount();
+    view.byType.resize(edgeTypeNames.size());
+    for (size_t t = 0; t < view.byType.size(); t++) {
+        view.byType[t].offsets.reserve(n + 1);
+        view.byType[t].offsets.push_back(0);
+        view.byType[t].targets.reserve(typeCounts[t]);
+    }
+    for (int u = 0; u < n; u++) {
+        for (int e = view.offsets[u]; e < view.offsets[u + 1]; e++) {
+            view.byType[view.edgeTypes[e]].targets.push_back(view.targets[e]);
+        }
+        for (auto& part : view.byType) part.offsets.push_back(static_cast<int>(part.targets.size()));
+    }
+    return view;
+}
+
+std::shared_ptr<const Graph::DenseView> Graph::getDenseView() const {
+    if (!denseCache || denseCacheVersion != version) {
+        denseCache = std::make_shared<const DenseView>(buildDenseView());
+        denseCacheVersion = version;
+    }
+    return denseCache;
+}
+
+uint64_t Graph::getVersion() const {
+    return version;
+}
+
+// graph from an edge list
+Graph Graph::fromEdges(const std::vector<WeightedEdge>& edges, bool bidirectional) {
+    Graph graph;
+    for (const auto& edge : edges) {
+        graph.addEdge(edge.from, edge.to, edge.weight);
+        if (bidirectional) graph.addEdge(edge.to, edge.from, edge.weight);
+    }
+    return graph;
+}
+
 // node degree
 int Graph::getNodeDegree(const std::string& node) const {
     return getOutDegree(node) + getInDegree(node);
@@ -140,13 +455,8 @@ int Graph::getOutDegree(const std::string& node) const {
 
 // in-degree
 int Graph::getInDegree(const std::string& node) const {
-    int count = 0;
-    for (const auto& pair : adjList) {
-        for (const auto& neighbor : pair.second) {
-            if (neighbor == node) count++;
-        }
-    }
-    return count;
+    auto it = inDegrees.find(node);
+    return it == inDegrees.end() ? 0 : it->second;
 }
 
 // node count
@@ -156,11 +466,7 @@ int Graph::getNodeCount() const {
 
 // edge count
 int Graph::getEdgeCount() const {
-    int count = 0;
-    for (const auto& pair : adjList) {
-        count += pair.second.size();
-    }
-    return count;
+    return edgeCount;
 }
 
 // graph is empty
@@ -169,7 +475,7 @@ bool Graph::isEmpty() const {
 }
 
 // bfs
-void Graph::bfs(const std::string& start, std::function<void(const std::string&)> visit) const {
+void Graph::bfs(const std::string& start, const std::function<void(const std::string&)>& visit) const {
     if (!hasNode(start)) return;
     
     std::unordered_map<std::string, bool> visited;
@@ -193,24 +499,14 @@ void Graph::bfs(const std::string& start, std::function<void(const std::string&)
     }
 }
 
-// DFS
-void Graph::dfs(const std::string& start, std::function<void(const std::string&)> visit) const {
+// DFS (preorder, neighbours in insertion order)
+void Graph::dfs(const std::string& start, const std::function<void(const std::string&)>& visit) const {
     if (!hasNode(start)) return;
     
-    std::unordered_map<std::string, bool> visited;
-    dfsHelper(start, visited, visit);
-}
-
-void Graph::dfsHelper(const std::string& node, std::unordered_map<std::string, bool>& visited, 
-                    std::function<void(const std::string&)> visit) const {
-    visited[node] = true;
-    visit(node);
-    
-    for (const auto& neighbor : getNeighbors(node)) {
-        if (!visited[neighbor]) {
-            dfsHelper(neighbor, visited, visit);
-        }
-    }
+    auto view = getDenseView();
+    std::vector<char> visited(view->nodeCount(), 0);
+    std::vector<Frame> stack;
+    denseDfs(*view, view->ids.at(start), visited, stack, [&](int node) { visit(view->names[node]); });
 }
 
 // shortest path (BFS )
@@ -253,35 +549,72 @@ std::vector<std::string> Graph::shortestPath(const std::string& start, const std
     return {}; 
 }
 
+// shortest path using only edges of the given types
+std::vector<std::string> Graph::shortestPath(const std::string& start, const std::string& end,
+                                             EdgeTypeMask types) const {
+    auto view = getDenseView();
+    auto from = view->ids.find(start);
+    auto to = view->ids.find(end);
+    if (from == view->ids.end() || to == view->ids.end()) return {};
+
+    std::vector<int> parent(view->nodeCount(), -1);
+    std::vector<int> queue{from->second};
+    parent[from->second] = from->second;
+    for (size_t head = 0; head < queue.size() && parent[to->second] < 0; head++) {
+        int u = queue[head];
+        view->forEachNeighbor(u, types, [&](int v) {
+            if (parent[v] >= 0) return;
+            parent[v] = u;
+            queue.push_back(v);
+        });
+    }
+    if (parent[to->second] < 0) return {};
+
+    std::vector<std::string> path;
+    for (int node = to->second; ; node = parent[node]) {
+        path.push_back(view->names[node]);
+        if (node == from->second) break;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
 // all paths between two nodes
 std::vector<std::vector<std::string>> Graph::findAllPaths(const std::string& start, const std::string& end) const {
     std::vector<std::vector<std::string>> allPaths;
     if (!hasNode(start) || !hasNode(end)) return allPaths;
     
-    std::unordered_map<std::string, bool> visited;
-    std::vector<std::string> path;
-    findPathsHelper(start, end, visited, path, allPaths);
-    return allPaths;
-}
+    // Backtracking over simple paths; the stack holds the current path
+    auto view = getDenseView();
+    const DenseView& g = *view;
+    int target = g.ids.at(end);
+    std::vector<char> onPath(g.nodeCount(), 0);
+    std::vector<Frame> stack;
 
-void Graph::findPathsHelper(const std::string& current, const std::string& end,
-                        std::unordered_map<std::string, bool>& visited,
-                        std::vector<std::string>& path, std::vector<std::vector<std::string>>& allPaths) const {
-    visited[current] = true;
-    path.push_back(current);
-    
-    if (current == end) {
-        allPaths.push_back(path);
-    } else {
-        for (const auto& neighbor : getNeighbors(current)) {
-            if (!visited[neighbor]) {
-                findPathsHelper(neighbor, end, visited, path, allPaths);
+    int source = g.ids.at(start);
+    stack.push_back({source, g.offsets[source]});
+    onPath[source] = 1;
+    while (!stack.empty()) {
+        Frame& top = stack.back();
+        int u = top.node;
+        if (u == target || top.edge == g.offsets[u + 1]) {
+            if (u == target) {
+                std::vector<std::string> path;
+                path.reserve(stack.size());
+                for (const auto& frame : stack) path.push_back(g.names[frame.node]);
+                allPaths.push_back(std::move(path));
             }
+            onPath[u] = 0;
+            stack.pop_back();
+            continue;
+        }
+        int v = g.targets[top.edge++];
+        if (!onPath[v]) {
+            onPath[v] = 1;
+            stack.push_back({v, g.offsets[v]});
         }
     }
-    
-    path.pop_back();
-    visited[current] = false;
+    return allPaths;
 }
 
 // shortest path length
@@ -290,219 +623,169 @@ int Graph::shortestPathLength(const std::string& start, const std::string& end)
     return path.empty() ? -1 : path.size() - 1;
 }
 
-// checking if graph is connected
+// checking if graph is connected (everything reachable from the first node)
 bool Graph::isConnected() const {
     if (isEmpty()) return true;
     
-    auto nodes = getAllNodes();
-    if (nodes.empty()) return true;
-    
-    std::unordered_map<std::string, bool> visited;
-    dfsHelper(nodes[0], visited, [](const std::string&) {});
+    auto view = getDenseView();
+    std::vector<char> visited(view->nodeCount(), 0);
+    std::vector<Frame> stack;
+    int reached = 0;
+    denseDfs(*view, 0, visited, stack, [&](int) { reached++; });
     
-    return visited.size() == nodes.size();
+    return reached == view->nodeCount();
 }
 
-// checking if graph has cycle
+// checking if graph has a directed cycle (white/grey/black colouring)
 bool Graph::hasCycle() const {
-    std::unordered_map<std::string, bool> visited;
-    std::unordered_map<std::string, bool> recStack;
-    
-    for (const auto& node : getAllNodes()) {
-        if (!visited[node]) {
-            if (hasCycleHelper(node, visited, recStack)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
+    auto view = getDenseView();
+    const DenseView& g = *view;
+    std::vector<char> colour(g.nodeCount(), 0);  // 0 new, 1 on stack, 2 done
+    std::vector<Frame> stack;
 
-bool Graph::hasCycleHelper(const std::string& node, std::unordered_map<std::string, bool>& visited,
-                        std::unordered_map<std::string, bool>& recStack) const {
-    if (!visited[node]) {
-        visited[node] = true;
-        recStack[node] = true;
-        
-        for (const auto& neighbor : getNeighbors(node)) {
-            if (!visited[neighbor] && hasCycleHelper(neighbor, visited, recStack)) {
-                return true;
-            } else if (recStack[neighbor]) {
-                return true;
+    for (int root = 0; root < g.nodeCount(); root++) {
+        if (colour[root]) continue;
+        colour[root] = 1;
+        stack.push_back({root, g.offsets[root]});
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.edge == g.offsets[top.node + 1]) {
+                colour[top.node] = 2;
+                stack.pop_back();
+                continue;
+            }
+            int v = g.targets[top.edge++];
+            if (colour[v] == 1) return true;
+            if (colour[v] == 0) {
+                colour[v] = 1;
+                stack.push_back({v, g.offsets[v]});
             }
         }
     }
-    
-    recStack[node] = false;
     return false;
 }
 
-// Topological sort
+// Topological sort (reverse DFS postorder)
 std::vector<std::string> Graph::topologicalSort() const {
     std::vector<std::string> result;
     if (hasCycle()) return result; // Only for DAGs
     
-    std::unordered_map<std::string, bool> visited;
-    std::stack<std::string> stack;
-    
-    for (const auto& node : getAllNodes()) {
-        if (!visited[node]) {
-            // DFS for topological sort
-            std::function<void(const std::string&)> dfsTopo = [&](const std::string& n) {
-                visited[n] = true;
-                for (const auto& neighbor : getNeighbors(n)) {
-                    if (!visited[neighbor]) {
-                        dfsTopo(neighbor);
-                    }
-                }
-                stack.push(n);
-            };
-            dfsTopo(node);
+    auto view = getDenseView();
+    const DenseView& g = *view;
+    std::vector<char> visited(g.nodeCount(), 0);
+    std::vector<Frame> stack;
+    std::vector<int> postorder;
+    postorder.reserve(g.nodeCount());
+
+    for (int root = 0; root < g.nodeCount(); root++) {
+        if (visited[root]) continue;
+        visited[root] = 1;
+        stack.push_back({root, g.offsets[root]});
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.edge == g.offsets[top.node + 1]) {
+                postorder.push_back(top.node);
+                stack.pop_back();
+                continue;
+            }
+            int v = g.targets[top.edge++];
+            if (!visited[v]) {
+                visited[v] = 1;
+                stack.push_back({v, g.offsets[v]});
+            }
         }
     }
     
-    while (!stack.empty()) {
-        result.push_back(stack.top());
-        stack.pop();
-    }
-    
+    result.reserve(postorder.size());
+    for (auto it = postorder.rbegin(); it != postorder.rend(); ++it) result.push_back(g.names[*it]);
     return result;
 }
 
-// connected components
+// connected components (weak), from the union-find; nodes in name order
 std::vector<std::vector<std::string>> Graph::findConnectedComponents() const {
-    std::vector<std::vector<std::string>> components;
-    std::unordered_map<std::string, bool> visited;
-    
-    for (const auto& node : getAllNodes()) {
-        if (!visited[node]) {
-            std::vector<std::string> component;
-            dfsHelper(node, visited, [&](const std::string& n) {
-                component.push_back(n);
-            });
-            components.push_back(component);
-        }
+    std::vector<std::vector<std::string>> result;
+    auto view = getDenseView();
+    std::unordered_map<int, size_t> slotForRoot;
+    
+    for (const auto& name : view->names) {
+        int root = components.find(componentIndex(name));
+        auto slot = slotForRoot.emplace(root, result.size());
+        if (slot.second) result.emplace_back();
+        result[slot.first->second].push_back(name);
     }
     
-    return components;
+    return result;
+}
+
+void Graph::rebuildComponents() const {
+    componentIds.clear();
+    componentIds.reserve(adjList.size());
+    components.reset(static_cast<int>(adjList.size()));
+    int next = 0;
+    for (const auto& pair : adjList) componentIds.emplace(pair.first, next++);
+    for (const auto& pair : adjList) {
+        int from = componentIds.at(pair.first);
+        for (const auto& neighbor : pair.second) components.unite(from, componentIds.at(neighbor));
+    }
+    componentsDirty = false;
+}
+
+int Graph::componentIndex(const std::string& node) const {
+    if (componentsDirty) rebuildComponents();
+    auto it = componentIds.find(node);
+    return it == componentIds.end() ? -1 : it->second;
+}
+
+bool Graph::sameComponent(const std::string& a, const std::string& b) const {
+    int x = componentIndex(a);
+    int y = componentIndex(b);
+    return x >= 0 && y >= 0 && components.connected(x, y);
+}
+
+int Graph::getComponentSize(const std::string& node) const {
+    int index = componentIndex(node);
+    return index < 0 ? 0 : components.componentSize(index);
+}
+
+int Graph::getComponentCount() const {
+    if (componentsDirty) rebuildComponents();
+    return components.getComponentCount();
 }
 
 // articulation points
 std::vector<std::string> Graph::findArticulationPoints() const {
     std::vector<std::string> ap;
-    std::unordered_map<std::string, bool> visited;
-    std::unordered_map<std::string, int> disc;
-    std::unordered_map<std::string, int> low;
-    std::unordered_map<std::string, std::string> parent;
-    int time = 0;
-    
-    for (const auto& node : getAllNodes()) {
-        if (!visited[node]) {
-            articulationPointsHelper(node, visited, disc, low, parent, ap, time);
-        }
-    }
-    
+    auto view = getDenseView();
+    lowLinkDfs(*view, [&](int u) { ap.push_back(view->names[u]); }, nullptr);
     return ap;
 }
 
-void Graph::articulationPointsHelper(const std::string& u, std::unordered_map<std::string, bool>& visited,
-                                    std::unordered_map<std::string, int>& disc,
-                                    std::unordered_map<std::string, int>& low,
-                                    std::unordered_map<std::string, std::string>& parent,
-                                    std::vector<std::string>& ap, int& time) const {
-    int children = 0;
-    
-    visited[u] = true;
-    disc[u] = low[u] = ++time;
-    
-    for (const auto& v : getNeighbors(u)) {
-        if (!visited[v]) {
-            children++;
-            parent[v] = u;
-            articulationPointsHelper(v, visited, disc, low, parent, ap, time);
-            
-            low[u] = std::min(low[u], low[v]);
-            
-            // u is articulation point if:
-            // 1. It's root and has 2+ children
-            // 2. It's not root and low[v] >= disc[u]
-            if (parent[u].empty() && children > 1) {
-                if (std::find(ap.begin(), ap.end(), u) == ap.end()) {
-                    ap.push_back(u);
-                }
-            }
-            if (!parent[u].empty() && low[v] >= disc[u]) {
-                if (std::find(ap.begin(), ap.end(), u) == ap.end()) {
-                    ap.push_back(u);
-                }
-            }
-        } else if (v != parent[u]) {
-            low[u] = std::min(low[u], disc[v]);
-        }
-    }
-}
-
 // bridges
 std::vector<std::pair<std::string, std::string>> Graph::findBridges() const {
     std::vector<std::pair<std::string, std::string>> bridges;
-    std::unordered_map<std::string, bool> visited;
-    std::unordered_map<std::string, int> disc;
-    std::unordered_map<std::string, int> low;
-    std::unordered_map<std::string, std::string> parent;
-    int time = 0;
-    
-    for (const auto& node : getAllNodes()) {
-        if (!visited[node]) {
-            bridgesHelper(node, visited, disc, low, parent, bridges, time);
-        }
-    }
-    
+    auto view = getDenseView();
+    lowLinkDfs(*view, nullptr, [&](int u, int v) { bridges.push_back({view->names[u], view->names[v]}); });
     return bridges;
 }
 
-void Graph::bridgesHelper(const std::string& u, std::unordered_map<std::string, bool>& visited,
-                        std::unordered_map<std::string, int>& disc,
-                        std::unordered_map<std::string, int>& low,
-                        std::unordered_map<std::string, std::string>& parent,
-                        std::vector<std::pair<std::string, std::string>>& bridges, int& time) const {
-    
-    visited[u] = true;
-    disc[u] = low[u] = ++time;
-    
-    for (const auto& v : getNeighbors(u)) {
-        if (!visited[v]) {
-            parent[v] = u;
-            bridgesHelper(v, visited, disc, low, parent, bridges, time);
-            
-            low[u] = std::min(low[u], low[v]);
-            
-            // If the lowest vertex reachable from subtree under v is below u in DFS tree,
-            // then u-v is a bridge
-            if (low[v] > disc[u]) {
-                bridges.push_back({u, v});
-            }
-        } else if (v != parent[u]) {
-            low[u] = std::min(low[u], disc[v]);
-        }
-    }
-}
-
 // most connected nodes
+// Top-k over the degree counters; ties come back in name order
 std::vector<std::string> Graph::getMostConnectedNodes(int count) const {
-    std::vector<std::pair<std::string, int>> nodeDegrees;
-    
-    for (const auto& node : getAllNodes()) {
-        nodeDegrees.push_back({node, getNodeDegree(node)});
+    if (count <= 0) return {};
+    std::vector<std::pair<int, const std::string*>> ranked;
+    ranked.reserve(adjList.size());
+    for (const auto& pair : adjList) {
+        ranked.emplace_back(static_cast<int>(pair.second.size()) + getInDegree(pair.first), &pair.first);
     }
-    
-    std::sort(nodeDegrees.begin(), nodeDegrees.end(),
-            [](const auto& a, const auto& b) { return a.second > b.second; });
-    
+
+    size_t k = std::min(ranked.size(), static_cast<size_t>(count));
+    std::partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : *a.second < *b.second;
+    });
+
     std::vector<std::string> result;
-    for (int i = 0; i < std::min(count, static_cast<int>(nodeDegrees.size())); i++) {
-        result.push_back(nodeDegrees[i].first);
-    }
-    
+    result.reserve(k);
+    for (size_t i = 0; i < k; i++) result.push_back(*ranked[i].second);
     return result;
 }
 
@@ -542,7 +825,7 @@ Graph Graph::getSubgraph(const std::vector<std::string>& nodes) const {
             subgraph.addNode(node);
             for (const auto& neighbor : getNeighbors(node)) {
                 if (std::find(nodes.begin(), nodes.end(), neighbor) != nodes.end()) {
-                    subgraph.addEdge(node, neighbor, getEdgeWeight(node, neighbor));
+                    subgraph.addEdge(node, neighbor, getEdgeType(node, neighbor), getEdgeWeight(node, neighbor));
                 }
             }
         }
@@ -557,7 +840,8 @@ Graph Graph::getTranspose() const {
     
     for (const auto& pair : adjList) {
         for (const auto& neighbor : pair.second) {
-            transpose.addEdge(neighbor, pair.first, getEdgeWeight(pair.first, neighbor));
+            transpose.addEdge(neighbor, pair.first, getEdgeType(pair.first, neighbor),
+                              getEdgeWeight(pair.first, neighbor));
         }
     }
     
@@ -570,11 +854,9 @@ void Graph::displayGraph() const {
     for (const auto& pair : adjList) {
         std::cout << pair.first << " -> ";
         for (const auto& neighbor : pair.second) {
-            std::cout << neighbor;
-            if (weights.find(pair.first) != weights.end() && 
-                weights.at(pair.first).find(neighbor) != weights.at(pair.first).end()) {
-                std::cout << "(" << weights.at(pair.first).at(neighbor) << ")";
-            }
+            const EdgeData& edge = edges.at(pair.first).at(neighbor);
+            std::cout << neighbor << "(" << edge.weight << ")";
+            if (edge.type != 0) std::cout << "[" << edgeTypeNames[edge.type] << "]";
             std::cout << " ";
         }
         std::cout << "\n";
@@ -652,53 +934,47 @@ bool Graph::isBipartite() const {
     return true;
 }
 
-// minimum spanning tree (Prim's algorithm)
-Graph Graph::getMinimumSpanningTree() const {
-    Graph mst;
-    if (isEmpty()) return mst;
-    
-    auto nodes = getAllNodes();
-    std::unordered_map<std::string, bool> inMST;
-    std::unordered_map<std::string, int> key;
-    std::unordered_map<std::string, std::string> parent;
-    
-    for (const auto& node : nodes) {
-        key[node] = std::numeric_limits<int>::max();
-        inMST[node] = false;
-    }
-    
-    key[nodes[0]] = 0;
-    parent[nodes[0]] = "";
-    
-    for (size_t i = 0; i < nodes.size() - 1; i++) {
-        // min key vertex not in MST
-        std::string u;
-        int minKey = std::numeric_limits<int>::max();
-        for (const auto& node : nodes) {
-            if (!inMST[node] && key[node] < minKey) {
-                minKey = key[node];
-                u = node;
-            }
-        }
-        
-        inMST[u] = true;
-        
-        // adding edge to MST
-        if (!parent[u].empty()) {
-            mst.addEdge(parent[u], u, getEdgeWeight(parent[u], u));
-            mst.addEdge(u, parent[u], getEdgeWeight(u, parent[u]));
-        }
-        
-        
-        for (const auto& v : getNeighbors(u)) {
-            int weight = getEdgeWeight(u, v);
-            if (!inMST[v] && weight < key[v]) {
-                parent[v] = u;
-                key[v] = weight;
-            }
+// Minimum spanning forest (Kruskal): sort the edges once, then grow trees
+// with union-find. Covers every component, O(E log E).
+std::vector<WeightedEdge> Graph::getMinimumSpanningForest() const {
+    std::vector<WeightedEdge> forest;
+    DenseView view = buildDenseView();
+    int n = view.nodeCount();
+    if (n == 0) return forest;
+
+    struct Candidate {
+        int weight;
+        int a;
+        int b;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(view.targets.size());
+    for (int u = 0; u < n; u++) {
+        for (int e = view.offsets[u]; e < view.offsets[u + 1]; e++) {
+            int v = view.targets[e];
+            if (u == v) continue;
+            candidates.push_back({view.weights[e], std::min(u, v), std::max(u, v)});
         }
     }
-    
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& x, const Candidate& y) {
+        if (x.weight != y.weight) return x.weight < y.weight;
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+
+    UnionFind sets(n);
+    forest.reserve(n - 1);
+    for (const auto& c : candidates) {
+        if (!sets.unite(c.a, c.b)) continue;
+        forest.push_back({view.names[c.a], view.names[c.b], c.weight});
+        if (sets.getComponentCount() == 1) break;
+    }
+    return forest;
+}
+
+// minimum spanning tree as a Graph: every node, forest edges in both directions
+Graph Graph::getMinimumSpanningTree() const {
+    Graph mst = fromEdges(getMinimumSpanningForest());
+    for (const auto& pair : adjList) mst.addNode(pair.first);
     return mst;
 }
 
@@ -4,62 +4,152 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include "union_find.h"
+
+struct WeightedEdge {
+    std::string from;
+    std::string to;
+    int weight;
+};
+
+// Edge given by position in the node and type lists of Graph::assign
+struct IndexedEdge {
+    uint32_t from;
+    uint32_t to;
+    int weight;
+    uint32_t type;
+};
 
 class Graph {
+public:
+    // Every edge carries a type: a small id named on first use. Type 0 is
+    // DEFAULT_EDGE_TYPE; a set of types is a bitmask over the ids.
+    using EdgeTypeMask = uint64_t;
+    static constexpr int MAX_EDGE_TYPES = 64;
+    static constexpr EdgeTypeMask ALL_EDGE_TYPES = ~EdgeTypeMask(0);
+    static constexpr const char* DEFAULT_EDGE_TYPE = "related";
+
+    // Read-only copy of the graph with nodes numbered 0..V-1 in name order and
+    // adjacency in compressed sparse row form: the neighbours of node i are
+    // targets[offsets[i] .. offsets[i + 1]).
+    struct DenseView {
+        // The same layout restricted to one edge type
+        struct Partition {
+            std::vector<int> offsets;
+            std::vector<int> targets;
+        };
+
+        std::vector<std::string> names;
+        std::unordered_map<std::string, int> ids;
+        std::vector<int> offsets;
+        std::vector<int> targets;
+        std::vector<int> weights;
+        std::vector<uint8_t> edgeTypes;     // parallel to targets
+        std::vector<Partition> byType;      // indexed by edge type id
+
+        int nodeCount() const { return static_cast<int>(names.size()); }
+
+        // Calls visit(target) for each edge of node whose type is in types,
+        // touching only the partitions asked for
+        template <typename Visit>
+        void forEachNeighbor(int node, EdgeTypeMask types, Visit&& visit) const {
+            EdgeTypeMask used = byType.size() >= 64 ? ALL_EDGE_TYPES : (EdgeTypeMask(1) << byType.size()) - 1;
+            if ((types & used) == used) {
+                for (int e = offsets[node]; e < offsets[node + 1]; e++) visit(targets[e]);
+                return;
+            }
+            for (size_t t = 0; t < byType.size(); t++) {
+                if (!(types & (EdgeTypeMask(1) << t))) continue;
+                const Partition& part = byType[t];
+                for (int e = part.offsets[node]; e < part.offsets[node + 1]; e++) visit(part.targets[e]);
+            }
+        }
+    };
+
 private:
+    struct EdgeData {
+        int weight;
+        uint8_t type;
+    };
+
     std::unordered_map<std::string, std::vector<std::string>> adjList;
-    std::unordered_map<std::string, std::unordered_map<std::string, int>> weights;
-
-    // Helper functions
-    void dfsHelper(const std::string& node, 
-                std::unordered_map<std::string, bool>& visited,
-                std::function<void(const std::string&)> visit) const;
-    
-    void findPathsHelper(const std::string& current, const std::string& end,
-                        std::unordered_map<std::string, bool>& visited,
-                        std::vector<std::string>& path,
-                        std::vector<std::vector<std::string>>& allPaths) const;
-    
-    bool hasCycleHelper(const std::string& node,
-                    std::unordered_map<std::string, bool>& visited,
-                    std::unordered_map<std::string, bool>& recStack) const;
-    
-    void articulationPointsHelper(const std::string& u,
-                                std::unordered_map<std::string, bool>& visited,
-                                std::unordered_map<std::string, int>& disc,
-                                std::unordered_map<std::string, int>& low,
-                                std::unordered_map<std::string, std::string>& parent,
-                                std::vector<std::string>& ap, int& time) const;
-    
-    void bridgesHelper(const std::string& u,
-                    std::unordered_map<std::string, bool>& visited,
-                    std::unordered_map<std::string, int>& disc,
-                    std::unordered_map<std::string, int>& low,
-                    std::unordered_map<std::string, std::string>& parent,
-                    std::vector<std::pair<std::string, std::string>>& bridges,
-                    int& time) const;
+    // Exactly the edge set: from -> to -> weight and type
+    std::unordered_map<std::string, std::unordered_map<std::string, EdgeData>> edges;
+
+    std::vector<std::string> edgeTypeNames;
+    std::unordered_map<std::string, uint8_t> edgeTypeIds;
+
+    int internEdgeType(const std::string& type);
+    void insertEdge(const std::string& from, const std::string& to, int weight, int type);
+
+    // Degree counters, kept current by every mutation (out-degree is the
+    // adjacency list size)
+    std::unordered_map<std::string, int> inDegrees;
+    int edgeCount;
+
+    // Bumped by every mutation; the dense view is rebuilt when it goes stale.
+    // The caches below are filled by const queries without a lock, so even
+    // read-only use of one Graph must stay on one thread at a time.
+    uint64_t version;
+    mutable std::shared_ptr<const DenseView> denseCache;
+    mutable uint64_t denseCacheVersion;
+
+    // Weakly connected components. Edge additions union in place; removals
+    // only mark them dirty and the next query rebuilds from scratch.
+    mutable UnionFind components;
+    mutable std::unordered_map<std::string, int> componentIds;
+    mutable bool componentsDirty;
+
+    void rebuildComponents() const;
+    int componentIndex(const std::string& node) const;
 
 public:
     // Constructor and Destructor
     Graph();
     ~Graph();
+    Graph(const Graph&) = default;
+    Graph& operator=(const Graph&) = default;
+    Graph(Graph&&) = default;
+    Graph& operator=(Graph&&) = default;
 
     // Basic operations
     void addNode(const std::string& node);
+    // Untyped adds give new edges the default type and leave an existing edge's type alone
     void addEdge(const std::string& from, const std::string& to, int weight = 1);
+    // False if the type would be new and MAX_EDGE_TYPES are already in use
+    bool addEdge(const std::string& from, const std::string& to, const std::string& type, int weight = 1);
     void removeEdge(const std::string& from, const std::string& to);
     void removeNode(const std::string& node);
     void clear();
+    // Replaces the contents in one pass, skipping addEdge's per-edge lookups.
+    // An empty type name means the default type. False, leaving the graph
+    // empty, on an index out of range or too many types.
+    bool assign(const std::vector<std::string>& nodes, const std::vector<std::string>& types,
+                const std::vector<IndexedEdge>& edgeList);
 
     // Query operations
     bool hasNode(const std::string& node) const;
     bool hasEdge(const std::string& from, const std::string& to) const;
     int getEdgeWeight(const std::string& from, const std::string& to) const;
     void setEdgeWeight(const std::string& from, const std::string& to, int weight);
+    std::string getEdgeType(const std::string& from, const std::string& to) const;
+    bool setEdgeType(const std::string& from, const std::string& to, const std::string& type);
+    int getEdgeTypeId(const std::string& type) const;
+    std::vector<std::string> getEdgeTypes() const;
+    // Unknown names are left out of the mask
+    EdgeTypeMask makeEdgeTypeMask(const std::vector<std::string>& types) const;
     std::vector<std::string> getNeighbors(const std::string& node) const;
+    std::vector<std::string> getNeighbors(const std::string& node, EdgeTypeMask types) const;
     std::vector<std::string> getAllNodes() const;
     std::vector<std::pair<std::string, std::string>> getAllEdges() const;
+    DenseView buildDenseView() const;
+    // Cached buildDenseView(); shared so callers can keep it across mutations
+    std::shared_ptr<const DenseView> getDenseView() const;
+    uint64_t getVersion() const;
+    static Graph fromEdges(const std::vector<WeightedEdge>& edges, bool bidirectional = true);
 
     // Graph metrics
     int getNodeDegree(const std::string& node) const;
@@ -69,21 +159,28 @@ public:
     int getEdgeCount() const;
     bool isEmpty() const;
 
-    // Graph algorithms
+    // Graph algorithms. The DFS family runs iteratively on the dense view, so
+    // depth is bounded by memory rather than the call stack.
     void bfs(const std::string& start, 
-            std::function<void(const std::string&)> visit) const;
+            const std::function<void(const std::string&)>& visit) const;
     void dfs(const std::string& start, 
-            std::function<void(const std::string&)> visit) const;
+            const std::function<void(const std::string&)>& visit) const;
     std::vector<std::string> shortestPath(const std::string& start, const std::string& end) const;
+    std::vector<std::string> shortestPath(const std::string& start, const std::string& end, EdgeTypeMask types) const;
     std::vector<std::vector<std::string>> findAllPaths(const std::string& start, const std::string& end) const;
     int shortestPathLength(const std::string& start, const std::string& end) const;
     bool isConnected() const;
     bool hasCycle() const;
     std::vector<std::string> topologicalSort() const;
     std::vector<std::vector<std::string>> findConnectedComponents() const;
+    bool sameComponent(const std::string& a, const std::string& b) const;
+    int getComponentSize(const std::string& node) const;
+    int getComponentCount() const;
     std::vector<std::string> findArticulationPoints() const;
     std::vector<std::pair<std::string, std::string>> findBridges() const;
     bool isBipartite() const;
+    // Edges are treated as undirected; a pair linked both ways uses the lighter weight
+    std::vector<WeightedEdge> getMinimumSpanningForest() const;
     Graph getMinimumSpanningTree() const;
     std::vector<std::string> findEulerianPath() const;
     bool hasEulerianCircuit() const;
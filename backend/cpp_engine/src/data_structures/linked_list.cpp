@@ -1,7 +1,27 @@
 #include "linked_list.h"
 #include <algorithm>
 #include <iostream>
+#include <unordered_set>
 #include "../models/character.h"
+
+namespace {
+
+// Hashes whatever operator== compares, so equal elements land in one bucket
+struct IdentityHash {
+    template <typename V>
+    size_t operator()(const V* value) const { return std::hash<V>()(*value); }
+
+    size_t operator()(const Character* ch) const {
+        return std::hash<int>()(ch->getId()) * 31 + std::hash<std::string>()(ch->getName());
+    }
+};
+
+struct IdentityEqual {
+    template <typename V>
+    bool operator()(const V* a, const V* b) const { return *a == *b; }
+};
+
+} // namespace
 // Constructor
 template <typename T>
 LinkedList<T>::LinkedList() : head(nullptr), tail(nullptr), size(0) {}
@@ -14,7 +34,7 @@ LinkedList<T>::~LinkedList() {
 
 // Insert at the end
 template <typename T>
-void LinkedList<T>::insertAtEnd(T data) {
+typename LinkedList<T>::NodeHandle LinkedList<T>::insertAtEnd(T data) {
     ListNode* newNode = new ListNode(data);
     if (!head) {
         head = tail = newNode;
@@ -24,11 +44,12 @@ void LinkedList<T>::insertAtEnd(T data) {
         tail = newNode;
     }
     size++;
+    return newNode;
 }
 
 // Insert at the beginning
 template <typename T>
-void LinkedList<T>::insertAtBeginning(T data) {
+typename LinkedList<T>::NodeHandle LinkedList<T>::insertAtBeginning(T data) {
     ListNode* newNode = new ListNode(data);
     if (!head) {
         head = tail = newNode;
@@ -38,6 +59,7 @@ void LinkedList<T>::insertAtBeginning(T data) {
         head = newNode;
     }
     size++;
+    return newNode;
 }
 
 // Delete a node
@@ -46,24 +68,32 @@ void LinkedList<T>::deleteNode(T data) {
     ListNode* current = head;
     while (current) {
         if (current->data == data) {
-            if (current->prev)
-                current->prev->next = current->next;
-            else
-                head = current->next;
-
-            if (current->next)
-                current->next->prev = current->prev;
-            else
-                tail = current->prev;
-
-            delete current;
-            size--;
+            erase(current);
             return;
         }
         current = current->next;
     }
 }
 
+// Unlink and free a node by handle
+template <typename T>
+void LinkedList<T>::erase(NodeHandle node) {
+    if (!node) return;
+
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        head = node->next;
+
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        tail = node->prev;
+
+    delete node;
+    size--;
+}
+
 // Check if list contains data
 template <typename T>
 bool LinkedList<T>::contains(T data) const {
@@ -132,6 +162,17 @@ void LinkedList<T>::traverseConst(std::function<void(const T&)> func) const {
     }
 }
 
+// Traverse nodes, for callers that index the handles
+template <typename T>
+void LinkedList<T>::traverseNodes(std::function<void(NodeHandle)> func) {
+    ListNode* current = head;
+    while (current) {
+        ListNode* next = current->next;
+        func(current);
+        current = next;
+    }
+}
+
 // Search for data
 template <typename T>
 typename LinkedList<T>::ListNode* LinkedList<T>::search(T data) {
@@ -202,23 +243,14 @@ void LinkedList<T>::reverse() {
 template <typename T>
 void LinkedList<T>::removeDuplicates() {
     if (!head) return;
-    
+
+    std::unordered_set<const T*, IdentityHash, IdentityEqual> seen;
+    seen.reserve(size);
     ListNode* current = head;
-    while (current && current->next) {
-        ListNode* runner = current;
-        while (runner->next) {
-            if (runner->next->data == current->data) {
-                ListNode* duplicate = runner->next;
-                runner->next = runner->next->next;
-                if (runner->next) runner->next->prev = runner;
-                else tail = runner;
-                delete duplicate;
-                size--;
-            } else {
-                runner = runner->next;
-            }
-        }
-        current = current->next;
+    while (current) {
+        ListNode* next = current->next;
+        if (!seen.insert(&current->data).second) erase(current);
+        current = next;
     }
 }
 
@@ -226,7 +258,7 @@ void LinkedList<T>::removeDuplicates() {
 template <typename T>
 LinkedList<T> LinkedList<T>::filter(std::function<bool(const T&)> criteria) {
     LinkedList<T> result;
-    traverseConst([&](const T& data) {
+    forEach([&](const T& data) {
         if (criteria(data)) {
             result.insertAtEnd(data);
         }
@@ -234,28 +266,54 @@ LinkedList<T> LinkedList<T>::filter(std::function<bool(const T&)> criteria) {
     return result;
 }
 
-// Sort the list (bubble sort for simplicity)
+// Sort the list (merge sort, relinking nodes rather than moving data)
 template <typename T>
 void LinkedList<T>::sort(std::function<bool(const T&, const T&)> comparator) {
     if (!head || !head->next) return;
-    
-    bool swapped;
-    do {
-        swapped = false;
-        ListNode* current = head;
-        
-        while (current->next) {
-            bool shouldSwap = comparator ? 
-                comparator(current->data, current->next->data) : 
-                current->data > current->next->data;
-                
-            if (shouldSwap) {
-                std::swap(current->data, current->next->data);
-                swapped = true;
-            }
-            current = current->next;
-        }
-    } while (swapped);
+
+    Comparator after = comparator ? comparator : [](const T& a, const T& b) { return a > b; };
+    head = mergeSort(head, size, after);
+
+    // Restore the back links
+    head->prev = nullptr;
+    ListNode* current = head;
+    while (current->next) {
+        current->next->prev = current;
+        current = current->next;
+    }
+    tail = current;
+}
+
+// Sort the first `length` nodes from `first`; the result ends in nullptr
+template <typename T>
+typename LinkedList<T>::ListNode* LinkedList<T>::mergeSort(ListNode* first, int length, const Comparator& after) {
+    if (length <= 1) {
+        if (first) first->next = nullptr;
+        return first;
+    }
+
+    int leftLength = length / 2;
+    ListNode* middle = first;
+    for (int i = 0; i < leftLength; i++) middle = middle->next;
+
+    ListNode* left = mergeSort(first, leftLength, after);
+    ListNode* right = mergeSort(middle, length - leftLength, after);
+    return merge(left, right, after);
+}
+
+// Merge two sorted runs; ties take the left node, which keeps the sort stable
+template <typename T>
+typename LinkedList<T>::ListNode* LinkedList<T>::merge(ListNode* left, ListNode* right, const Comparator& after) {
+    ListNode* merged = nullptr;
+    ListNode** link = &merged;
+    while (left && right) {
+        ListNode*& taken = after(left->data, right->data) ? right : left;
+        *link = taken;
+        link = &taken->next;
+        taken = taken->next;
+    }
+    *link = left ? left : right;
+    return merged;
 }
 
 // Main function to test LinkedList
@@ -1,8 +1,12 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include <cstddef>
 #include <iostream>
 #include <functional>
+#include <iterator>
+#include <type_traits>
+#include "visitor.h"
 #include "../models/case.h"
 #include "../models/character.h"
 #include "../models/suspect.h"
@@ -17,20 +21,34 @@ private:
         
         ListNode(T val) : data(val), next(nullptr), prev(nullptr) {}
     };
-    
+
+public:
+    // Returned by the inserts; stays valid until that node is erased, so
+    // callers can keep it in an index and unlink in O(1). sort() relinks
+    // nodes and keeps handles valid; removeDuplicates() frees the dropped
+    // nodes, so their handles dangle afterwards.
+    using NodeHandle = ListNode*;
+
+private:
     ListNode* head;
     ListNode* tail;
     int size;
 
+    // Merge sort over the next links only; sort() repairs prev and tail
+    using Comparator = std::function<bool(const T&, const T&)>;
+    static ListNode* mergeSort(ListNode* first, int length, const Comparator& after);
+    static ListNode* merge(ListNode* left, ListNode* right, const Comparator& after);
+
 public:
     // Constructor and Destructor
     LinkedList();
     ~LinkedList();
 
     // Basic operations
-    void insertAtEnd(T data);
-    void insertAtBeginning(T data);
+    NodeHandle insertAtEnd(T data);
+    NodeHandle insertAtBeginning(T data);
     void deleteNode(T data);
+    void erase(NodeHandle node);
     void clear();
 
     // Query operations
@@ -45,14 +63,72 @@ public:
     // Traversal operations
     void traverse(std::function<void(T&)> func);
     void traverseConst(std::function<void(const T&)> func) const;
+    void traverseNodes(std::function<void(NodeHandle)> func);
+    // Inlined walk for hot scans: fn(T&) returns void, or bool where false
+    // stops early. Returns false if the walk was stopped.
+    template <typename F>
+    bool forEach(F&& fn) {
+        for (ListNode* current = head; current; current = current->next)
+            if (!continueVisit(fn, current->data)) return false;
+        return true;
+    }
+    template <typename F>
+    bool forEach(F&& fn) const {
+        for (const ListNode* current = head; current; current = current->next)
+            if (!continueVisit(fn, current->data)) return false;
+        return true;
+    }
     void displayForward() const;
     void displayBackward() const;
 
     // Utility operations
     void reverse();
-    void removeDuplicates();
+    void removeDuplicates();    // keeps first occurrences, O(n) expected
     LinkedList<T> filter(std::function<bool(const T&)> criteria);
+    // Stable; comparator(a, b) returns true when a belongs after b
     void sort(std::function<bool(const T&, const T&)> comparator = nullptr);
+
+    // Bidirectional iterators; valid until their own node is erased
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() : node(nullptr), list(nullptr) {}
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : node(other.node), list(other.list) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        Iterator& operator++() { node = node->next; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator& operator--() { node = node ? node->prev : list->tail; return *this; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+        // The node behind the iterator, for erase()
+        NodeHandle handle() const { return node; }
+
+    private:
+        friend class LinkedList;
+        template <bool> friend class Iterator;
+        Iterator(ListNode* node, const LinkedList* list) : node(node), list(list) {}
+
+        ListNode* node;     // nullptr at end()
+        const LinkedList* list;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return iterator(head, this); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator begin() const { return const_iterator(head, this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
 };
 
 #endif // LINKED_LIST_H
\ No newline at end of file
@@ -3,12 +3,14 @@
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <string_view>
 #include "../models/suspect.h"
 // Constructor
 template <typename T>
 RBTree<T>::RBTree() {
     TNULL = new RBNode<T>(T());
     TNULL->color = BLACK;
+    TNULL->size = 0;
     TNULL->left = TNULL->right = TNULL;
     root = TNULL;
 }
@@ -28,6 +30,7 @@ void RBTree<T>::initializeNULLNode(RBNode<T>* node, RBNode<T>* parent) {
     node->left = TNULL;
     node->right = TNULL;
     node->color = BLACK;
+    node->size = 0;
 }
 
 // Left rotate
@@ -50,6 +53,9 @@ void RBTree<T>::leftRotate(RBNode<T>* x) {
     
     y->left = x;
     x->parent = y;
+
+    y->size = x->size;
+    x->size = x->left->size + x->right->size + 1;
 }
 
 // Right rotate
@@ -72,6 +78,9 @@ void RBTree<T>::rightRotate(RBNode<T>* x) {
     
     y->right = x;
     x->parent = y;
+
+    y->size = x->size;
+    x->size = x->left->size + x->right->size + 1;
 }
 
 // Insert fixup
@@ -120,7 +129,7 @@ void RBTree<T>::insertFix(RBNode<T>* k) {
 // Public insert
 template <typename T>
 void RBTree<T>::insert(T key) {
-    RBNode<T>* node = new RBNode<T>(key);
+    RBNode<T>* node = new RBNode<T>(std::move(key));
     node->parent = nullptr;
     node->left = TNULL;
     node->right = TNULL;
@@ -131,6 +140,7 @@ void RBTree<T>::insert(T key) {
 
     while (x != TNULL) {
         y = x;
+        x->size++;
         if (node->data < x->data)
             x = x->left;
         else
@@ -244,32 +254,18 @@ RBNode<T>* RBTree<T>::maximum(RBNode<T>* node) {
     return node;
 }
 
-// Delete node helper
+// Delete node helper: unlinks and frees z
 template <typename T>
-void RBTree<T>::deleteNodeHelper(RBNode<T>* node, T key) {
-    RBNode<T>* z = TNULL;
+void RBTree<T>::deleteNodeHelper(RBNode<T>* z) {
     RBNode<T>* x, *y;
-    
-    // Find the node to delete
-    z = root;
-    while (z != TNULL) {
-        if (z->data == key) {
-            break;
-        }
-        if (z->data < key) {
-            z = z->right;
-        } else {
-            z = z->left;
-        }
-    }
-
-    if (z == TNULL) {
-        std::cout << "Key not found in the tree\n";
-        return;
-    }
 
     y = z;
     Color yOriginalColor = y->color;
+
+    // The node that leaves its position is z, or z's successor if z has two
+    // children; everything above that position loses one descendant
+    RBNode<T>* vacated = (z->left == TNULL || z->right == TNULL) ? z : minimum(z->right);
+    for (RBNode<T>* p = vacated->parent; p != nullptr; p = p->parent) p->size--;
     
     if (z->left == TNULL) {
         x = z->right;
@@ -294,6 +290,7 @@ void RBTree<T>::deleteNodeHelper(RBNode<T>* node, T key) {
         y->left = z->left;
         y->left->parent = y;
         y->color = z->color;
+        y->size = z->size;
     }
     
     delete z;
@@ -304,13 +301,56 @@ void RBTree<T>::deleteNodeHelper(RBNode<T>* node, T key) {
 
 // Public remove
 template <typename T>
-void RBTree<T>::remove(T key) {
-    deleteNodeHelper(root, key);
+void RBTree<T>::remove(const T& key) {
+    // Find the node to delete
+    RBNode<T>* z = root;
+    while (z != TNULL) {
+        if (z->data == key) {
+            break;
+        }
+        if (z->data < key) {
+            z = z->right;
+        } else {
+            z = z->left;
+        }
+    }
+
+    if (z == TNULL) {
+        std::cout << "Key not found in the tree\n";
+        return;
+    }
+    deleteNodeHelper(z);
+}
+
+// Node whose data is equivalent to key, or TNULL
+template <typename T>
+template <typename K>
+RBNode<T>* RBTree<T>::findNode(const K& key) const {
+    RBNode<T>* current = root;
+    while (current != TNULL) {
+        if (key < current->data)
+            current = current->left;
+        else if (current->data < key)
+            current = current->right;
+        else
+            break;
+    }
+    return current;
+}
+
+// Remove by key
+template <typename T>
+template <typename K>
+bool RBTree<T>::removeKey(const K& key) {
+    RBNode<T>* z = findNode(key);
+    if (z == TNULL) return false;
+    deleteNodeHelper(z);
+    return true;
 }
 
 // Search helper
 template <typename T>
-RBNode<T>* RBTree<T>::searchTreeHelper(RBNode<T>* node, T key) {
+RBNode<T>* RBTree<T>::searchTreeHelper(RBNode<T>* node, const T& key) {
     if (node == TNULL || key == node->data)
         return node;
     if (key < node->data)
@@ -320,7 +360,7 @@ RBNode<T>* RBTree<T>::searchTreeHelper(RBNode<T>* node, T key) {
 
 // Const search helper
 template <typename T>
-const RBNode<T>* RBTree<T>::searchTreeHelper(const RBNode<T>* node, T key) const {
+const RBNode<T>* RBTree<T>::searchTreeHelper(const RBNode<T>* node, const T& key) const {
     if (node == TNULL || key == node->data)
         return node;
     if (key < node->data)
@@ -330,7 +370,7 @@ const RBNode<T>* RBTree<T>::searchTreeHelper(const RBNode<T>* node, T key) const
 
 // Public search
 template <typename T>
-T* RBTree<T>::search(T key) {
+T* RBTree<T>::search(const T& key) {
     RBNode<T>* res = searchTreeHelper(root, key);
     if (res == TNULL) return nullptr;
     return &res->data;
@@ -338,7 +378,7 @@ T* RBTree<T>::search(T key) {
 
 // Const public search
 template <typename T>
-const T* RBTree<T>::search(T key) const {
+const T* RBTree<T>::search(const T& key) const {
     const RBNode<T>* res = searchTreeHelper(root, key);
     if (res == TNULL) return nullptr;
     return &res->data;
@@ -346,10 +386,25 @@ const T* RBTree<T>::search(T key) const {
 
 // Check if contains key
 template <typename T>
-bool RBTree<T>::contains(T key) {
+bool RBTree<T>::contains(const T& key) {
     return search(key) != nullptr;
 }
 
+// Search by key
+template <typename T>
+template <typename K>
+T* RBTree<T>::findKey(const K& key) {
+    RBNode<T>* node = findNode(key);
+    return node != TNULL ? &node->data : nullptr;
+}
+
+template <typename T>
+template <typename K>
+const T* RBTree<T>::findKey(const K& key) const {
+    RBNode<T>* node = findNode(key);
+    return node != TNULL ? &node->data : nullptr;
+}
+
 // Clear tree
 template <typename T>
 void RBTree<T>::clear() {
@@ -367,7 +422,7 @@ void RBTree<T>::clearTree(RBNode<T>* node) {
 
 // In-order traversal
 template <typename T>
-void RBTree<T>::inOrderHelper(RBNode<T>* node, std::function<void(T*)> fn) {
+void RBTree<T>::inOrderHelper(RBNode<T>* node, const std::function<void(T*)>& fn) {
     if (node == TNULL) return;
     inOrderHelper(node->left, fn);
     fn(&node->data);
@@ -381,7 +436,7 @@ void RBTree<T>::inOrderTraversal(std::function<void(T*)> fn) {
 
 // Const in-order traversal
 template <typename T>
-void RBTree<T>::inOrderHelper(const RBNode<T>* node, std::function<void(const T*)> fn) const {
+void RBTree<T>::inOrderHelper(const RBNode<T>* node, const std::function<void(const T*)>& fn) const {
     if (node == TNULL) return;
     inOrderHelper(node->left, fn);
     fn(&node->data);
@@ -395,7 +450,7 @@ void RBTree<T>::inOrderTraversal(std::function<void(const T*)> fn) const {
 
 // Pre-order traversal
 template <typename T>
-void RBTree<T>::preOrderHelper(RBNode<T>* node, std::function<void(T*)> fn) {
+void RBTree<T>::preOrderHelper(RBNode<T>* node, const std::function<void(T*)>& fn) {
     if (node == TNULL) return;
     fn(&node->data);
     preOrderHelper(node->left, fn);
@@ -409,7 +464,7 @@ void RBTree<T>::preOrderTraversal(std::function<void(T*)> fn) {
 
 // Post-order traversal
 template <typename T>
-void RBTree<T>::postOrderHelper(RBNode<T>* node, std::function<void(T*)> fn) {
+void RBTree<T>::postOrderHelper(RBNode<T>* node, const std::function<void(T*)>& fn) {
     if (node == TNULL) return;
     postOrderHelper(node->left, fn);
     postOrderHelper(node->right, fn);
@@ -455,13 +510,43 @@ int RBTree<T>::getHeight(RBNode<T>* node) {
 // Get tree size
 template <typename T>
 int RBTree<T>::getSize() const {
-    return getSize(root);
+    return root->size;
 }
 
+// Select by in-order index
 template <typename T>
-int RBTree<T>::getSize(RBNode<T>* node) const {
-    if (node == TNULL) return 0;
-    return 1 + getSize(node->left) + getSize(node->right);
+T* RBTree<T>::select(int index) {
+    if (index < 0 || index >= root->size) return nullptr;
+
+    RBNode<T>* current = root;
+    while (current != TNULL) {
+        int leftSize = current->left->size;
+        if (index < leftSize) {
+            current = current->left;
+        } else if (index == leftSize) {
+            return &current->data;
+        } else {
+            index -= leftSize + 1;
+            current = current->right;
+        }
+    }
+    return nullptr;
+}
+
+// Number of elements less than key
+template <typename T>
+int RBTree<T>::rank(const T& key) const {
+    int result = 0;
+    const RBNode<T>* current = root;
+    while (current != TNULL) {
+        if (current->data < key) {
+            result += current->left->size + 1;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return result;
 }
 
 // Check if empty
@@ -502,10 +587,10 @@ int RBTree<T>::countBlackNodes(RBNode<T>* node) {
 template <typename T>
 T* RBTree<T>::searchByCriteria(std::function<bool(const T&)> criteria) {
     T* result = nullptr;
-    inOrderTraversal([&](T* data) {
-        if (!result && criteria(*data)) {
-            result = data;
-        }
+    forEach([&](T* data) {
+        if (!criteria(*data)) return true;
+        result = data;
+        return false;
     });
     return result;
 }
@@ -530,7 +615,7 @@ void RBTree<T>::collectNodes(RBNode<T>* node, std::vector<T>& collection) {
 template <typename T>
 std::vector<T> RBTree<T>::filter(std::function<bool(const T&)> criteria) {
     std::vector<T> result;
-    inOrderTraversal([&](T* data) {
+    forEach([&](T* data) {
         if (criteria(*data)) {
             result.push_back(*data);
         }
@@ -763,4 +848,9 @@ int main() {
 template class RBTree<int>;
 template class RBTree<std::string>;
 template class RBTree<double>;
-template class RBTree<Suspect>;
\ No newline at end of file
+template class RBTree<Suspect>;
+
+// Key lookups on suspects by name
+template Suspect* RBTree<Suspect>::findKey(const std::string_view&);
+template const Suspect* RBTree<Suspect>::findKey(const std::string_view&) const;
+template bool RBTree<Suspect>::removeKey(const std::string_view&);
@@ -1,9 +1,14 @@
 #ifndef RB_TREE_H
 #define RB_TREE_H
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
+#include "visitor.h"
 
 enum Color { RED, BLACK };
 
@@ -14,8 +19,9 @@ struct RBNode {
     RBNode* left;
     RBNode* right;
     Color color;
+    int size;   // nodes in this subtree (0 for TNULL), for select/rank
     
-    RBNode(T value) : data(value), parent(nullptr), left(nullptr), right(nullptr), color(RED) {}
+    RBNode(T value) : data(std::move(value)), parent(nullptr), left(nullptr), right(nullptr), color(RED), size(1) {}
 };
 
 template <typename T>
@@ -31,23 +37,69 @@ private:
     void insertFix(RBNode<T>* k);
     void transplant(RBNode<T>* u, RBNode<T>* v);
     void deleteFix(RBNode<T>* x);
-    void deleteNodeHelper(RBNode<T>* node, T key);
+    void deleteNodeHelper(RBNode<T>* z);
+    template <typename K>
+    RBNode<T>* findNode(const K& key) const;
     RBNode<T>* minimum(RBNode<T>* node);
     RBNode<T>* maximum(RBNode<T>* node);
-    RBNode<T>* searchTreeHelper(RBNode<T>* node, T key);
-    const RBNode<T>* searchTreeHelper(const RBNode<T>* node, T key) const;
+    RBNode<T>* searchTreeHelper(RBNode<T>* node, const T& key);
+    const RBNode<T>* searchTreeHelper(const RBNode<T>* node, const T& key) const;
     void clearTree(RBNode<T>* node);
-    void inOrderHelper(RBNode<T>* node, std::function<void(T*)> fn);
-    void inOrderHelper(const RBNode<T>* node, std::function<void(const T*)> fn) const;
-    void preOrderHelper(RBNode<T>* node, std::function<void(T*)> fn);
-    void postOrderHelper(RBNode<T>* node, std::function<void(T*)> fn);
+    void inOrderHelper(RBNode<T>* node, const std::function<void(T*)>& fn);
+    void inOrderHelper(const RBNode<T>* node, const std::function<void(const T*)>& fn) const;
+    void preOrderHelper(RBNode<T>* node, const std::function<void(T*)>& fn);
+    void postOrderHelper(RBNode<T>* node, const std::function<void(T*)>& fn);
     int getHeight(RBNode<T>* node);
-    int getSize(RBNode<T>* node) const;
     int countBlackNodes(RBNode<T>* node);
     void collectNodes(RBNode<T>* node, std::vector<T>& collection);
     bool isValidRBTreeHelper(RBNode<T>* node, int& blackCount, int currentBlackCount);
     void printTreeHelper(RBNode<T>* node, std::string indent, bool last);
 
+    template <typename Node, typename F>
+    bool forEachNode(Node* node, F& fn) const {
+        if (node == TNULL) return true;
+        return forEachNode<Node>(node->left, fn) && continueVisit(fn, &node->data) &&
+               forEachNode<Node>(node->right, fn);
+    }
+
+    // Iterator steps; nullptr stands for end(), never TNULL
+    RBNode<T>* leftmost(RBNode<T>* node) const {
+        if (node == TNULL) return nullptr;
+        while (node->left != TNULL) node = node->left;
+        return node;
+    }
+    RBNode<T>* rightmost(RBNode<T>* node) const {
+        if (node == TNULL) return nullptr;
+        while (node->right != TNULL) node = node->right;
+        return node;
+    }
+    RBNode<T>* successor(RBNode<T>* node) const {
+        if (node->right != TNULL) return leftmost(node->right);
+        while (node->parent && node == node->parent->right) node = node->parent;
+        return node->parent;
+    }
+    RBNode<T>* predecessor(RBNode<T>* node) const {
+        if (node->left != TNULL) return rightmost(node->left);
+        while (node->parent && node == node->parent->left) node = node->parent;
+        return node->parent;
+    }
+
+    // First node not less than key (upper = false) or greater than key
+    template <typename K>
+    RBNode<T>* boundNode(const K& key, bool upper) const {
+        RBNode<T>* result = nullptr;
+        RBNode<T>* current = root;
+        while (current != TNULL) {
+            if (upper ? key < current->data : !(current->data < key)) {
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return result;
+    }
+
 public:
     // Constructor and Destructor
     RBTree();
@@ -55,12 +107,19 @@ public:
 
     // Basic operations
     void insert(T key);
-    void remove(T key);
-    T* search(T key);
-    const T* search(T key) const;
-    bool contains(T key);
+    void remove(const T& key);
+    T* search(const T& key);
+    const T* search(const T& key) const;
+    bool contains(const T& key);
     void clear();
 
+    // Lookups by key: K only has to be ordered against T the same way T is
+    // ordered (Suspect against a string_view name), so no temporary T is
+    // built. Instantiated for the key types at the end of rb_tree.cpp.
+    template <typename K> T* findKey(const K& key);
+    template <typename K> const T* findKey(const K& key) const;
+    template <typename K> bool removeKey(const K& key);
+
     // Traversals
     void inOrderTraversal(std::function<void(T*)> fn);
     void inOrderTraversal(std::function<void(const T*)> fn) const;
@@ -68,15 +127,27 @@ public:
     void postOrderTraversal(std::function<void(T*)> fn);
     void levelOrderTraversal(std::function<void(T*)> fn);
 
+    // Inlined in-order walk for hot scans: fn(T*) returns void, or bool
+    // where false stops early. Returns false if the walk was stopped.
+    template <typename F>
+    bool forEach(F&& fn) { return forEachNode(root, fn); }
+    template <typename F>
+    bool forEach(F&& fn) const { return forEachNode<const RBNode<T>>(root, fn); }
+
     // Tree properties
     int getHeight();
-    int getSize() const;
+    int getSize() const;    // O(1)
     bool isEmpty();
     T* getMin();
     T* getMax();
     int getBlackHeight();
     bool isValidRBTree();
 
+    // Order statistics, O(log n): the element at a 0-based in-order index
+    // (nullptr if out of range), and how many elements are less than key
+    T* select(int index);
+    int rank(const T& key) const;
+
     // Utility functions
     T* searchByCriteria(std::function<bool(const T&)> criteria);
     std::vector<T> toVector();
@@ -86,6 +157,58 @@ public:
     // Display functions
     void printTree();
     void displayStats();
+
+    // Bidirectional in-order iterators over the parent links. Deletion
+    // relinks the successor node instead of copying its data, so an
+    // iterator stays valid until its own element is removed.
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() : node(nullptr), tree(nullptr) {}
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : node(other.node), tree(other.tree) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        Iterator& operator++() { node = tree->successor(node); return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator& operator--() { node = node ? tree->predecessor(node) : tree->rightmost(tree->root); return *this; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        friend class RBTree;
+        template <bool> friend class Iterator;
+        Iterator(RBNode<T>* node, const RBTree* tree) : node(node), tree(tree) {}
+
+        RBNode<T>* node;    // nullptr at end()
+        const RBTree* tree;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return iterator(leftmost(root), this); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator begin() const { return const_iterator(leftmost(root), this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+
+    // First element not less than key / greater than key; any key type
+    // that findKey accepts works here too
+    template <typename K>
+    iterator lowerBound(const K& key) { return iterator(boundNode(key, false), this); }
+    template <typename K>
+    iterator upperBound(const K& key) { return iterator(boundNode(key, true), this); }
+    template <typename K>
+    const_iterator lowerBound(const K& key) const { return const_iterator(boundNode(key, false), this); }
+    template <typename K>
+    const_iterator upperBound(const K& key) const { return const_iterator(boundNode(key, true), this); }
 };
 
 #endif // RB_TREE_H
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "slot_map.h"
+#include <utility>
+#include "../models/character.h"
+
+template <typename T>
+SlotMap<T>::SlotMap() : freeHead(UINT32_MAX) {}
+
+template <typename T>
+bool SlotMap<T>::live(SlotKey key) const {
+    return key.index < slots.size() && slots[key.index].generation == key.generation &&
+           slots[key.index].position < values.size() && owners[slots[key.index].position] == key.index;
+}
+
+template <typename T>
+SlotKey SlotMap<T>::insert(T value) {
+    uint32_t index;
+    if (freeHead != UINT32_MAX) {
+        index = freeHead;
+        freeHead = slots[index].position;
+    } else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.push_back({0, 0});
+    }
+
+    slots[index].position = static_cast<uint32_t>(values.size());
+    values.push_back(std::move(value));
+    owners.push_back(index);
+    return {index, slots[index].generation};
+}
+
+template <typename T>
+bool SlotMap<T>::erase(SlotKey key) {
+    if (!live(key)) return false;
+
+    uint32_t position = slots[key.index].position;
+    uint32_t last = static_cast<uint32_t>(values.size() - 1);
+    if (position != last) {
+        values[position] = std::move(values[last]);
+        owners[position] = owners[last];
+        slots[owners[position]].position = position;
+    }
+    values.pop_back();
+    owners.pop_back();
+
+    // Retire the key and put the slot on the free list
+    slots[key.index].generation++;
+    slots[key.index].position = freeHead;
+    freeHead = key.index;
+    return true;
+}
+
+template <typename T>
+void SlotMap<T>::clear() {
+    // Bump every live slot so keys handed out before the clear stop resolving
+    for (uint32_t slot : owners) {
+        slots[slot].generation++;
+        slots[slot].position = freeHead;
+        freeHead = slot;
+    }
+    values.clear();
+    owners.clear();
+}
+
+template <typename T>
+void SlotMap<T>::reserve(size_t count) {
+    values.reserve(count);
+    owners.reserve(count);
+    slots.reserve(count);
+}
+
+template <typename T>
+T* SlotMap<T>::get(SlotKey key) {
+    return live(key) ? &values[slots[key.index].position] : nullptr;
+}
+
+template <typename T>
+const T* SlotMap<T>::get(SlotKey key) const {
+    return live(key) ? &values[slots[key.index].position] : nullptr;
+}
+
+template <typename T>
+bool SlotMap<T>::contains(SlotKey key) const {
+    return live(key);
+}
+
+template <typename T>
+SlotKey SlotMap<T>::keyAt(size_t position) const {
+    uint32_t slot = owners[position];
+    return {slot, slots[slot].generation};
+}
+
+template <typename T>
+size_t SlotMap<T>::size() const {
+    return values.size();
+}
+
+template <typename T>
+bool SlotMap<T>::empty() const {
+    return values.empty();
+}
+
+// Explicit template instantiation
+template class SlotMap<int>;
+template class SlotMap<Character>;
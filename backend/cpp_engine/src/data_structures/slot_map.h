@@ -0,0 +1,65 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Generational slot map: values live contiguously, keys go through an
+// indirection table.
+//
+// Erase moves the last value into the hole (swap-remove), so scans always
+// walk a packed array. Keys stay valid across other inserts and erases;
+// once their own value is erased the slot's generation moves on and the
+// old key simply stops resolving. Raw pointers into the map are only good
+// until the next insert or erase.
+
+struct SlotKey {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const SlotKey& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotKey& other) const { return !(*this == other); }
+};
+
+template <typename T>
+class SlotMap {
+private:
+    struct Slot {
+        uint32_t position;      // index into values, or the next free slot
+        uint32_t generation;
+    };
+
+    std::vector<T> values;
+    std::vector<uint32_t> owners;   // slot of each value, parallel to values
+    std::vector<Slot> slots;
+    uint32_t freeHead;              // UINT32_MAX when no slot is free
+
+    bool live(SlotKey key) const;
+
+public:
+    SlotMap();
+
+    SlotKey insert(T value);
+    bool erase(SlotKey key);
+    void clear();
+    void reserve(size_t count);
+
+    T* get(SlotKey key);
+    const T* get(SlotKey key) const;
+    bool contains(SlotKey key) const;
+    SlotKey keyAt(size_t position) const;   // key of values[position]
+
+    size_t size() const;
+    bool empty() const;
+
+    // Dense iteration, in no particular order
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+};
+
+#endif // SLOT_MAP_H
@@ -0,0 +1,201 @@
+#include "string_pool.h"
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+// The chunk each thread is appending to. Only the global pool exists, so
+// one cursor per thread is enough.
+struct ChunkCursor {
+    StringPool::Chunk* chunk = nullptr;
+    uint32_t used = 0;
+
+    ~ChunkCursor() {
+        if (chunk) StringPool::releaseChunk(chunk);
+    }
+};
+
+namespace {
+    thread_local ChunkCursor cursor;
+
+    constexpr uint32_t sliceBytes(size_t length) {
+        return static_cast<uint32_t>((sizeof(StringPool::Slice) + length + 3) & ~size_t(3));
+    }
+}
+
+StringPool::StringPool()
+    : deduplicate(false), liveStrings(0), bytesStored(0), bytesExternal(0), chunks(0), chunkBytes(0),
+      internCalls(0), sharedHits(0) {}
+
+StringPool& StringPool::global() {
+    // Leaked on purpose: entities in static storage may release text after
+    // the pool would have been destroyed. Only the empty table leaks.
+    static StringPool* pool = new StringPool();
+    return *pool;
+}
+
+void StringPool::setDeduplication(bool enabled) {
+    deduplicate.store(enabled, std::memory_order_relaxed);
+}
+
+bool StringPool::isDeduplicating() const {
+    return deduplicate.load(std::memory_order_relaxed);
+}
+
+StringPool::Chunk* StringPool::newChunk(uint32_t size) {
+    Chunk* chunk = new (::operator new(size)) Chunk();
+    chunk->handles.store(1, std::memory_order_relaxed);
+    chunk->size = size;
+    chunks.fetch_add(1, std::memory_order_relaxed);
+    chunkBytes.fetch_add(size, std::memory_order_relaxed);
+    return chunk;
+}
+
+void StringPool::releaseChunk(Chunk* chunk) {
+    if (chunk->handles.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    StringPool& pool = global();
+    pool.chunks.fetch_sub(1, std::memory_order_relaxed);
+    pool.chunkBytes.fetch_sub(chunk->size, std::memory_order_relaxed);
+    chunk->~Chunk();
+    ::operator delete(chunk);
+}
+
+StringPool::Slice* StringPool::append(std::string_view value) {
+    if (value.size() > std::numeric_limits<uint32_t>::max() - sizeof(Chunk) - sizeof(Slice) - 3) {
+        throw std::length_error("String too large for pool");
+    }
+    uint32_t bytes = sliceBytes(value.size());
+
+    Chunk* chunk;
+    uint32_t offset;
+    if (bytes > MAX_SHARED_SLICE) {
+        // The new chunk's own count stands for the returned handle
+        chunk = newChunk(sizeof(Chunk) + bytes);
+        offset = sizeof(Chunk);
+    } else {
+        if (!cursor.chunk || cursor.used + bytes > CHUNK_SIZE) {
+            if (cursor.chunk) releaseChunk(cursor.chunk);
+            cursor.chunk = newChunk(CHUNK_SIZE);
+            cursor.used = sizeof(Chunk);
+        }
+        chunk = cursor.chunk;
+        offset = cursor.used;
+        cursor.used += bytes;
+        chunk->handles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Slice* slice = reinterpret_cast<Slice*>(reinterpret_cast<char*>(chunk) + offset);
+    slice->length = static_cast<uint32_t>(value.size());
+    slice->offset = offset;
+    std::memcpy(slice + 1, value.data(), value.size());
+    return slice;
+}
+
+StringPool::Entry* StringPool::create(std::string_view value, std::shared_ptr<const void> owner) {
+    if (value.size() > std::numeric_limits<uint32_t>::max()) throw std::length_error("String too large for pool");
+
+    // Copied text is stored right behind its entry: one allocation per value
+    size_t inlineBytes = owner ? 0 : value.size();
+    void* memory = ::operator new(sizeof(Entry) + inlineBytes);
+    Entry* entry = new (memory) Entry();
+    entry->refs.store(1, std::memory_order_relaxed);
+    entry->length = static_cast<uint32_t>(value.size());
+    entry->shard = -1;
+    entry->listed = false;
+    if (owner) {
+        entry->text = value.data();
+        entry->owner = std::move(owner);
+        bytesExternal.fetch_add(value.size(), std::memory_order_relaxed);
+    } else {
+        char* text = reinterpret_cast<char*>(entry + 1);
+        std::memcpy(text, value.data(), value.size());
+        entry->text = text;
+        bytesStored.fetch_add(value.size(), std::memory_order_relaxed);
+    }
+    liveStrings.fetch_add(1, std::memory_order_relaxed);
+    return entry;
+}
+
+PooledString StringPool::share(std::string_view value, std::shared_ptr<const void> owner) {
+    int index = static_cast<int>(std::hash<std::string_view>()(value) % SHARD_COUNT);
+    Shard& shard = shards[index];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(value);
+    if (it != shard.entries.end()) {
+        Entry* existing = it->second;
+        uint32_t refs = existing->refs.load(std::memory_order_relaxed);
+        while (refs != 0) {
+            if (existing->refs.compare_exchange_weak(refs, refs + 1, std::memory_order_relaxed)) {
+                sharedHits.fetch_add(1, std::memory_order_relaxed);
+                return PooledString(existing);
+            }
+        }
+        // Its last handle is being dropped right now; the releaser frees it
+        existing->listed = false;
+        shard.entries.erase(it);
+    }
+
+    Entry* entry = create(value, std::move(owner));
+    entry->shard = index;
+    entry->listed = true;
+    shard.entries.emplace(std::string_view(entry->text, entry->length), entry);
+    return PooledString(entry);
+}
+
+void StringPool::release(Entry* entry) {
+    if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    if (entry->shard >= 0) {
+        Shard& shard = shards[entry->shard];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (entry->listed) shard.entries.erase(std::string_view(entry->text, entry->length));
+    }
+
+    liveStrings.fetch_sub(1, std::memory_order_relaxed);
+    (entry->owner ? bytesExternal : bytesStored).fetch_sub(entry->length, std::memory_order_relaxed);
+    entry->~Entry();
+    ::operator delete(entry);
+}
+
+PooledString StringPool::intern(std::string_view value) {
+    if (value.empty()) return PooledString();
+    internCalls.fetch_add(1, std::memory_order_relaxed);
+    if (!isDeduplicating()) return PooledString(append(value));
+    return share(value, nullptr);
+}
+
+PooledString StringPool::internExternal(std::string_view value, std::shared_ptr<const void> owner) {
+    if (value.empty()) return PooledString();
+    if (!owner) return intern(value);
+    internCalls.fetch_add(1, std::memory_order_relaxed);
+    if (!isDeduplicating()) return PooledString(create(value, std::move(owner)));
+    return share(value, std::move(owner));
+}
+
+StringPool::Stats StringPool::getStats() const {
+    return {liveStrings.load(std::memory_order_relaxed), bytesStored.load(std::memory_order_relaxed),
+            bytesExternal.load(std::memory_order_relaxed), chunks.load(std::memory_order_relaxed),
+            chunkBytes.load(std::memory_order_relaxed), internCalls.load(std::memory_order_relaxed),
+            sharedHits.load(std::memory_order_relaxed), isDeduplicating()};
+}
+
+PooledString::PooledString(std::string_view value) : PooledString(StringPool::global().intern(value)) {}
+
+namespace StringPoolUtils {
+
+std::vector<std::string> toStrings(const std::vector<PooledString>& values) {
+    std::vector<std::string> result;
+    result.reserve(values.size());
+    for (const auto& value : values) result.emplace_back(value.view());
+    return result;
+}
+
+void assign(std::vector<PooledString>& out, const std::vector<std::string>& values) {
+    out.clear();
+    out.reserve(values.size());
+    for (const auto& value : values) out.emplace_back(value);
+}
+
+}
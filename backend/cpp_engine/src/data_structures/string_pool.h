@@ -0,0 +1,190 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class PooledString;
+
+// Storage for entity text.
+//
+// By default values are appended to shared chunks: each value costs an
+// 8-byte header plus its bytes, with no allocation of its own, and every
+// thread appends to its own chunk without taking a lock. A chunk counts the
+// handles pointing into it and is freed with the last one, so a long-lived
+// value keeps the rest of its chunk allocated.
+//
+// Two opt-in modes use individually counted entries instead. Sharing equal
+// values through the intern table (setDeduplication) splits the table into
+// shards that each have their own lock. internExternal() points at text owned
+// by someone else (e.g. a mapped snapshot) and keeps that owner alive only for
+// as long as the entry itself lives.
+class StringPool {
+public:
+    struct Chunk {
+        std::atomic<uint32_t> handles;  // plus one while a thread appends to it
+        uint32_t size;
+    };
+
+    // A value inside a chunk; its bytes follow
+    struct Slice {
+        uint32_t length;
+        uint32_t offset;    // from the start of its chunk
+    };
+
+    struct Entry {
+        std::atomic<uint32_t> refs;
+        uint32_t length;
+        const char* text;                    // follows the entry unless external
+        std::shared_ptr<const void> owner;   // holds external text
+        int shard;                           // -1 when never interned
+        bool listed;                         // still in its shard; guarded by the shard lock
+    };
+
+    struct Stats {
+        size_t liveStrings;      // counted entries
+        size_t bytesStored;      // copied into live entries
+        size_t bytesExternal;    // referenced in owners' memory
+        size_t chunks;
+        size_t chunkBytes;       // held by chunks, including dead values
+        size_t internCalls;
+        size_t sharedHits;       // calls answered by an existing entry
+        bool deduplication;
+    };
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    static StringPool& global();
+
+    // Off by default. Switching it affects values interned afterwards.
+    void setDeduplication(bool enabled);
+    bool isDeduplicating() const;
+
+    PooledString intern(std::string_view value);
+    // Like intern(), but a new value is referenced in place instead of copied;
+    // the entry holds on to owner until it is freed.
+    PooledString internExternal(std::string_view value, std::shared_ptr<const void> owner);
+
+    Stats getStats() const;
+
+private:
+    static constexpr int SHARD_COUNT = 16;
+    static constexpr uint32_t CHUNK_SIZE = 8192;
+    // Larger values get a chunk to themselves
+    static constexpr uint32_t MAX_SHARED_SLICE = CHUNK_SIZE / 4;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string_view, Entry*> entries;
+    };
+
+    Shard shards[SHARD_COUNT];
+    std::atomic<bool> deduplicate;
+    std::atomic<size_t> liveStrings;
+    std::atomic<size_t> bytesStored;
+    std::atomic<size_t> bytesExternal;
+    std::atomic<size_t> chunks;
+    std::atomic<size_t> chunkBytes;
+    std::atomic<size_t> internCalls;
+    std::atomic<size_t> sharedHits;
+
+    StringPool();
+
+    Chunk* newChunk(uint32_t size);
+    Slice* append(std::string_view value);
+    Entry* create(std::string_view value, std::shared_ptr<const void> owner);
+    PooledString share(std::string_view value, std::shared_ptr<const void> owner);
+    void release(Entry* entry);
+
+    static Chunk* chunkOf(const Slice* slice) {
+        return reinterpret_cast<Chunk*>(reinterpret_cast<char*>(const_cast<Slice*>(slice)) - slice->offset);
+    }
+    static void releaseChunk(Chunk* chunk);
+
+    friend class PooledString;
+    friend struct ChunkCursor;
+};
+
+// Handle to pooled text; converts to std::string_view. Holds either a Slice
+// or, tagged in the low bit, a counted Entry.
+class PooledString {
+private:
+    uintptr_t bits;
+
+    static constexpr uintptr_t ENTRY_TAG = 1;
+
+    explicit PooledString(StringPool::Slice* slice) : bits(reinterpret_cast<uintptr_t>(slice)) {}
+    explicit PooledString(StringPool::Entry* entry) : bits(reinterpret_cast<uintptr_t>(entry) | ENTRY_TAG) {}
+    friend class StringPool;
+
+    bool isEntry() const { return bits & ENTRY_TAG; }
+    StringPool::Entry* entry() const { return reinterpret_cast<StringPool::Entry*>(bits & ~ENTRY_TAG); }
+    StringPool::Slice* slice() const { return reinterpret_cast<StringPool::Slice*>(bits); }
+
+public:
+    PooledString() : bits(0) {}
+    explicit PooledString(std::string_view value);
+    explicit PooledString(const std::string& value) : PooledString(std::string_view(value)) {}
+    explicit PooledString(const char* value) : PooledString(std::string_view(value)) {}
+
+    PooledString(const PooledString& other) : bits(other.bits) {
+        if (!bits) return;
+        if (isEntry()) entry()->refs.fetch_add(1, std::memory_order_relaxed);
+        else StringPool::chunkOf(slice())->handles.fetch_add(1, std::memory_order_relaxed);
+    }
+    PooledString(PooledString&& other) noexcept : bits(other.bits) { other.bits = 0; }
+    ~PooledString() {
+        if (!bits) return;
+        if (isEntry()) StringPool::global().release(entry());
+        else StringPool::releaseChunk(StringPool::chunkOf(slice()));
+    }
+
+    PooledString& operator=(PooledString other) noexcept {
+        std::swap(bits, other.bits);
+        return *this;
+    }
+    PooledString& operator=(std::string_view value) { return *this = PooledString(value); }
+    PooledString& operator=(const std::string& value) { return *this = PooledString(value); }
+    PooledString& operator=(const char* value) { return *this = PooledString(value); }
+
+    const char* data() const {
+        if (!bits) return "";
+        return isEntry() ? entry()->text : reinterpret_cast<const char*>(slice() + 1);
+    }
+    size_t size() const {
+        if (!bits) return 0;
+        return isEntry() ? entry()->length : slice()->length;
+    }
+    bool empty() const { return !bits; }
+
+    std::string_view view() const { return std::string_view(data(), size()); }
+    std::string str() const { return std::string(data(), size()); }
+    operator std::string_view() const { return view(); }
+
+    friend bool operator==(const PooledString& a, const PooledString& b) {
+        return a.bits == b.bits || a.view() == b.view();
+    }
+    friend bool operator==(const PooledString& a, std::string_view b) { return a.view() == b; }
+    friend bool operator==(std::string_view a, const PooledString& b) { return a == b.view(); }
+    friend bool operator!=(const PooledString& a, const PooledString& b) { return !(a == b); }
+    friend bool operator!=(const PooledString& a, std::string_view b) { return !(a == b); }
+    friend bool operator!=(std::string_view a, const PooledString& b) { return !(a == b); }
+
+    friend std::ostream& operator<<(std::ostream& os, const PooledString& s) { return os << s.view(); }
+};
+
+namespace StringPoolUtils {
+    std::vector<std::string> toStrings(const std::vector<PooledString>& values);
+    void assign(std::vector<PooledString>& out, const std::vector<std::string>& values);
+}
+
+#endif // STRING_POOL_H
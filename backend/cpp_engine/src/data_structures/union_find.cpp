@@ -0,0 +1,56 @@
+#include "union_find.h"
+#include <utility>
+
+UnionFind::UnionFind(int count) : components(0) {
+    reset(count);
+}
+
+void UnionFind::reset(int count) {
+    parent.resize(count);
+    sizes.assign(count, 1);
+    for (int i = 0; i < count; i++) parent[i] = i;
+    components = count;
+}
+
+int UnionFind::add() {
+    int index = static_cast<int>(parent.size());
+    parent.push_back(index);
+    sizes.push_back(1);
+    components++;
+    return index;
+}
+
+int UnionFind::find(int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+bool UnionFind::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (sizes[a] < sizes[b]) std::swap(a, b);
+    parent[b] = a;
+    sizes[a] += sizes[b];
+    components--;
+    return true;
+}
+
+bool UnionFind::connected(int a, int b) {
+    return find(a) == find(b);
+}
+
+int UnionFind::componentSize(int x) {
+    return sizes[find(x)];
+}
+
+int UnionFind::getComponentCount() const {
+    return components;
+}
+
+int UnionFind::getSize() const {
+    return static_cast<int>(parent.size());
+}
@@ -0,0 +1,27 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <vector>
+
+// Disjoint sets over 0..n-1 with union by size and path halving
+class UnionFind {
+private:
+    std::vector<int> parent;
+    std::vector<int> sizes;
+    int components;
+
+public:
+    explicit UnionFind(int count = 0);
+
+    void reset(int count);
+    int add();                      // new singleton set; returns its index
+
+    int find(int x);
+    bool unite(int a, int b);       // false if already in the same set
+    bool connected(int a, int b);
+    int componentSize(int x);
+    int getComponentCount() const;
+    int getSize() const;
+};
+
+#endif // UNION_FIND_H
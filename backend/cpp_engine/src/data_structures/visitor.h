@@ -0,0 +1,19 @@
+#ifndef VISITOR_H
+#define VISITOR_H
+
+#include <type_traits>
+#include <utility>
+
+// Calls a container visitor and says whether the walk should go on.
+// Visitors return void to see every element, or bool where false stops.
+template <typename F, typename... Args>
+inline bool continueVisit(F& fn, Args&&... args) {
+    if constexpr (std::is_void_v<std::invoke_result_t<F&, Args...>>) {
+        fn(std::forward<Args>(args)...);
+        return true;
+    } else {
+        return static_cast<bool>(fn(std::forward<Args>(args)...));
+    }
+}
+
+#endif // VISITOR_H
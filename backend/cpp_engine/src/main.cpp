@@ -2,8 +2,12 @@
 #include "core/engine.h"
 #include "core/story_manager.h"
 #include "core/utils.h"
+#include "core/logger.h"
 
 int main() {
+    // The demo prints between engine calls, so keep log lines in step
+    Logger::instance().setSynchronous(true);
+
     std::cout << "=== WhoDunnitBro C++ Engine Test ===\n\n";
 
     Engine engine;                     // Core engine
@@ -1,4 +1,5 @@
 #include "case.h"
+#include "serialization.h"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -35,9 +36,9 @@ int Case::getId() const { return id; }
 
 std::string Case::getTitle() const { return title; }
 
-std::string Case::getDescription() const { return description; }
+std::string Case::getDescription() const { return description.str(); }
 
-std::string Case::getLocation() const { return location; }
+std::string Case::getLocation() const { return location.str(); }
 
 std::string Case::getStatusString() const {
     return CaseUtils::statusToString(status);
@@ -51,17 +52,17 @@ CaseStatus Case::getStatus() const { return status; }
 
 CasePriority Case::getPriority() const { return priority; }
 
-std::string Case::getSolution() const { return solution; }
+std::string Case::getSolution() const { return solution.str(); }
 
-std::string Case::getNotes() const { return notes; }
+std::string Case::getNotes() const { return notes.str(); }
 
 std::vector<int> Case::getSuspects() const { return suspectIds; }
 
 std::vector<int> Case::getCharacters() const { return characterIds; }
 
-std::vector<std::string> Case::getEvidence() const { return evidence; }
+std::vector<std::string> Case::getEvidence() const { return StringPoolUtils::toStrings(evidence); }
 
-std::vector<std::string> Case::getTags() const { return tags; }
+std::vector<std::string> Case::getTags() const { return StringPoolUtils::toStrings(tags); }
 
 std::string Case::getCreationDate() const {
     auto time = std::chrono::system_clock::to_time_t(dateCreated);
@@ -158,7 +159,7 @@ void Case::removeCharacter(int characterId) {
 
 void Case::addEvidence(const std::string& evidenceItem) {
     if (std::find(evidence.begin(), evidence.end(), evidenceItem) == evidence.end()) {
-        evidence.push_back(evidenceItem);
+        evidence.emplace_back(evidenceItem);
         updateModificationDate();
     }
 }
@@ -173,7 +174,7 @@ void Case::removeEvidence(const std::string& evidenceItem) {
 
 void Case::addTag(const std::string& tag) {
     if (std::find(tags.begin(), tags.end(), tag) == tags.end()) {
-        tags.push_back(tag);
+        tags.emplace_back(tag);
         updateModificationDate();
     }
 }
@@ -305,109 +306,100 @@ std::string Case::to_string() const {
 
 // Serialization
 std::string Case::serialize() const {
-    std::stringstream ss;
-    ss << id << "|" << title << "|" << description << "|" << location << "|"
-       << static_cast<int>(status) << "|" << static_cast<int>(priority) << "|"
-       << solution << "|" << notes;
-    
-    // Serialize suspect IDs
-    ss << "|";
-    for (size_t i = 0; i < suspectIds.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << suspectIds[i];
-    }
-    
-    // Serialize character IDs
-    ss << "|";
-    for (size_t i = 0; i < characterIds.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << characterIds[i];
+    using namespace Serialization;
+    std::string out;
+    out.reserve(64 + title.size() + description.size() + location.size() + solution.size() + notes.size());
+
+    appendInt(out, id);
+    out += '|';
+    appendEscaped(out, title);
+    out += '|';
+    appendEscaped(out, description);
+    out += '|';
+    appendEscaped(out, location);
+    out += '|';
+    appendInt(out, static_cast<int>(status));
+    out += '|';
+    appendInt(out, static_cast<int>(priority));
+    out += '|';
+    appendEscaped(out, solution);
+    out += '|';
+    appendEscaped(out, notes);
+
+    // Serialize suspect and character IDs
+    out += '|';
+    appendIntList(out, suspectIds);
+    out += '|';
+    appendIntList(out, characterIds);
+
+    // Serialize evidence and tags
+    out += '|';
+    appendStringList(out, evidence);
+    out += '|';
+    appendStringList(out, tags);
+
+    // Serialize dates
+    out += '|';
+    appendInt(out, static_cast<long long>(std::chrono::system_clock::to_time_t(dateCreated)));
+    out += '|';
+    appendInt(out, static_cast<long long>(std::chrono::system_clock::to_time_t(dateModified)));
+    out += '|';
+    appendInt(out, static_cast<long long>(std::chrono::system_clock::to_time_t(incidentDate)));
+
+    return out;
+}
+
+bool Case::parse(std::string_view data, Case& out) {
+    using namespace Serialization;
+    std::string_view fields[15];
+    size_t count = FieldTokenizer(data).split(fields, 15);
+    if (count < 8) return false;
+
+    int parsedId, statusValue, priorityValue;
+    if (!parseInt(fields[0], parsedId) || !parseInt(fields[4], statusValue) || !parseInt(fields[5], priorityValue)) {
+        return false;
     }
-    
-    // Serialize evidence
-    ss << "|";
-    for (size_t i = 0; i < evidence.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << evidence[i];
+    if (statusValue < 0 || statusValue > static_cast<int>(CaseStatus::UNSOLVED) ||
+        priorityValue < 0 || priorityValue > static_cast<int>(CasePriority::URGENT)) {
+        return false;
     }
-    
-    // Serialize tags
-    ss << "|";
-    for (size_t i = 0; i < tags.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << tags[i];
+
+    out.id = parsedId;
+    unescapeInto(fields[1], out.title);
+    unescapeInto(fields[2], out.description);
+    unescapeInto(fields[3], out.location);
+    out.status = static_cast<CaseStatus>(statusValue);
+    out.priority = static_cast<CasePriority>(priorityValue);
+    unescapeInto(fields[6], out.solution);
+    unescapeInto(fields[7], out.notes);
+
+    // Missing trailing fields are empty views, which parse as empty lists
+    if (!parseIntList(fields[8], out.suspectIds) || !parseIntList(fields[9], out.characterIds)) {
+        return false;
     }
-    
-    // Serialize dates
-    ss << "|" << std::chrono::system_clock::to_time_t(dateCreated);
-    ss << "|" << std::chrono::system_clock::to_time_t(dateModified);
-    ss << "|" << std::chrono::system_clock::to_time_t(incidentDate);
-    
-    return ss.str();
+    parseStringList(fields[10], out.evidence);
+    parseStringList(fields[11], out.tags);
+
+    // Dates are optional; records without them are stamped now
+    auto now = std::chrono::system_clock::now();
+    long long seconds;
+    out.dateCreated = count > 12 && parseInt(fields[12], seconds) ? std::chrono::system_clock::from_time_t(seconds) : now;
+    out.dateModified = count > 13 && parseInt(fields[13], seconds) ? std::chrono::system_clock::from_time_t(seconds) : now;
+    out.incidentDate = count > 14 && parseInt(fields[14], seconds) ? std::chrono::system_clock::from_time_t(seconds) : now;
+    return true;
 }
 
 Case Case::deserialize(const std::string& data) {
-    std::stringstream ss(data);
-    std::string token;
-    std::vector<std::string> tokens;
-    
-    while (std::getline(ss, token, '|')) {
-        tokens.push_back(token);
-    }
-    
-    if (tokens.size() < 8) {
+    Case c;
+    if (!parse(data, c)) {
         throw std::invalid_argument("Invalid case data format");
     }
-    
-    Case c(std::stoi(tokens[0]), tokens[1], tokens[2]);
-    c.setLocation(tokens[3]);
-    c.setStatus(static_cast<CaseStatus>(std::stoi(tokens[4])));
-    c.setPriority(static_cast<CasePriority>(std::stoi(tokens[5])));
-    c.setSolution(tokens[6]);
-    c.setNotes(tokens[7]);
-    
-    // Deserialize suspect IDs
-    if (tokens.size() > 8 && !tokens[8].empty()) {
-        std::stringstream suspectStream(tokens[8]);
-        std::string suspectToken;
-        while (std::getline(suspectStream, suspectToken, ',')) {
-            c.addSuspect(std::stoi(suspectToken));
-        }
-    }
-    
-    // Deserialize character IDs
-    if (tokens.size() > 9 && !tokens[9].empty()) {
-        std::stringstream charStream(tokens[9]);
-        std::string charToken;
-        while (std::getline(charStream, charToken, ',')) {
-            c.addCharacter(std::stoi(charToken));
-        }
-    }
-    
-    // Deserialize evidence
-    if (tokens.size() > 10 && !tokens[10].empty()) {
-        std::stringstream evidenceStream(tokens[10]);
-        std::string evidenceToken;
-        while (std::getline(evidenceStream, evidenceToken, ',')) {
-            c.addEvidence(evidenceToken);
-        }
-    }
-    
-    // Deserialize tags
-    if (tokens.size() > 11 && !tokens[11].empty()) {
-        std::stringstream tagStream(tokens[11]);
-        std::string tagToken;
-        while (std::getline(tagStream, tagToken, ',')) {
-            c.addTag(tagToken);
-        }
-    }
-    
     return c;
 }
 
 // Validation
 bool Case::isValid() const {
-    return validateTitle(title) && validateDescription(description) && id >= 0;
+    return validateTitle(title) && validateDescription(description.str()) && id >= 0;
 }
 
 bool Case::validateTitle(const std::string& title) {
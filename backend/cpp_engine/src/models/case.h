@@ -5,6 +5,8 @@
 #include <vector>
 #include <chrono>
 #include <functional>
+#include <string_view>
+#include "../data_structures/string_pool.h"
 
 enum class CaseStatus {
     OPEN,
@@ -38,16 +40,17 @@ class Case {
 private:
     int id;
     std::string title;
-    std::string description;
-    std::string location;
+    // Text fields live in the global StringPool; title stays a std::string key
+    PooledString description;
+    PooledString location;
     CaseStatus status;
     CasePriority priority;
-    std::string solution;
-    std::string notes;
+    PooledString solution;
+    PooledString notes;
     std::vector<int> suspectIds;
     std::vector<int> characterIds;
-    std::vector<std::string> evidence;
-    std::vector<std::string> tags;
+    std::vector<PooledString> evidence;
+    std::vector<PooledString> tags;
     std::chrono::system_clock::time_point dateCreated;
     std::chrono::system_clock::time_point dateModified;
     std::chrono::system_clock::time_point incidentDate;
@@ -72,8 +75,14 @@ public:
     bool operator>(const Case& other) const {
         return title > other.title; // Or use id for comparison
     }
+
+    // Same order against a bare title, for tree lookups by key
+    friend bool operator<(const Case& c, std::string_view title) { return c.title < title; }
+    friend bool operator<(std::string_view title, const Case& c) { return title < c.title; }
     
     friend std::ostream& operator<<(std::ostream& os, const Case& c);
+    friend class SnapshotWriter;
+    friend class SnapshotReader;
     // Getters
     int getId() const;
     std::string getTitle() const;
@@ -137,6 +146,8 @@ public:
     // Serialization
     std::string serialize() const;
     static Case deserialize(const std::string& data);
+    // Non-throwing parse into an existing object; reuses its buffers
+    static bool parse(std::string_view data, Case& out);
 };
 
 #endif // CASE_H
\ No newline at end of file
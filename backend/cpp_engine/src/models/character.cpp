@@ -1,5 +1,6 @@
 // character.cpp
 #include "character.h"
+#include "serialization.h"
 #include <sstream>
 #include <algorithm>
 #include <iostream>
@@ -18,9 +19,9 @@ int Character::getId() const { return id; }
 std::string Character::getName() const { return name; }
 CharacterRole Character::getRole() const { return role; }
 std::string Character::getRoleString() const { return CharacterUtils::roleToString(role); }
-std::string Character::getStory() const { return story; }
+std::string Character::getStory() const { return story.str(); }
 std::vector<int> Character::getRelatedCases() const { return relatedCases; }
-std::vector<std::string> Character::getKnownSuspects() const { return knownSuspects; }
+std::vector<std::string> Character::getKnownSuspects() const { return StringPoolUtils::toStrings(knownSuspects); }
 
 // Setters
 void Character::setName(const std::string& newName) { name = newName; }
@@ -39,7 +40,7 @@ void Character::removeCase(int caseId) {
 }
 void Character::addKnownSuspect(const std::string& suspectName) {
     if (std::find(knownSuspects.begin(), knownSuspects.end(), suspectName) == knownSuspects.end()) {
-        knownSuspects.push_back(suspectName);
+        knownSuspects.emplace_back(suspectName);
     }
 }
 void Character::removeKnownSuspect(const std::string& suspectName) {
@@ -105,38 +106,45 @@ std::string Character::to_string() const {
 
 // Serialization
 std::string Character::serialize() const {
-    std::stringstream ss;
-    ss << id << "|" << name << "|" << static_cast<int>(role) << "|" << story;
-    ss << "|";
-    for (size_t i = 0; i < relatedCases.size(); ++i) {
-        if (i) ss << ",";
-        ss << relatedCases[i];
-    }
-    ss << "|";
-    for (size_t i = 0; i < knownSuspects.size(); ++i) {
-        if (i) ss << ",";
-        ss << knownSuspects[i];
-    }
-    return ss.str();
+    using namespace Serialization;
+    std::string out;
+    out.reserve(32 + name.size() + story.size());
+    appendInt(out, id);
+    out += '|';
+    appendEscaped(out, name);
+    out += '|';
+    appendInt(out, static_cast<int>(role));
+    out += '|';
+    appendEscaped(out, story);
+    out += '|';
+    appendIntList(out, relatedCases);
+    out += '|';
+    appendStringList(out, knownSuspects);
+    return out;
+}
+
+bool Character::parse(std::string_view data, Character& out) {
+    using namespace Serialization;
+    std::string_view fields[6];
+    size_t count = FieldTokenizer(data).split(fields, 6);
+    if (count < 4) return false;
+
+    int parsedId, roleValue;
+    if (!parseInt(fields[0], parsedId) || !parseInt(fields[2], roleValue)) return false;
+    if (roleValue < 0 || roleValue > static_cast<int>(CharacterRole::OTHER)) return false;
+
+    out.id = parsedId;
+    unescapeInto(fields[1], out.name);
+    out.role = static_cast<CharacterRole>(roleValue);
+    unescapeInto(fields[3], out.story);
+    if (!parseIntList(fields[4], out.relatedCases)) return false;
+    parseStringList(fields[5], out.knownSuspects);
+    return true;
 }
 
 Character Character::deserialize(const std::string& data) {
-    std::stringstream ss(data);
-    std::string token;
-    std::vector<std::string> tokens;
-    while (std::getline(ss, token, '|')) tokens.push_back(token);
-    if (tokens.size() < 4) throw std::invalid_argument("Invalid character data format");
-    Character ch(std::stoi(tokens[0]), tokens[1], static_cast<CharacterRole>(std::stoi(tokens[2])), tokens[3]);
-    if (tokens.size() > 4 && !tokens[4].empty()) {
-        std::stringstream caseStream(tokens[4]);
-        std::string caseToken;
-        while (std::getline(caseStream, caseToken, ',')) ch.addCase(std::stoi(caseToken));
-    }
-    if (tokens.size() > 5 && !tokens[5].empty()) {
-        std::stringstream suspectStream(tokens[5]);
-        std::string suspectToken;
-        while (std::getline(suspectStream, suspectToken, ',')) ch.addKnownSuspect(suspectToken);
-    }
+    Character ch;
+    if (!parse(data, ch)) throw std::invalid_argument("Invalid character data format");
     return ch;
 }
 
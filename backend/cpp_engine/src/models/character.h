@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include <string_view>
+#include "../data_structures/string_pool.h"
 
 enum class CharacterRole {
     WITNESS,
@@ -26,9 +28,9 @@ private:
     int id;
     std::string name;
     CharacterRole role;
-    std::string story;
+    PooledString story;
     std::vector<int> relatedCases;
-    std::vector<std::string> knownSuspects;
+    std::vector<PooledString> knownSuspects;
 
 public:
     // Constructors
@@ -72,6 +74,8 @@ public:
     // Serialization
     std::string serialize() const;
     static Character deserialize(const std::string& data);
+    // Non-throwing parse into an existing object; reuses its buffers
+    static bool parse(std::string_view data, Character& out);
     
     // Validation
     bool isValid() const;
@@ -90,6 +94,8 @@ public:
     }
         
     friend std::ostream& operator<<(std::ostream& os, const Character& ch);
+    friend class SnapshotWriter;
+    friend class SnapshotReader;
 };
 
 class CharacterUtils {
@@ -0,0 +1,168 @@
+#include "serialization.h"
+#include <algorithm>
+
+namespace Serialization {
+
+namespace {
+    // Finds the next unescaped delimiter at or after pos
+    size_t findDelimiter(std::string_view data, size_t pos, char delimiter) {
+        while (pos < data.size()) {
+            char c = data[pos];
+            if (c == '\\') {
+                pos += 2;
+                continue;
+            }
+            if (c == delimiter) return pos;
+            pos++;
+        }
+        return std::string_view::npos;
+    }
+}
+
+void appendEscaped(std::string& out, std::string_view value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '|': out += "\\|"; break;
+            case ',': out += "\\,"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+void appendStringList(std::string& out, const std::vector<std::string>& values) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) out += ',';
+        appendEscaped(out, values[i]);
+    }
+}
+
+void appendStringList(std::string& out, const std::vector<PooledString>& values) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) out += ',';
+        appendEscaped(out, values[i]);
+    }
+}
+
+void appendIntList(std::string& out, const std::vector<int>& values) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) out += ',';
+        appendInt(out, values[i]);
+    }
+}
+
+void appendDouble(std::string& out, double value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void unescapeInto(std::string_view raw, std::string& out) {
+    out.clear();
+    size_t start = 0;
+    size_t slash;
+    while ((slash = raw.find('\\', start)) != std::string_view::npos) {
+        out.append(raw.data() + start, slash - start);
+        if (slash + 1 >= raw.size()) {
+            // A trailing lone backslash is kept literally
+            out += '\\';
+            return;
+        }
+        char c = raw[slash + 1];
+        out += c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+        start = slash + 2;
+    }
+    out.append(raw.data() + start, raw.size() - start);
+}
+
+void unescapeInto(std::string_view raw, PooledString& out) {
+    // Unescaped text is the common case and can be interned straight from the record
+    if (raw.find('\\') == std::string_view::npos) {
+        if (out != raw) out = raw;
+        return;
+    }
+    thread_local std::string scratch;
+    unescapeInto(raw, scratch);
+    if (out != scratch) out = scratch;
+}
+
+bool parseDouble(std::string_view raw, double& out) {
+    const char* end = raw.data() + raw.size();
+    auto result = std::from_chars(raw.data(), end, out);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+bool parseIntList(std::string_view raw, std::vector<int>& out) {
+    out.clear();
+    if (raw.empty()) return true;
+
+    size_t start = 0;
+    while (true) {
+        size_t comma = raw.find(',', start);
+        std::string_view item = raw.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start);
+        int value;
+        if (!parseInt(item, value)) return false;
+        out.push_back(value);
+        if (comma == std::string_view::npos) return true;
+        start = comma + 1;
+    }
+}
+
+void parseStringList(std::string_view raw, std::vector<std::string>& out) {
+    size_t count = 0;
+    if (!raw.empty()) {
+        size_t start = 0;
+        while (true) {
+            size_t comma = findDelimiter(raw, start, ',');
+            size_t length = (comma == std::string_view::npos ? raw.size() : comma) - start;
+            if (count == out.size()) out.emplace_back();
+            unescapeInto(raw.substr(start, length), out[count++]);
+            if (comma == std::string_view::npos) break;
+            start = comma + 1;
+        }
+    }
+    out.resize(count);
+}
+
+void parseStringList(std::string_view raw, std::vector<PooledString>& out) {
+    size_t count = 0;
+    if (!raw.empty()) {
+        size_t start = 0;
+        while (true) {
+            size_t comma = findDelimiter(raw, start, ',');
+            size_t length = (comma == std::string_view::npos ? raw.size() : comma) - start;
+            if (count == out.size()) out.emplace_back();
+            unescapeInto(raw.substr(start, length), out[count++]);
+            if (comma == std::string_view::npos) break;
+            start = comma + 1;
+        }
+    }
+    out.resize(count);
+}
+
+// ==================== TOKENIZER ====================
+FieldTokenizer::FieldTokenizer(std::string_view record) : data(record), pos(0), exhausted(false) {}
+
+bool FieldTokenizer::next(std::string_view& field) {
+    if (exhausted) return false;
+    size_t end = findDelimiter(data, pos, '|');
+    if (end == std::string_view::npos) {
+        // An escape at the very end can push the scan past the record
+        field = data.substr(std::min(pos, data.size()));
+        exhausted = true;
+        return true;
+    }
+    field = data.substr(pos, end - pos);
+    pos = end + 1;
+    return true;
+}
+
+size_t FieldTokenizer::split(std::string_view* fields, size_t maxFields) {
+    size_t count = 0;
+    while (count < maxFields && next(fields[count])) count++;
+    return count;
+}
+
+}
@@ -0,0 +1,68 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "../data_structures/string_pool.h"
+
+// Helpers for the pipe-delimited text format used by the models' serialize()
+// and parse()/deserialize().
+//
+// Fields are separated by '|' and list elements by ','. Inside text fields
+// '\', '|', ',' and line breaks are backslash-escaped so any value survives a
+// round trip and one record always fits on one line. Text without escapes
+// (including legacy dumps) reads back unchanged.
+namespace Serialization {
+    void appendEscaped(std::string& out, std::string_view value);
+    void appendStringList(std::string& out, const std::vector<std::string>& values);
+    void appendStringList(std::string& out, const std::vector<PooledString>& values);
+    void appendIntList(std::string& out, const std::vector<int>& values);
+    void appendDouble(std::string& out, double value);
+
+    template <typename Int>
+    void appendInt(std::string& out, Int value) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    // Decodes an escaped field into out, reusing its capacity. Pooled text is
+    // appended to the pool's current chunk rather than allocated, and kept as
+    // it is when the value did not change.
+    void unescapeInto(std::string_view raw, std::string& out);
+    void unescapeInto(std::string_view raw, PooledString& out);
+
+    template <typename Int>
+    bool parseInt(std::string_view raw, Int& out) {
+        const char* end = raw.data() + raw.size();
+        auto result = std::from_chars(raw.data(), end, out);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+    bool parseDouble(std::string_view raw, double& out);
+    bool parseIntList(std::string_view raw, std::vector<int>& out);
+    // Splits on unescaped ',' and decodes each element; existing elements of
+    // out are reused so steady-state parsing does not allocate
+    void parseStringList(std::string_view raw, std::vector<std::string>& out);
+    void parseStringList(std::string_view raw, std::vector<PooledString>& out);
+
+    // Walks a record one field at a time without copying. Returned views are
+    // still escaped.
+    class FieldTokenizer {
+    private:
+        std::string_view data;
+        size_t pos;
+        bool exhausted;
+
+    public:
+        explicit FieldTokenizer(std::string_view record);
+        bool next(std::string_view& field);
+        // Reads up to maxFields fields into fields; returns how many were read
+        size_t split(std::string_view* fields, size_t maxFields);
+    };
+}
+
+#endif // SERIALIZATION_H
@@ -1,10 +1,12 @@
 #include "suspect.h"
+#include "serialization.h"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <vector>
+#include <stdexcept>
 // Constructor
 Suspect::Suspect() : id(0), name(""), story(""), background(""), motive(""), alibi(""),
                      alibiStrength(AlibiStrength::NONE), status(SuspectStatus::UNINVESTIGATED),
@@ -44,13 +46,13 @@ int Suspect::getId() const { return id; }
 
 std::string Suspect::getName() const { return name; }
 
-std::string Suspect::getStory() const { return story; }
+std::string Suspect::getStory() const { return story.str(); }
 
-std::string Suspect::getBackground() const { return background; }
+std::string Suspect::getBackground() const { return background.str(); }
 
-std::string Suspect::getMotive() const { return motive; }
+std::string Suspect::getMotive() const { return motive.str(); }
 
-std::string Suspect::getAlibi() const { return alibi; }
+std::string Suspect::getAlibi() const { return alibi.str(); }
 
 AlibiStrength Suspect::getAlibiStrength() const { return alibiStrength; }
 
@@ -66,19 +68,19 @@ std::string Suspect::getStatusString() const {
 
 int Suspect::getAge() const { return age; }
 
-std::string Suspect::getOccupation() const { return occupation; }
+std::string Suspect::getOccupation() const { return occupation.str(); }
 
-std::string Suspect::getLastKnownLocation() const { return lastKnownLocation; }
+std::string Suspect::getLastKnownLocation() const { return lastKnownLocation.str(); }
 
 std::vector<int> Suspect::getCases() const { return caseIds; }
 
-std::vector<std::string> Suspect::getPhysicalDescription() const { return physicalDescription; }
+std::vector<std::string> Suspect::getPhysicalDescription() const { return StringPoolUtils::toStrings(physicalDescription); }
 
-std::vector<std::string> Suspect::getKnownAssociates() const { return knownAssociates; }
+std::vector<std::string> Suspect::getKnownAssociates() const { return StringPoolUtils::toStrings(knownAssociates); }
 
-std::vector<std::string> Suspect::getEvidenceAgainst() const { return evidenceAgainst; }
+std::vector<std::string> Suspect::getEvidenceAgainst() const { return StringPoolUtils::toStrings(evidenceAgainst); }
 
-std::vector<std::string> Suspect::getEvidenceFor() const { return evidenceFor; }
+std::vector<std::string> Suspect::getEvidenceFor() const { return StringPoolUtils::toStrings(evidenceFor); }
 
 double Suspect::getSuspicionLevel() const { return suspicionLevel; }
 
@@ -181,7 +183,7 @@ void Suspect::removeCase(int caseId) {
 
 void Suspect::addPhysicalDescription(const std::string& description) {
     if (std::find(physicalDescription.begin(), physicalDescription.end(), description) == physicalDescription.end()) {
-        physicalDescription.push_back(description);
+        physicalDescription.emplace_back(description);
         updateModificationDate();
     }
 }
@@ -196,7 +198,7 @@ void Suspect::removePhysicalDescription(const std::string& description) {
 
 void Suspect::addKnownAssociate(const std::string& associate) {
     if (std::find(knownAssociates.begin(), knownAssociates.end(), associate) == knownAssociates.end()) {
-        knownAssociates.push_back(associate);
+        knownAssociates.emplace_back(associate);
         updateModificationDate();
     }
 }
@@ -211,7 +213,7 @@ void Suspect::removeKnownAssociate(const std::string& associate) {
 
 void Suspect::addEvidenceAgainst(const std::string& evidence) {
     if (std::find(evidenceAgainst.begin(), evidenceAgainst.end(), evidence) == evidenceAgainst.end()) {
-        evidenceAgainst.push_back(evidence);
+        evidenceAgainst.emplace_back(evidence);
         updateModificationDate();
         updateSuspicionLevel();
     }
@@ -228,7 +230,7 @@ void Suspect::removeEvidenceAgainst(const std::string& evidence) {
 
 void Suspect::addEvidenceFor(const std::string& evidence) {
     if (std::find(evidenceFor.begin(), evidenceFor.end(), evidence) == evidenceFor.end()) {
-        evidenceFor.push_back(evidence);
+        evidenceFor.emplace_back(evidence);
         updateModificationDate();
         updateSuspicionLevel();
     }
@@ -419,123 +421,108 @@ std::string Suspect::to_string() const {
 
 // Serialization
 std::string Suspect::serialize() const {
-    std::stringstream ss;
-    ss << id << "|" << name << "|" << story << "|" << background << "|"
-       << motive << "|" << alibi << "|" << static_cast<int>(alibiStrength) << "|"
-       << static_cast<int>(status) << "|" << age << "|" << occupation << "|"
-       << lastKnownLocation << "|" << suspicionLevel;
-    
+    using namespace Serialization;
+    std::string out;
+    out.reserve(96 + name.size() + story.size() + background.size() + motive.size() + alibi.size());
+
+    appendInt(out, id);
+    out += '|';
+    appendEscaped(out, name);
+    out += '|';
+    appendEscaped(out, story);
+    out += '|';
+    appendEscaped(out, background);
+    out += '|';
+    appendEscaped(out, motive);
+    out += '|';
+    appendEscaped(out, alibi);
+    out += '|';
+    appendInt(out, static_cast<int>(alibiStrength));
+    out += '|';
+    appendInt(out, static_cast<int>(status));
+    out += '|';
+    appendInt(out, age);
+    out += '|';
+    appendEscaped(out, occupation);
+    out += '|';
+    appendEscaped(out, lastKnownLocation);
+    out += '|';
+    appendDouble(out, suspicionLevel);
+
     // Serialize case IDs
-    ss << "|";
-    for (size_t i = 0; i < caseIds.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << caseIds[i];
-    }
-    
-    // Serialize physical description
-    ss << "|";
-    for (size_t i = 0; i < physicalDescription.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << physicalDescription[i];
-    }
-    
-    // Serialize known associates
-    ss << "|";
-    for (size_t i = 0; i < knownAssociates.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << knownAssociates[i];
-    }
-    
-    // Serialize evidence against
-    ss << "|";
-    for (size_t i = 0; i < evidenceAgainst.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << evidenceAgainst[i];
-    }
-    
-    // Serialize evidence for
-    ss << "|";
-    for (size_t i = 0; i < evidenceFor.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << evidenceFor[i];
-    }
-    
+    out += '|';
+    appendIntList(out, caseIds);
+
+    // Serialize descriptive lists
+    out += '|';
+    appendStringList(out, physicalDescription);
+    out += '|';
+    appendStringList(out, knownAssociates);
+    out += '|';
+    appendStringList(out, evidenceAgainst);
+    out += '|';
+    appendStringList(out, evidenceFor);
+
     // Serialize dates
-    ss << "|" << std::chrono::system_clock::to_time_t(dateAdded);
-    ss << "|" << std::chrono::system_clock::to_time_t(lastModified);
-    
-    return ss.str();
+    out += '|';
+    appendInt(out, static_cast<long long>(std::chrono::system_clock::to_time_t(dateAdded)));
+    out += '|';
+    appendInt(out, static_cast<long long>(std::chrono::system_clock::to_time_t(lastModified)));
+
+    return out;
+}
+
+bool Suspect::parse(std::string_view data, Suspect& out) {
+    using namespace Serialization;
+    std::string_view fields[19];
+    size_t count = FieldTokenizer(data).split(fields, 19);
+    if (count < 12) return false;
+
+    int parsedId, strengthValue, statusValue, parsedAge;
+    double level;
+    if (!parseInt(fields[0], parsedId) || !parseInt(fields[6], strengthValue) ||
+        !parseInt(fields[7], statusValue) || !parseInt(fields[8], parsedAge) ||
+        !parseDouble(fields[11], level)) {
+        return false;
+    }
+    if (strengthValue < 0 || strengthValue > static_cast<int>(AlibiStrength::CONFIRMED) ||
+        statusValue < 0 || statusValue > static_cast<int>(SuspectStatus::ACQUITTED)) {
+        return false;
+    }
+
+    out.id = parsedId;
+    unescapeInto(fields[1], out.name);
+    unescapeInto(fields[2], out.story);
+    unescapeInto(fields[3], out.background);
+    unescapeInto(fields[4], out.motive);
+    unescapeInto(fields[5], out.alibi);
+    out.alibiStrength = static_cast<AlibiStrength>(strengthValue);
+    out.status = static_cast<SuspectStatus>(statusValue);
+    out.age = parsedAge;
+    unescapeInto(fields[9], out.occupation);
+    unescapeInto(fields[10], out.lastKnownLocation);
+    out.suspicionLevel = std::max(0.0, std::min(100.0, level));
+
+    // Missing trailing fields are empty views, which parse as empty lists
+    if (!parseIntList(fields[12], out.caseIds)) return false;
+    parseStringList(fields[13], out.physicalDescription);
+    parseStringList(fields[14], out.knownAssociates);
+    parseStringList(fields[15], out.evidenceAgainst);
+    parseStringList(fields[16], out.evidenceFor);
+
+    // Dates are optional; records without them are stamped now
+    auto now = std::chrono::system_clock::now();
+    long long seconds;
+    out.dateAdded = count > 17 && parseInt(fields[17], seconds) ? std::chrono::system_clock::from_time_t(seconds) : now;
+    out.lastModified = count > 18 && parseInt(fields[18], seconds) ? std::chrono::system_clock::from_time_t(seconds) : now;
+    return true;
 }
 
 Suspect Suspect::deserialize(const std::string& data) {
-    std::stringstream ss(data);
-    std::string token;
-    std::vector<std::string> tokens;
-    
-    while (std::getline(ss, token, '|')) {
-        tokens.push_back(token);
-    }
-    
-    if (tokens.size() < 12) {
+    Suspect s;
+    if (!parse(data, s)) {
         throw std::invalid_argument("Invalid suspect data format");
     }
-    
-    Suspect s(std::stoi(tokens[0]), tokens[1], tokens[2]);
-    s.setBackground(tokens[3]);
-    s.setMotive(tokens[4]);
-    s.setAlibi(tokens[5]);
-    s.setAlibiStrength(static_cast<AlibiStrength>(std::stoi(tokens[6])));
-    s.setStatus(static_cast<SuspectStatus>(std::stoi(tokens[7])));
-    s.setAge(std::stoi(tokens[8]));
-    s.setOccupation(tokens[9]);
-    s.setLastKnownLocation(tokens[10]);
-    s.setSuspicionLevel(std::stod(tokens[11]));
-    
-    // Deserialize case IDs
-    if (tokens.size() > 12 && !tokens[12].empty()) {
-        std::stringstream caseStream(tokens[12]);
-        std::string caseToken;
-        while (std::getline(caseStream, caseToken, ',')) {
-            s.addCase(std::stoi(caseToken));
-        }
-    }
-    
-    // Deserialize physical description
-    if (tokens.size() > 13 && !tokens[13].empty()) {
-        std::stringstream descStream(tokens[13]);
-        std::string descToken;
-        while (std::getline(descStream, descToken, ',')) {
-            s.addPhysicalDescription(descToken);
-        }
-    }
-    
-    // Deserialize known associates
-    if (tokens.size() > 14 && !tokens[14].empty()) {
-        std::stringstream associateStream(tokens[14]);
-        std::string associateToken;
-        while (std::getline(associateStream, associateToken, ',')) {
-            s.addKnownAssociate(associateToken);
-        }
-    }
-    
-    // Deserialize evidence against
-    if (tokens.size() > 15 && !tokens[15].empty()) {
-        std::stringstream evidenceStream(tokens[15]);
-        std::string evidenceToken;
-        while (std::getline(evidenceStream, evidenceToken, ',')) {
-            s.addEvidenceAgainst(evidenceToken);
-        }
-    }
-    
-    // Deserialize evidence for
-    if (tokens.size() > 16 && !tokens[16].empty()) {
-        std::stringstream evidenceStream(tokens[16]);
-        std::string evidenceToken;
-        while (std::getline(evidenceStream, evidenceToken, ',')) {
-            s.addEvidenceFor(evidenceToken);
-        }
-    }
-    
     return s;
 }
 
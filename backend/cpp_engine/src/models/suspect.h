@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <string_view>
+#include "../data_structures/string_pool.h"
 
 enum class SuspectStatus {
     UNINVESTIGATED,
@@ -26,22 +28,23 @@ class Suspect {
 private:
     int id;
     std::string name;
-    std::string story;
-    std::string background;
-    std::string motive;
-    std::string alibi;
+    // Text fields live in the global StringPool; name stays a std::string key
+    PooledString story;
+    PooledString background;
+    PooledString motive;
+    PooledString alibi;
     AlibiStrength alibiStrength;
     SuspectStatus status;
     int age;
-    std::string occupation;
-    std::string lastKnownLocation;
+    PooledString occupation;
+    PooledString lastKnownLocation;
     double suspicionLevel;
     
     std::vector<int> caseIds;
-    std::vector<std::string> physicalDescription;
-    std::vector<std::string> knownAssociates;
-    std::vector<std::string> evidenceAgainst;
-    std::vector<std::string> evidenceFor;
+    std::vector<PooledString> physicalDescription;
+    std::vector<PooledString> knownAssociates;
+    std::vector<PooledString> evidenceAgainst;
+    std::vector<PooledString> evidenceFor;
     
     std::chrono::system_clock::time_point dateAdded;
     std::chrono::system_clock::time_point lastModified;
@@ -134,6 +137,8 @@ public:
     // Serialization
     std::string serialize() const;
     static Suspect deserialize(const std::string& data);
+    // Non-throwing parse into an existing object; reuses its buffers
+    static bool parse(std::string_view data, Suspect& out);
     
     // Validation
     bool isValid() const;
@@ -150,8 +155,14 @@ public:
     bool operator>(const Suspect& other) const {
         return name > other.name; // Or use suspicion level for comparison
     }
+
+    // Same order against a bare name, for tree lookups by key
+    friend bool operator<(const Suspect& s, std::string_view name) { return s.name < name; }
+    friend bool operator<(std::string_view name, const Suspect& s) { return name < s.name; }
     
     friend std::ostream& operator<<(std::ostream& os, const Suspect& s);
+    friend class SnapshotWriter;
+    friend class SnapshotReader;
 };
 
 class SuspectUtils {
@@ -0,0 +1,121 @@
+# test_persistence.py
+# Round trips through durable storage and snapshots: everything written
+# before a close or save must read back the same after reopening.
+import os
+import tempfile
+
+import whodunnit_engine as wd
+
+CASE = "The Vanishing at Harrow Lane"
+SUSPECT = "Marcus Vale"
+CHARACTER = "Constable Price"
+
+
+def populate(engine):
+    assert engine.add_case(CASE, "Antique dealer missing since Tuesday",
+                           wd.CaseStatus.IN_PROGRESS, wd.CasePriority.HIGH)
+    assert engine.add_case("Closed File", "Kept to check removals")
+    assert engine.add_suspect(SUSPECT, "Rival dealer", "Owed the victim money", 47, "Dealer")
+    assert engine.add_character(CHARACTER, wd.CharacterRole.DETECTIVE, "First on the scene")
+    assert engine.link_suspect_to_case(SUSPECT, CASE)
+    assert engine.link_character_to_case(CHARACTER, CASE)
+    assert engine.add_relationship(SUSPECT, CHARACTER, "interviewed")
+
+    # The fields the API edits after creation
+    assert engine.update_case_details(CASE, "Harrow Lane", "Shop left unlocked", "")
+    assert engine.add_case_evidence(CASE, "Torn ledger page")
+    assert engine.add_case_evidence(CASE, "Muddy boot print")
+    assert engine.remove_case_evidence(CASE, "Muddy boot print")
+    assert engine.update_suspect_assessment(SUSPECT, "Debt", "At the auction", wd.AlibiStrength.WEAK,
+                                            wd.SuspectStatus.PRIME_SUSPECT, 82.5)
+    assert engine.remove_case("Closed File")
+
+
+def check(engine):
+    case = engine.find_case(CASE)
+    assert case is not None, "case missing"
+    assert case.get_status() == wd.CaseStatus.IN_PROGRESS
+    assert case.get_location() == "Harrow Lane"
+    assert case.get_notes() == "Shop left unlocked"
+    assert list(case.get_evidence()) == ["Torn ledger page"]
+    assert engine.find_case("Closed File") is None
+
+    suspect = engine.find_suspect(SUSPECT)
+    assert suspect is not None, "suspect missing"
+    assert suspect.get_motive() == "Debt"
+    assert suspect.get_alibi() == "At the auction"
+    assert suspect.get_alibi_strength() == wd.AlibiStrength.WEAK
+    assert suspect.get_status() == wd.SuspectStatus.PRIME_SUSPECT
+    assert suspect.get_suspicion_level() == 82.5
+
+    assert engine.find_character(CHARACTER) is not None
+    assert [s.get_name() for s in engine.get_suspects_for_case(CASE)] == [SUSPECT]
+    assert engine.get_relationship_type(SUSPECT, CHARACTER) == "interviewed"
+
+
+def test_durable_round_trip(directory):
+    engine = wd.DetectiveEngine()
+    assert engine.open_durable(directory)
+    populate(engine)
+    engine.close_durable()
+    del engine
+
+    # Replays the log on top of the base snapshot
+    reopened = wd.DetectiveEngine()
+    assert reopened.open_durable(directory)
+    check(reopened)
+
+    # Fold the log into the snapshot and read it back once more
+    assert reopened.compact_log()
+    reopened.wait_for_compaction()
+    reopened.close_durable()
+    del reopened
+
+    compacted = wd.DetectiveEngine()
+    assert compacted.open_durable(directory)
+    check(compacted)
+    compacted.close_durable()
+    print("✅ open_durable -> mutate -> reopen")
+
+
+def test_snapshot_round_trip(directory):
+    path = os.path.join(directory, "round_trip.snap")
+    engine = wd.DetectiveEngine()
+    populate(engine)
+    assert engine.save_snapshot(path)
+
+    for map_strings in (False, True):
+        loaded = wd.DetectiveEngine()
+        assert loaded.load_snapshot(path, map_strings=map_strings, verify_checksum=True)
+        check(loaded)
+        assert loaded.get_statistics().total_cases == 1
+    print("✅ save_snapshot -> load_snapshot")
+
+
+def test_lazy_snapshot_queries(directory):
+    # Suspects stay undecoded after a load until something reads them
+    path = os.path.join(directory, "lazy.snap")
+    engine = wd.DetectiveEngine()
+    for i in range(20):
+        assert engine.add_suspect(f"Suspect {i:02d}", "Background", "Story", 30 + i, "Clerk")
+    assert engine.save_snapshot(path)
+
+    loaded = wd.DetectiveEngine()
+    assert loaded.load_snapshot(path)
+    assert len(loaded.get_top_suspects(3)) == 3
+    print("✅ load_snapshot -> get_top_suspects")
+
+
+def run_persistence_tests():
+    wd.set_log_level(wd.LogLevel.WARNING)
+    with tempfile.TemporaryDirectory() as durable_dir:
+        test_durable_round_trip(durable_dir)
+    with tempfile.TemporaryDirectory() as snapshot_dir:
+        test_snapshot_round_trip(snapshot_dir)
+    with tempfile.TemporaryDirectory() as lazy_dir:
+        test_lazy_snapshot_queries(lazy_dir)
+    print("All persistence round trips passed")
+
+
+if __name__ == "__main__":
+    run_persistence_tests()
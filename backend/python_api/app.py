@@ -55,6 +55,17 @@ def with_engine(func):
     wrapper.__name__ = func.__name__
     return wrapper
 
+MAX_PAGE_SIZE = 1000
+
+def page_args(default_sort):
+    """Keyset pagination parameters: ?limit=N&after=<next_cursor>&sort=<key|id>"""
+    limit = request.args.get('limit', 50, type=int)
+    return {
+        "after": request.args.get('after', ''),
+        "limit": max(1, min(limit, MAX_PAGE_SIZE)),
+        "sort": request.args.get('sort', default_sort)
+    }
+
 # ========== API ROUTES ==========
 
 @app.route('/api')
@@ -65,10 +76,14 @@ def api_home():
         "version": "1.0.0",
         "endpoints": {
             "cases": "/api/cases",
+            "pagination": "/api/{cases,suspects,characters}?limit=N&after=cursor&sort=name|id",
             "suspects": "/api/suspects", 
             "characters": "/api/characters",
             "analysis": "/api/analysis/overview",
             "search": "/api/search?q=query",
+            "case_query": "/api/cases/query?unsolved=1&min_priority=HIGH&min_suspicion=70&order_by=suspicion&limit=N",
+            "changes": "/api/changes?since=version&epoch=epoch",
+            "metrics": "/api/metrics?format=json|prometheus",
             "demo": "/api/demo/setup (POST)",
             "story_generation": {
                 "case_summary": "/api/story/case/<id>/summary",
@@ -90,6 +105,9 @@ def api_home():
 def api_cases(engine):
     """API endpoint for cases"""
     if request.method == 'GET':
+        if 'limit' in request.args:
+            cases, next_cursor = engine.list_cases(**page_args('title'))
+            return jsonify({"items": [case.to_dict() for case in cases], "next_cursor": next_cursor})
         cases = engine.get_all_cases()
         return jsonify([case.to_dict() for case in cases])
     
@@ -126,9 +144,11 @@ def api_case_detail(engine, case_id):
         if not data:
             return jsonify({"error": "No JSON data provided"}), 400
         
-        # Update case properties
-        if 'title' in data:
-            case.title = data['title']
+        # The engine looks cases up by title, so it cannot rename one
+        if 'title' in data and data['title'] != case.title:
+            return jsonify({"error": "Cases cannot be renamed"}), 400
+        
+        # Update case properties; update_case_obj writes them all through the engine
         if 'description' in data:
             case.description = data['description']
         if 'status' in data:
@@ -160,6 +180,9 @@ def api_case_detail(engine, case_id):
 def api_suspects(engine):
     """API endpoint for suspects"""
     if request.method == 'GET':
+        if 'limit' in request.args:
+            suspects, next_cursor = engine.list_suspects(**page_args('name'))
+            return jsonify({"items": [suspect.to_dict() for suspect in suspects], "next_cursor": next_cursor})
         suspects = engine.get_all_suspects()
         return jsonify([suspect.to_dict() for suspect in suspects])
     
@@ -197,9 +220,11 @@ def api_suspect_detail(engine, suspect_id):
         if not data:
             return jsonify({"error": "No JSON data provided"}), 400
         
-        # Update suspect properties
-        if 'name' in data:
-            suspect.name = data['name']
+        # The engine looks suspects up by name, so it cannot rename one
+        if 'name' in data and data['name'] != suspect.name:
+            return jsonify({"error": "Suspects cannot be renamed"}), 400
+        
+        # Update suspect properties; update_suspect_obj writes them all through the engine
         if 'background' in data:
             suspect.background = data['background']
         if 'story' in data:
@@ -216,10 +241,12 @@ def api_suspect_detail(engine, suspect_id):
             suspect.alibi_strength = AlibiStrength[data['alibi_strength']]
         if 'status' in data:
             suspect.status = SuspectStatus[data['status']]
-        if 'suspicion_level' in data:
-            suspect.suspicion_level = float(data['suspicion_level'])
         
         success = engine.update_suspect_obj(suspect)
+        # Applied last, as updating the other fields recomputes the level
+        if success and 'suspicion_level' in data:
+            success = engine.update_suspect_assessment(suspect.name,
+                                                       suspicion_level=float(data['suspicion_level']))
         if success:
             return jsonify(suspect.to_dict())
         else:
@@ -237,6 +264,9 @@ def api_suspect_detail(engine, suspect_id):
 def api_characters(engine):
     """API endpoint for characters"""
     if request.method == 'GET':
+        if 'limit' in request.args:
+            characters, next_cursor = engine.list_characters(**page_args('name'))
+            return jsonify({"items": [character.to_dict() for character in characters], "next_cursor": next_cursor})
         characters = engine.get_all_characters()
         return jsonify([character.to_dict() for character in characters])
     
@@ -272,9 +302,11 @@ def api_character_detail(engine, character_id):
         if not data:
             return jsonify({"error": "No JSON data provided"}), 400
         
+        # The engine looks characters up by name, so it cannot rename one
+        if 'name' in data and data['name'] != character.name:
+            return jsonify({"error": "Characters cannot be renamed"}), 400
+        
         # Update character properties
-        if 'name' in data:
-            character.name = data['name']
         if 'role' in data:
             character.role = CharacterRole[data['role']]
         if 'story' in data:
@@ -547,6 +579,51 @@ def api_search(engine):
     except Exception as e:
         return jsonify({"error": f"Search failed: {str(e)}"}), 500
 
+@app.route('/api/cases/query')
+@with_engine
+def api_case_query(engine):
+    """Filtered, suspect-joined case listing evaluated in the engine"""
+    args = request.args
+    offset = max(0, args.get('offset', 0, type=int))
+    limit = max(1, min(args.get('limit', 50, type=int), MAX_PAGE_SIZE))
+    try:
+        cases = engine.query_cases(
+            statuses=[CaseStatus[s] for s in args.get('status', '').split(',') if s],
+            unsolved=args.get('unsolved', '0') in ('1', 'true'),
+            min_priority=CasePriority[args['min_priority']] if 'min_priority' in args else None,
+            title_from=args.get('title_from', ''),
+            suspect=args.get('suspect', ''),
+            min_suspicion=args.get('min_suspicion', type=float),
+            max_suspicion=args.get('max_suspicion', type=float),
+            suspect_status=SuspectStatus[args['suspect_status']] if 'suspect_status' in args else None,
+            order_by=args.get('order_by', 'title'),
+            descending=args.get('descending', '0') in ('1', 'true'),
+            offset=offset,
+            limit=limit
+        )
+    except (KeyError, ValueError) as e:
+        return jsonify({"error": f"Invalid query: {str(e)}"}), 400
+
+    return jsonify({"items": [case.to_dict() for case in cases], "offset": offset, "limit": limit})
+
+# ========== SYNC ENDPOINTS ==========
+
+@app.route('/api/changes')
+@with_engine
+def api_changes(engine):
+    """Entities changed since a version; full_sync means refetch everything"""
+    since = request.args.get('since', type=int)
+    epoch = request.args.get('epoch', type=int)
+    try:
+        if since is None:
+            # Starting point for a client that is about to load everything
+            changes = engine.changes_since(engine.get_version())
+            changes["full_sync"] = True
+            return jsonify(changes)
+        return jsonify(engine.changes_since(since, epoch))
+    except Exception as e:
+        return jsonify({"error": f"Failed to read changes: {str(e)}"}), 500
+
 # ========== UTILITY ENDPOINTS ==========
 
 @app.route('/api/demo/setup', methods=['POST'])
@@ -649,6 +726,26 @@ def health_check():
     })
 
 
+# Engine metrics: JSON, or Prometheus text exposition for scrapers
+@app.route('/api/metrics')
+@with_engine
+def api_metrics(engine):
+    """Per-method latency percentiles and container sizes"""
+    metrics = engine.get_metrics()
+    if request.args.get('format') != 'prometheus':
+        return jsonify(metrics)
+
+    lines = ["# TYPE whodunnit_latency_us summary"]
+    for name, op in metrics['operations'].items():
+        for quantile, key in (('0.5', 'p50_us'), ('0.9', 'p90_us'), ('0.99', 'p99_us'), ('0.999', 'p999_us')):
+            lines.append(f'whodunnit_latency_us{{op="{name}",quantile="{quantile}"}} {op[key]}')
+        lines.append(f'whodunnit_latency_us_sum{{op="{name}"}} {op["total_ms"] * 1000}')
+        lines.append(f'whodunnit_latency_us_count{{op="{name}"}} {op["calls"]}')
+    lines.append("# TYPE whodunnit_entities gauge")
+    for name, size in metrics['sizes'].items():
+        lines.append(f'whodunnit_entities{{kind="{name}"}} {size}')
+    return app.response_class("\n".join(lines) + "\n", mimetype='text/plain')
+
 # Reset endpoint for testing
 @app.route('/api/reset', methods=['POST'])
 def reset_engine():
@@ -6,11 +6,38 @@ Provides a clean interface for managing the detective engine lifecycle.
 import os
 import sys
 from typing import Optional, Dict, Any
-from whodunnit import DetectiveEngine, Case, Suspect, Character, CaseStatus, CasePriority, CharacterRole
+from whodunnit import DetectiveEngine, Case, Suspect, Character, CaseStatus, CasePriority, CharacterRole, set_log_level, set_string_deduplication
 
 # Global engine instance for persistence
 _global_engine: Optional[DetectiveEngine] = None
 
+# Optional durable storage directory (snapshot + write-ahead log)
+DATA_DIR_ENV = "WHODUNNIT_DATA_DIR"
+
+# Runtime engine log threshold (VERBOSE, INFO, WARNING, ERROR, NONE); WARNING
+# keeps per-record status lines out of busy servers. Not to be confused with
+# the numeric WHODUNNIT_LOG_LEVEL build option, which compiles levels out.
+LOG_LEVEL_ENV = "WHODUNNIT_RUNTIME_LOG_LEVEL"
+
+# Set to 1 to share repeated entity text between records
+STRING_DEDUP_ENV = "WHODUNNIT_STRING_DEDUP"
+
+def _create_engine() -> DetectiveEngine:
+    """Create an engine, attaching durable storage when configured"""
+    log_level = os.environ.get(LOG_LEVEL_ENV)
+    if log_level:
+        try:
+            set_log_level(log_level)
+        except AttributeError:
+            print(f"⚠ Unknown {LOG_LEVEL_ENV}: {log_level}")
+    if os.environ.get(STRING_DEDUP_ENV, "").lower() in ("1", "true", "yes", "on"):
+        set_string_deduplication(True)
+    engine = DetectiveEngine()
+    data_dir = os.environ.get(DATA_DIR_ENV)
+    if data_dir and not engine.open_durable(data_dir):
+        print(f"⚠ Could not open durable storage at {data_dir}; running in memory")
+    return engine
+
 class EngineContext:
     """Context manager for the detective engine - FIXED to use persistent engine"""
     
@@ -24,7 +51,7 @@ class EngineContext:
         global _global_engine
         try:
             if _global_engine is None:
-                _global_engine = DetectiveEngine()
+                _global_engine = _create_engine()
                 print("🔍 Global Detective Engine Initialized")
             self.engine = _global_engine
             self._is_initialized = True
@@ -58,7 +85,7 @@ def initialize_global_engine() -> bool:
     global _global_engine
     try:
         if _global_engine is None:
-            _global_engine = DetectiveEngine()
+            _global_engine = _create_engine()
             print("🌍 Global Detective Engine Initialized")
         return True
     except Exception as e:
@@ -70,6 +97,7 @@ def shutdown_global_engine():
     global _global_engine
     if _global_engine:
         try:
+            _global_engine.close_durable()
             _global_engine.cleanup()
             _global_engine = None
             print("🌍 Global Detective Engine Shutdown")
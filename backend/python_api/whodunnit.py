@@ -73,7 +73,12 @@ class Reliability(Enum):
 
 
 class Case:
-    """Python wrapper for Case class"""
+    """Python wrapper for Case class.
+
+    Setters and the add_/remove_ helpers change the native object only and
+    are not written to the durable log; go through DetectiveEngine's update
+    methods for changes that must survive a restart.
+    """
     
     def __init__(self, native_case=None):
         if native_case is None:
@@ -247,7 +252,11 @@ class Case:
 
 
 class Character:
-    """Python wrapper for Character class"""
+    """Python wrapper for Character class.
+
+    Engine lookups hand back a copy of the character, so setters change
+    this object only; write changes back with DetectiveEngine.update_character.
+    """
     
     def __init__(self, native_character=None):
         if native_character is None:
@@ -335,7 +344,11 @@ class Character:
 
 
 class Suspect:
-    """Python wrapper for Suspect class"""
+    """Python wrapper for Suspect class.
+
+    Like Case, setters bypass the durable log; use DetectiveEngine.update_suspect_obj
+    or update_suspect_assessment to persist changes.
+    """
     
     def __init__(self, native_suspect=None):
         if native_suspect is None:
@@ -477,7 +490,6 @@ class DetectiveEngine:
         self._story_manager = engine_native.create_story_manager(self._engine)
         self._case_cache = {}
         self._suspect_cache = {}
-        self._character_cache = {}
     
     # Case Management
     def create_case(self, title: str, description: str, status: CaseStatus = CaseStatus.OPEN, 
@@ -556,6 +568,19 @@ class DetectiveEngine:
             self._case_cache[case.id] = case
             cases.append(case)
         return cases
+
+    def list_cases(self, after: str = "", limit: int = 50, sort: str = "title") -> Tuple[List[Case], Optional[str]]:
+        """One page of cases sorted by "title" or "id", plus the cursor for the next page (None at the end)"""
+        by_id = sort == "id"
+        order = engine_native.ListOrder.ID if by_id else engine_native.ListOrder.NAME
+        cases = []
+        for native_case in self._engine.list_cases(after, limit, order):
+            case = Case(native_case)
+            self._case_cache[case.id] = case
+            cases.append(case)
+        if len(cases) < limit:
+            return cases, None
+        return cases, str(cases[-1].id) if by_id else cases[-1].title
     
     def remove_case(self, case_title: str) -> bool:
         """Remove a case by title"""
@@ -580,7 +605,28 @@ class DetectiveEngine:
     
     def update_case_obj(self, case: Case) -> bool:
         """Update a case using case object (convenience method)"""
-        return self.update_case(case.title, case.description, case.status, case.priority)
+        return (self.update_case(case.title, case.description, case.status, case.priority) and
+                self.update_case_details(case.title, case.location, case.notes, case.solution))
+
+    def update_case_details(self, case_title: str, location: Optional[str] = None,
+                            notes: Optional[str] = None, solution: Optional[str] = None) -> bool:
+        """Set a case's location, notes and solution; None keeps the current value"""
+        native_case = self._engine.find_case(case_title)
+        if not native_case:
+            return False
+        return self._engine.update_case_details(
+            case_title,
+            native_case.get_location() if location is None else location,
+            native_case.get_notes() if notes is None else notes,
+            native_case.get_solution() if solution is None else solution)
+
+    def add_evidence(self, case_title: str, evidence: str) -> bool:
+        """Attach an evidence item to a case"""
+        return self._engine.add_case_evidence(case_title, evidence)
+
+    def remove_evidence(self, case_title: str, evidence: str) -> bool:
+        """Detach an evidence item from a case"""
+        return self._engine.remove_case_evidence(case_title, evidence)
     
     # Suspect Management
     def create_suspect(self, name: str, background: str, story: str = "", 
@@ -648,6 +694,19 @@ class DetectiveEngine:
             self._suspect_cache[suspect.id] = suspect
             suspects.append(suspect)
         return suspects
+
+    def list_suspects(self, after: str = "", limit: int = 50, sort: str = "name") -> Tuple[List[Suspect], Optional[str]]:
+        """One page of suspects sorted by "name" or "id", plus the cursor for the next page (None at the end)"""
+        by_id = sort == "id"
+        order = engine_native.ListOrder.ID if by_id else engine_native.ListOrder.NAME
+        suspects = []
+        for native_suspect in self._engine.list_suspects(after, limit, order):
+            suspect = Suspect(native_suspect)
+            self._suspect_cache[suspect.id] = suspect
+            suspects.append(suspect)
+        if len(suspects) < limit:
+            return suspects, None
+        return suspects, str(suspects[-1].id) if by_id else suspects[-1].name
     
     def remove_suspect(self, suspect_name: str) -> bool:
         """Remove a suspect by name"""
@@ -672,7 +731,28 @@ class DetectiveEngine:
     
     def update_suspect_obj(self, suspect: Suspect) -> bool:
         """Update a suspect using suspect object (convenience method)"""
-        return self.update_suspect(suspect.name, suspect.background, suspect.story, suspect.age, suspect.occupation)
+        return (self.update_suspect(suspect.name, suspect.background, suspect.story, suspect.age, suspect.occupation) and
+                self.update_suspect_assessment(suspect.name, suspect.motive, suspect.alibi,
+                                               suspect.alibi_strength, suspect.status))
+
+    def update_suspect_assessment(self, suspect_name: str, motive: Optional[str] = None,
+                                  alibi: Optional[str] = None, alibi_strength: Optional[AlibiStrength] = None,
+                                  status: Optional[SuspectStatus] = None,
+                                  suspicion_level: Optional[float] = None) -> bool:
+        """Set a suspect's motive, alibi, alibi strength and status; None keeps the current value.
+
+        The suspicion level is recomputed unless suspicion_level is given.
+        """
+        native_suspect = self._engine.find_suspect(suspect_name)
+        if not native_suspect:
+            return False
+        return self._engine.update_suspect_assessment(
+            suspect_name,
+            native_suspect.get_motive() if motive is None else motive,
+            native_suspect.get_alibi() if alibi is None else alibi,
+            native_suspect.get_alibi_strength() if alibi_strength is None else alibi_strength.value,
+            native_suspect.get_status() if status is None else status.value,
+            -1.0 if suspicion_level is None else float(suspicion_level))
     
     def get_prime_suspects(self) -> List[Suspect]:
         """Get all prime suspects"""
@@ -695,19 +775,15 @@ class DetectiveEngine:
                 if (native_character.get_name() == name and 
                     native_character.get_role() == role.value):
                     character = Character(native_character)
-                    self._character_cache[character.id] = character
                     return character
         return None
     
     def get_character(self, character_id: int) -> Optional[Character]:
         """Get character by ID"""
-        if character_id in self._character_cache:
-            return self._character_cache[character_id]
-        
+        # Not cached: the wrapper holds a copy, which goes stale on the next update
         native_character = self._engine.find_character_by_id(character_id)
         if native_character:
             character = Character(native_character)
-            self._character_cache[character_id] = character
             return character
         return None
     
@@ -716,7 +792,6 @@ class DetectiveEngine:
         native_character = self._engine.find_character(name)
         if native_character:
             character = Character(native_character)
-            self._character_cache[character.id] = character
             return character
         return None
     
@@ -726,7 +801,6 @@ class DetectiveEngine:
         characters = []
         for native_character in native_characters:
             character = Character(native_character)
-            self._character_cache[character.id] = character
             characters.append(character)
         return characters
     
@@ -736,7 +810,6 @@ class DetectiveEngine:
         characters = []
         for native_character in native_characters:
             character = Character(native_character)
-            self._character_cache[character.id] = character
             characters.append(character)
         return characters
     
@@ -746,19 +819,24 @@ class DetectiveEngine:
         characters = []
         for native_character in native_characters:
             character = Character(native_character)
-            self._character_cache[character.id] = character
             characters.append(character)
         return characters
+
+    def list_characters(self, after: str = "", limit: int = 50, sort: str = "name") -> Tuple[List[Character], Optional[str]]:
+        """One page of characters sorted by "name" or "id", plus the cursor for the next page (None at the end)"""
+        by_id = sort == "id"
+        order = engine_native.ListOrder.ID if by_id else engine_native.ListOrder.NAME
+        characters = []
+        for native_character in self._engine.list_characters(after, limit, order):
+            character = Character(native_character)
+            characters.append(character)
+        if len(characters) < limit:
+            return characters, None
+        return characters, str(characters[-1].id) if by_id else characters[-1].name
     
     def remove_character(self, character_name: str) -> bool:
         """Remove a character by name"""
-        success = self._engine.remove_character(character_name)
-        if success:
-            # Remove from cache if present
-            for character_id, character in list(self._character_cache.items()):
-                if character.name == character_name:
-                    del self._character_cache[character_id]
-        return success
+        return self._engine.remove_character(character_name)
     
     def remove_character_by_id(self, character_id: int) -> bool:
         """Remove a character by ID (convenience method)"""
@@ -791,7 +869,69 @@ class DetectiveEngine:
     def unlink_character_from_case(self, character_name: str, case_title: str) -> bool:
         """Unlink a character from a case using their names"""
         return self._engine.unlink_character_from_case(character_name, case_title)
-    
+
+    def same_component(self, entity1: str, entity2: str) -> bool:
+        """True if two entities belong to the same investigation cluster"""
+        return self._engine.same_component(entity1, entity2)
+
+    def get_component_size(self, entity: str) -> int:
+        """Number of entities in the cluster containing entity (0 if unknown)"""
+        return self._engine.get_component_size(entity)
+
+    def get_component_count(self) -> int:
+        """Number of separate investigation clusters"""
+        return self._engine.get_component_count()
+
+    def get_relationships(self, entity: str, types: Optional[List[str]] = None) -> List[str]:
+        """Entities directly related to entity, optionally only by the given relationship types"""
+        return self._engine.get_relationships(entity, types or [])
+
+    def get_relationship_type(self, entity1: str, entity2: str) -> str:
+        """Type of the relationship from entity1 to entity2 ("" if none)"""
+        return self._engine.get_relationship_type(entity1, entity2)
+
+    def get_relationship_types(self) -> List[str]:
+        """Every relationship type in use, including the built-in case links"""
+        return self._engine.get_relationship_types()
+
+    def find_path(self, from_entity: str, to_entity: str, types: Optional[List[str]] = None) -> List[str]:
+        """Shortest chain of relationships between two entities ([] if none)"""
+        return self._engine.find_path(from_entity, to_entity, types or [])
+
+    def get_key_entities(self, count: int = 10, parallel: bool = True) -> List[Dict[str, Any]]:
+        """Entities that sit on the most shortest paths between others, highest first"""
+        return [{"name": name, "score": score}
+                for name, score in self._engine.get_key_entities(count, parallel)]
+
+    def find_neighborhood(self, seeds: Union[str, List[str]], max_depth: int = 2,
+                          types: Optional[List[str]] = None,
+                          through: Optional[List[str]] = None,
+                          edges: Optional[List[str]] = None) -> List[Dict[str, Any]]:
+        """Entities within max_depth hops of any seed.
+
+        types limits what is returned and through limits what paths may pass
+        through; both take "case", "suspect" and "character" (default: all).
+        edges limits which relationship types are followed (default: all).
+        """
+        def mask(names: Optional[List[str]]) -> int:
+            if not names:
+                return int(engine_native.EntityType.ANY)
+            value = 0
+            for name in names:
+                value |= int(getattr(engine_native.EntityType, name.upper()))
+            return value
+
+        type_names = {int(engine_native.EntityType.CASE): "case",
+                      int(engine_native.EntityType.SUSPECT): "suspect",
+                      int(engine_native.EntityType.CHARACTER): "character"}
+        if isinstance(seeds, str):
+            seeds = [seeds]
+        hops = self._engine.find_neighborhood(seeds, max_depth, mask(types), mask(through), edges or [])
+        return [{"name": hop.name,
+                 "types": [label for bit, label in type_names.items() if hop.type & bit],
+                 "depth": hop.depth}
+                for hop in hops]
+
     # Convenience methods that use objects
     def link_suspect_to_case_obj(self, suspect: Suspect, case: Case) -> bool:
         """Link a suspect to a case using objects (convenience method)"""
@@ -821,7 +961,6 @@ class DetectiveEngine:
         characters = []
         for native_character in native_characters:
             character = Character(native_character)
-            self._character_cache[character.id] = character
             characters.append(character)
         return characters
     
@@ -874,6 +1013,37 @@ class DetectiveEngine:
             'average_suspicion_level': stats.average_suspicion_level,
             'total_relationships': stats.total_relationships
         }
+
+    def get_metrics(self) -> Dict[str, Any]:
+        """Per-method call counts and latency percentiles (microseconds), plus container sizes"""
+        metrics = self._engine.get_metrics()
+        return {
+            'operations': {
+                op.name: {
+                    'calls': op.calls,
+                    'timed_calls': op.timed_calls,
+                    'total_ms': op.total_ms,
+                    'mean_us': op.mean_us,
+                    'p50_us': op.p50_us,
+                    'p90_us': op.p90_us,
+                    'p99_us': op.p99_us,
+                    'p999_us': op.p999_us,
+                    'max_us': op.max_us
+                } for op in metrics.operations
+            },
+            'sizes': {
+                'cases': metrics.cases,
+                'suspects': metrics.suspects,
+                'characters': metrics.characters,
+                'graph_nodes': metrics.graph_nodes,
+                'graph_edges': metrics.graph_edges
+            },
+            'threads': metrics.threads
+        }
+
+    def reset_metrics(self):
+        """Zero the per-method counters and histograms"""
+        self._engine.reset_metrics()
     
     def get_unsolved_cases(self) -> List[Case]:
         """Get all unsolved cases"""
@@ -894,6 +1064,51 @@ class DetectiveEngine:
             self._case_cache[case.id] = case
             cases.append(case)
         return cases
+
+    def query_cases(self, statuses: Optional[List[CaseStatus]] = None, unsolved: bool = False,
+                    min_priority: Optional[CasePriority] = None, title_from: str = "",
+                    suspect: str = "", min_suspicion: Optional[float] = None,
+                    max_suspicion: Optional[float] = None, suspect_status: Optional[SuspectStatus] = None,
+                    order_by: str = "title", descending: bool = False,
+                    offset: int = 0, limit: int = 50) -> List[Case]:
+        """Filter cases natively, joined to their linked suspects, and return one page.
+
+        Any suspect argument requires at least one linked suspect matching all of them.
+        order_by is "title", "id", "priority" or "suspicion" (highest matching suspect).
+        """
+        orders = {
+            "title": engine_native.CaseOrder.TITLE,
+            "id": engine_native.CaseOrder.ID,
+            "priority": engine_native.CaseOrder.PRIORITY,
+            "suspicion": engine_native.CaseOrder.MAX_SUSPICION,
+        }
+        if order_by not in orders:
+            raise ValueError(f"Unknown order_by: {order_by}")
+
+        query = self._engine.query_cases()
+        for status in statuses or []:
+            query.where_status(status.value)
+        if unsolved:
+            query.where_unsolved()
+        if min_priority is not None:
+            query.where_min_priority(min_priority.value)
+        if title_from:
+            query.where_title_from(title_from)
+        if min_suspicion is not None or max_suspicion is not None:
+            query.join_suspects(0.0 if min_suspicion is None else min_suspicion,
+                                100.0 if max_suspicion is None else max_suspicion)
+        if suspect_status is not None:
+            query.join_suspect_status(suspect_status.value)
+        if suspect:
+            query.join_suspect_named(suspect)
+        query.order_by(orders[order_by], descending).offset(offset).limit(limit)
+
+        cases = []
+        for native_case in query.run():
+            case = Case(native_case)
+            self._case_cache[case.id] = case
+            cases.append(case)
+        return cases
     
     # Story Manager Methods - FIXED: Correct method signatures
     def generate_case_summary(self, case_title: str) -> str:
@@ -959,12 +1174,122 @@ class DetectiveEngine:
     def display_all_data(self):
         """Display all data in the engine"""
         self._engine.display_all_data()
-    
+
+    # Change Feed
+    def get_version(self) -> int:
+        """Current change version; bumped by every mutation"""
+        return self._engine.get_version()
+
+    def changes_since(self, version: int, epoch: Optional[int] = None) -> Dict[str, Any]:
+        """Entities changed after version, as current dicts plus removed ids.
+
+        Pass back the epoch from the previous call; if it no longer matches
+        (the engine was recreated) or the changes have been dropped from the
+        feed, full_sync is set and the caller should refetch everything.
+        """
+        changes = self._engine.changes_since(version)
+        result = {
+            "epoch": changes.epoch,
+            "version": changes.version,
+            "full_sync": changes.full_sync or (epoch is not None and epoch != changes.epoch),
+            "cases": {"updated": [], "removed": []},
+            "suspects": {"updated": [], "removed": []},
+            "characters": {"updated": [], "removed": []},
+        }
+        if result["full_sync"]:
+            return result
+
+        # Only the latest event per entity matters
+        latest = {}
+        for event in changes.events:
+            latest[(event.entity, event.id)] = event.op
+
+        kinds = {
+            engine_native.ChangeEntity.CASE: ("cases", self._engine.find_case_by_id, Case, self._case_cache),
+            engine_native.ChangeEntity.SUSPECT: ("suspects", self._engine.find_suspect_by_id, Suspect, self._suspect_cache),
+            engine_native.ChangeEntity.CHARACTER: ("characters", self._engine.find_character_by_id, Character, {}),
+        }
+        for (entity, entity_id), op in latest.items():
+            key, find, wrapper, cache = kinds[entity]
+            native = find(entity_id) if op != engine_native.ChangeOp.REMOVED else None
+            if native:
+                result[key]["updated"].append(wrapper(native).to_dict())
+            else:
+                cache.pop(entity_id, None)
+                result[key]["removed"].append(entity_id)
+        return result
+
+    # Persistence
+    def save_snapshot(self, path: str) -> bool:
+        """Write a binary snapshot of the whole engine"""
+        return self._engine.save_snapshot(path)
+
+    def load_snapshot(self, path: str, map_strings: bool = False, verify_checksum: bool = False) -> bool:
+        """Replace engine contents with a snapshot; cached wrappers become stale.
+
+        Cases and suspects are read from the file when first used, so leave it
+        in place afterwards. map_strings shares the file's text instead of
+        copying it; verify_checksum checks the whole file before loading.
+        """
+        if not self._engine.load_snapshot(path, map_strings, verify_checksum):
+            return False
+        self._case_cache.clear()
+        self._suspect_cache.clear()
+        return True
+
+    def export_serialized(self, path: str) -> bool:
+        """Write every entity as a pipe-delimited text record"""
+        return self._engine.export_serialized(path)
+
+    def import_serialized(self, path: str) -> bool:
+        """Bulk-load a text dump produced by export_serialized"""
+        return self._engine.import_serialized(path)
+
+    def bulk_import(self, path: str, format: str = "auto", workers: int = 0,
+                    progress=None) -> Dict[str, Any]:
+        """Load a CSV or NDJSON file of cases, suspects, characters and links.
+
+        progress, if given, is called as progress(bytes_done, bytes_total, rows, failed).
+        """
+        native_format = getattr(engine_native.ImportFormat, format.upper())
+        report = self._engine.bulk_import(path, native_format, workers, progress)
+        return {
+            "ok": report.ok,
+            "fatal_error": report.fatal_error,
+            "rows_processed": report.rows_processed,
+            "rows_failed": report.rows_failed,
+            "cases_imported": report.cases_imported,
+            "suspects_imported": report.suspects_imported,
+            "characters_imported": report.characters_imported,
+            "links_imported": report.links_imported,
+            "seconds": report.seconds,
+            "errors": [{"line": e.line, "message": e.message} for e in report.errors],
+        }
+
+    def open_durable(self, directory: str, policy: str = "always") -> bool:
+        """Back the engine with a snapshot + write-ahead log directory.
+
+        policy is one of "always", "interval" or "never" (fsync behaviour).
+        """
+        native_policy = getattr(engine_native.WalSyncPolicy, policy.upper())
+        if not self._engine.open_durable(directory, native_policy):
+            return False
+        self._case_cache.clear()
+        self._suspect_cache.clear()
+        return True
+
+    def compact_log(self) -> bool:
+        """Fold the write-ahead log into a new snapshot in the background"""
+        return self._engine.compact_log()
+
+    def close_durable(self):
+        """Flush the write-ahead log and detach from the durable directory"""
+        self._engine.close_durable()
+
     def cleanup(self):
         """Clean up resources"""
         self._case_cache.clear()
         self._suspect_cache.clear()
-        self._character_cache.clear()
     
     def __enter__(self):
         return self
@@ -983,6 +1308,28 @@ def get_engine_info() -> Dict[str, str]:
     }
 
 
+
+def set_log_level(level: str) -> None:
+    """Set the engine's runtime log threshold: VERBOSE, INFO, WARNING, ERROR or NONE.
+
+    Levels below the build's WHODUNNIT_LOG_LEVEL are compiled out and stay silent.
+    """
+    engine_native.set_log_level(getattr(engine_native.LogLevel, level.upper()))
+
+
+def flush_logs() -> None:
+    """Wait until queued engine log lines have been written"""
+    engine_native.flush_logs()
+
+
+def set_string_deduplication(enabled: bool) -> None:
+    """Share equal entity text between records instead of storing a copy each.
+
+    Off by default. Worth enabling for data with much repeated text; only
+    values stored after the call are affected.
+    """
+    engine_native.set_string_deduplication(enabled)
+
 # Example usage
 if __name__ == "__main__":
     # Demo the engine
@@ -1002,8 +1349,8 @@ if __name__ == "__main__":
             print(f"✓ Case created: {case.title}")
             
             # Set additional properties
-            case.location = "City Business District"
-            case.notes = "Last seen leaving office at 8 PM"
+            engine.update_case_details(case.title, location="City Business District",
+                                       notes="Last seen leaving office at 8 PM")
             
             # Create a suspect
             suspect = engine.create_suspect(
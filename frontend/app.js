@@ -7,7 +7,9 @@ let currentData = {
     cases: [],
     suspects: [],
     characters: [],
-    statistics: null
+    statistics: null,
+    // Where the last sync left off in the engine's change feed
+    sync: { epoch: null, version: null }
 };
 
 // initialize application
@@ -72,6 +74,8 @@ async function refreshAllData() {
     showLoading('Refreshing all data...');
     
     try {
+        // Taken first, so anything that changes during the load is picked up by the next sync
+        await loadSyncPoint();
         await Promise.all([
             loadCases(),
             loadSuspects(),
@@ -90,6 +94,79 @@ async function refreshAllData() {
     }
 }
 
+// Fetches only what changed since the last sync; falls back to a full
+// refresh when the server has dropped those changes or was restarted
+async function syncChanges() {
+    if (currentData.sync.version === null) {
+        return refreshAllData();
+    }
+
+    try {
+        const params = new URLSearchParams({ since: currentData.sync.version, epoch: currentData.sync.epoch });
+        const response = await fetch(`${API_BASE}/api/changes?${params}`);
+        if (!response.ok) throw new Error('Failed to fetch changes');
+        const changes = await response.json();
+        if (changes.full_sync) {
+            return refreshAllData();
+        }
+
+        if (hasChanges(changes.cases)) {
+            currentData.cases = mergeChanges(currentData.cases, changes.cases);
+            displayCases(currentData.cases);
+            updateCaseCount();
+        }
+        if (hasChanges(changes.suspects)) {
+            currentData.suspects = mergeChanges(currentData.suspects, changes.suspects);
+            displaySuspects(currentData.suspects);
+            updateSuspectCount();
+        }
+        if (hasChanges(changes.characters)) {
+            currentData.characters = mergeChanges(currentData.characters, changes.characters);
+            displayCharacters(currentData.characters);
+            updateCharacterCount();
+        }
+        currentData.sync = { epoch: changes.epoch, version: changes.version };
+
+        updateDropdowns();
+        updateDashboard();
+    } catch (error) {
+        console.error('Delta sync failed, refreshing everything:', error);
+        return refreshAllData();
+    }
+}
+
+async function loadSyncPoint() {
+    try {
+        const response = await fetch(`${API_BASE}/api/changes`);
+        if (!response.ok) throw new Error('Change feed unavailable');
+        const data = await response.json();
+        currentData.sync = { epoch: data.epoch, version: data.version };
+    } catch (error) {
+        // Every later sync becomes a full refresh
+        currentData.sync = { epoch: null, version: null };
+    }
+}
+
+function hasChanges(delta) {
+    return delta.updated.length > 0 || delta.removed.length > 0;
+}
+
+// Replaces updated entities in place, drops removed ones and appends new ones
+function mergeChanges(items, delta) {
+    const removed = new Set(delta.removed);
+    const updated = new Map(delta.updated.map(item => [item.id, item]));
+
+    const merged = items
+        .filter(item => !removed.has(item.id))
+        .map(item => {
+            const fresh = updated.get(item.id);
+            if (!fresh) return item;
+            updated.delete(item.id);
+            return fresh;
+        });
+    return merged.concat(Array.from(updated.values()));
+}
+
 async function loadCases() {
     try {
         const response = await fetch(`${API_BASE}/api/cases`);
@@ -214,7 +291,7 @@ async function createCase() {
             addActivity(`Case created: "${newCase.title}"`);
             $('#createCaseModal').modal('hide');
             form.reset();
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Case created successfully!');
         } else {
             throw new Error('Failed to create case');
@@ -252,7 +329,7 @@ async function createSuspect() {
             addActivity(`Suspect created: "${newSuspect.name}"`);
             $('#createSuspectModal').modal('hide');
             form.reset();
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Suspect created successfully!');
         } else {
             const errorData = await response.json();
@@ -319,7 +396,7 @@ async function updateCase() {
             const editModal = bootstrap.Modal.getInstance(document.getElementById('editCaseModal'));
             editModal.hide();
             
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Case updated successfully!');
         } else {
             const errorData = await response.json();
@@ -392,7 +469,7 @@ async function updateSuspect() {
             const editModal = bootstrap.Modal.getInstance(document.getElementById('editSuspectModal'));
             editModal.hide();
             
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Suspect updated successfully!');
         } else {
             const errorData = await response.json();
@@ -451,7 +528,7 @@ async function updateCharacter() {
             const editModal = bootstrap.Modal.getInstance(document.getElementById('editCharacterModal'));
             editModal.hide();
             
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Character updated successfully!');
         } else {
             const errorData = await response.json();
@@ -481,7 +558,7 @@ async function createCharacter() {
             addActivity(`Character created: "${newCharacter.name}"`);
             $('#createCharacterModal').modal('hide');
             form.reset();
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Character created successfully!');
         } else {
             throw new Error('Failed to create character');
@@ -515,7 +592,7 @@ async function linkEntities() {
         if (response.ok) {
             addActivity(`Linked ${entityType} "${entityName}" to case "${caseTitle}"`);
             document.getElementById('linkForm').reset();
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Entities linked successfully!');
         } else {
             throw new Error('Failed to link entities');
@@ -548,7 +625,7 @@ async function unlinkEntities() {
         if (response.ok) {
             addActivity(`Unlinked ${entityType} "${entityName}" from case "${caseTitle}"`);
             document.getElementById('unlinkForm').reset();
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Entities unlinked successfully!');
         } else {
             throw new Error('Failed to unlink entities');
@@ -1149,7 +1226,7 @@ async function deleteCase(caseId) {
 
             if (response.ok) {
                 addActivity(`Case deleted: "${caseItem.title}"`);
-                await refreshAllData();
+                await syncChanges();
                 showSuccess('Case deleted successfully!');
             } else {
                 const errorData = await response.json();
@@ -1176,7 +1253,7 @@ async function deleteSuspect(suspectId) {
 
             if (response.ok) {
                 addActivity(`Suspect deleted: "${suspect.name}"`);
-                await refreshAllData();
+                await syncChanges();
                 showSuccess('Suspect deleted successfully!');
             } else {
                 const errorData = await response.json();
@@ -1203,7 +1280,7 @@ async function deleteCharacter(characterId) {
 
             if (response.ok) {
                 addActivity(`Character deleted: "${character.name}"`);
-                await refreshAllData();
+                await syncChanges();
                 showSuccess('Character deleted successfully!');
             } else {
                 const errorData = await response.json();
@@ -1228,7 +1305,7 @@ async function setupDemoData() {
         const data = await response.json();
         
         if (response.ok) {
-            await refreshAllData();
+            await syncChanges();
             showSuccess('Demo data created successfully!');
             addActivity('Demo data setup completed');
         } else {